@@ -5,17 +5,63 @@
 #include <iomanip>
 #include <cmath>
 #include <random>
+#include <bitset>
+#include <climits>
 
 using namespace std;
 
 // ======================= BOARD IMPLEMENTATION ==============================
 
 _4by4XO_Board::_4by4XO_Board() : Board<char>(4, 4) {
+    reset();
+}
+
+void _4by4XO_Board::reset() {
     n_moves = 0;
+    maskX = maskO = 0;
+    positions.clear();
+    for (auto& row : board) std::fill(row.begin(), row.end(), 0);
 
     // Initial predefined arrangement
     board[0][0] = 'X'; board[0][1] = 'O'; board[0][2] = 'X'; board[0][3] = 'O';
     board[3][0] = 'O'; board[3][1] = 'X'; board[3][2] = 'O'; board[3][3] = 'X';
+
+    for (int i = 0; i < 16; i++) {
+        if (board[i / 4][i % 4] == 'X') maskX |= uint16_t(1u << i);
+        if (board[i / 4][i % 4] == 'O') maskO |= uint16_t(1u << i);
+    }
+    positions.push_back(key());
+}
+
+uint64_t _4by4XO_Board::key() const {
+    return uint64_t(maskX) | uint64_t(maskO) << 16 | uint64_t(n_moves % 2 == 0) << 32;
+}
+
+uint16_t _4by4XO_Board::slides(uint16_t pieces, uint16_t empty, Direction dir) {
+    switch (dir) {
+        case UP:    return uint16_t((pieces >> 4) & empty);
+        case DOWN:  return uint16_t((pieces << 4) & empty);
+        case LEFT:  return uint16_t(((pieces & 0xEEEE) >> 1) & empty);
+        default:    return uint16_t(((pieces & 0x7777) << 1) & empty);
+    }
+}
+
+int _4by4XO_Board::slideSource(int to, Direction dir) {
+    static const int offset[4] = { 4, -4, 1, -1 };
+    return to + offset[dir];
+}
+
+bool _4by4XO_Board::hasLine(uint16_t m) {
+    return (m & m >> 1 & m >> 2 & 0x3333)    // horizontal
+        || (m & m >> 4 & m >> 8 & 0x00FF)    // vertical
+        || (m & m >> 5 & m >> 10 & 0x0033)   // diagonal
+        || (m & m >> 3 & m >> 6 & 0x00CC);   // anti-diagonal
+}
+
+bool _4by4XO_Board::canMove(uint16_t pieces, uint16_t empty) {
+    for (int d = UP; d <= RIGHT; d++)
+        if (slides(pieces, empty, Direction(d))) return true;
+    return false;
 }
 
 /**
@@ -41,7 +87,7 @@ bool _4by4XO_Board::update_board(Move<char>* move) {
         return false;
 
     // Must move own symbol
-    if (board[fx][fy] != s)
+    if (board[fx][fy] != s || (s != 'X' && s != 'O'))
         return false;
 
     // Destination must be empty
@@ -53,9 +99,12 @@ bool _4by4XO_Board::update_board(Move<char>* move) {
         return false;
 
     // Apply move
+    uint16_t& mask = (s == 'X') ? maskX : maskO;
+    mask ^= uint16_t(1u << (fx * 4 + fy) | 1u << (tx * 4 + ty));
     board[tx][ty] = s;
     board[fx][fy] = 0;
     n_moves++;
+    positions.push_back(key());
     return true;
 }
 
@@ -64,37 +113,27 @@ bool _4by4XO_Board::update_board(Move<char>* move) {
  * @brief Checks 3-in-a-row in all directions.
  */
 bool _4by4XO_Board::is_win(Player<char>* player) {
-    char s = player->get_symbol();
-
-    // Horizontal & vertical 3-in-a-row
-    for (int i = 0; i < 4; i++) {
-        if (board[i][0] == s && board[i][1] == s && board[i][2] == s) return true;
-        if (board[i][1] == s && board[i][2] == s && board[i][3] == s) return true;
-
-        if (board[0][i] == s && board[1][i] == s && board[2][i] == s) return true;
-        if (board[1][i] == s && board[2][i] == s && board[3][i] == s) return true;
-    }
-
-    // Diagonals (8 different length-3 diagonals)
-    if (board[0][0] == s && board[1][1] == s && board[2][2] == s) return true;
-    if (board[1][1] == s && board[2][2] == s && board[3][3] == s) return true;
-    if (board[0][1] == s && board[1][2] == s && board[2][3] == s) return true;
-    if (board[1][0] == s && board[2][1] == s && board[3][2] == s) return true;
-
-    if (board[0][3] == s && board[1][2] == s && board[2][1] == s) return true;
-    if (board[1][2] == s && board[2][1] == s && board[3][0] == s) return true;
-    if (board[0][2] == s && board[1][1] == s && board[2][0] == s) return true;
-    if (board[1][3] == s && board[2][2] == s && board[3][1] == s) return true;
-
-    return false;
+    return hasLine(getMask(player->get_symbol()));
 }
 
 bool _4by4XO_Board::is_lose(Player<char>* player) {
     return false;
 }
 
+/**
+ * @brief Draw when the current position has occurred three times or the
+ * opponent of the last mover has no slide left.
+ */
 bool _4by4XO_Board::is_draw(Player<char>* player) {
-    return n_moves > 100; // Prevent infinite sliding games
+    const uint16_t opp = getMask(player->get_symbol() == 'X' ? 'O' : 'X');
+    if (!canMove(opp, uint16_t(~(maskX | maskO))))
+        return true;
+
+    const uint64_t now = positions.back();
+    int seen = 0;
+    for (uint64_t k : positions)
+        seen += (k == now);
+    return seen >= 3;
 }
 
 bool _4by4XO_Board::game_is_over(Player<char>* player) {
@@ -124,7 +163,6 @@ Move<char>* _4by4XO_UI::get_move(Player<char>* player) {
         cin >> tx >> ty;
         return new _4by4XO_Move(fx, fy, tx, ty, player->get_symbol());
     } else {
-        _4by4XO_AI ai;
         return ai.bestMove(player, '.');
     }
 }
@@ -132,52 +170,172 @@ Move<char>* _4by4XO_UI::get_move(Player<char>* player) {
 
 // ======================= AI IMPLEMENTATION ==============================
 
-/**
- * @brief Generates all possible legal adjacent moves and picks one randomly.
- */
-Move<char>* _4by4XO_AI::bestMove(Player<char>* player, char blankCell, int depth)
-{
-    Board<char>* b = player->get_board_ptr();
-    char s = player->get_symbol();
+namespace {
 
-    vector<_4by4XO_Move*> possibleMoves;
+/** Position indexing for the retrograde table: X set rank × O set rank. */
+struct SlideIndex {
+    static constexpr int SETS16 = 1820; ///< C(16, 4)
+    static constexpr int SETS12 = 495;  ///< C(12, 4)
 
-    int dx[4] = { -1, 1, 0, 0 };
-    int dy[4] = { 0, 0, -1, 1 };
+    vector<uint16_t> rank16, rank12; ///< Rank of each 4-subset mask
+    vector<uint16_t> sets16, sets12; ///< Masks by rank
 
-    // Scan all tokens belonging to the AI
-    for (int x = 0; x < 4; x++) {
-        for (int y = 0; y < 4; y++) {
+    SlideIndex() : rank16(1 << 16), rank12(1 << 12) {
+        for (uint32_t m = 0; m < (1u << 16); m++)
+            if (bitset<16>(m).count() == 4) { rank16[m] = uint16_t(sets16.size()); sets16.push_back(uint16_t(m)); }
+        for (uint32_t m = 0; m < (1u << 12); m++)
+            if (bitset<12>(m).count() == 4) { rank12[m] = uint16_t(sets12.size()); sets12.push_back(uint16_t(m)); }
+    }
+
+    /** @brief Table index of (side to move, other side) */
+    uint32_t index(uint16_t own, uint16_t opp) const {
+        // Own tokens are ranked among all 16 cells, the other side's among the 12 left
+        uint16_t packed = 0;
+        for (int i = 0, j = 0; i < 16; i++) {
+            if (own >> i & 1) continue;
+            if (opp >> i & 1) packed |= uint16_t(1u << j);
+            j++;
+        }
+        return uint32_t(rank16[own]) * SETS12 + rank12[packed];
+    }
 
-            if (b->get_cell(x, y) == s) {
+    /** @brief Other side's mask for an O rank given own tokens */
+    uint16_t expand(uint16_t own, uint16_t packed) const {
+        uint16_t opp = 0;
+        for (int i = 0, j = 0; i < 16; i++) {
+            if (own >> i & 1) continue;
+            if (packed >> j & 1) opp |= uint16_t(1u << i);
+            j++;
+        }
+        return opp;
+    }
+};
 
-                for (int k = 0; k < 4; k++) {
-                    int nx = x + dx[k];
-                    int ny = y + dy[k];
+const SlideIndex& slideIndex() {
+    static const SlideIndex idx;
+    return idx;
+}
 
-                    if (nx < 0 || nx >= 4 || ny < 0 || ny >= 4)
-                        continue;
+} // namespace
 
-                    if (b->get_cell(nx, ny) == blankCell || b->get_cell(nx, ny) == 0) {
-                        possibleMoves.push_back(new _4by4XO_Move(x, y, nx, ny, s));
-                    }
+/**
+ * @details Built on first use. Positions are from the side to move's
+ * point of view, so the table needs no side bit. Resolution runs
+ * backwards from positions where the opponent already has a line
+ * (lost): predecessors of a lost position are won; a position all of
+ * whose moves reach won positions is lost. Whatever is never resolved
+ * (repetition cycles, stalemates) is a draw. Values are stored as
+ * ±(plies + 1), which stay well inside int8.
+ */
+int _4by4XO_AI::solve(uint16_t own, uint16_t opp)
+{
+    using D = _4by4XO_Board::Direction;
+    static const vector<int8_t> table = [] {
+        const SlideIndex& ix = slideIndex();
+        const uint32_t total = uint32_t(SlideIndex::SETS16) * SlideIndex::SETS12;
+
+        vector<int8_t> value(total, 0);
+        vector<uint8_t> pending(total, 0); // unresolved moves left
+        vector<uint32_t> queue;
+        queue.reserve(total);
+
+        for (uint32_t i = 0; i < total; i++) {
+            const uint16_t own = ix.sets16[i / SlideIndex::SETS12];
+            const uint16_t opp = ix.expand(own, ix.sets12[i % SlideIndex::SETS12]);
+            const uint16_t empty = uint16_t(~(own | opp));
+
+            if (_4by4XO_Board::hasLine(opp)) { value[i] = -1; queue.push_back(i); continue; }
+            int n = 0;
+            for (int d = D::UP; d <= D::RIGHT; d++)
+                n += int(bitset<16>(_4by4XO_Board::slides(own, empty, D(d))).count());
+            pending[i] = uint8_t(n);
+        }
+
+        // Breadth-first, so each position is resolved at its shortest
+        // win / longest loss
+        for (size_t q = 0; q < queue.size(); q++) {
+            const uint32_t i = queue[q];
+            const uint16_t own = ix.sets16[i / SlideIndex::SETS12];
+            const uint16_t opp = ix.expand(own, ix.sets12[i % SlideIndex::SETS12]);
+            const uint16_t empty = uint16_t(~(own | opp));
+            const int v = value[i];
+
+            // Undo a slide of the previous mover (opp): it came from an empty neighbour
+            for (int d = D::UP; d <= D::RIGHT; d++) {
+                uint16_t back = _4by4XO_Board::slides(opp, empty, D(d));
+                while (back) {
+                    const int to = int(bitset<16>(uint16_t((back & -back) - 1)).count());
+                    back &= uint16_t(back - 1);
+                    const int src = _4by4XO_Board::slideSource(to, D(d));
+                    const uint16_t prevOpp = uint16_t(opp ^ (1u << src) ^ (1u << to));
+                    const uint32_t p = ix.index(prevOpp, own);
+                    if (value[p] != 0) continue;
+
+                    if (v < 0) { value[p] = int8_t(1 - v); queue.push_back(p); }
+                    else if (--pending[p] == 0) { value[p] = int8_t(-v - 1); queue.push_back(p); }
                 }
             }
         }
-    }
+        return value;
+    }();
 
-    if (possibleMoves.empty()) {
-        return nullptr;
-    }
+    return table[slideIndex().index(own, opp)];
+}
 
-    int idx = rand() % possibleMoves.size();
-    _4by4XO_Move* chosen = possibleMoves[idx];
+/**
+ * @brief Solved value of the board for a player.
+ */
+float _4by4XO_AI::evaluate(Board<char>* board, Player<char>* player)
+{
+    auto* b = dynamic_cast<_4by4XO_Board*>(board);
+    if (!b || !player) throw invalid_argument("Invalid board or player in evaluate()");
+
+    const char s = player->get_symbol();
+    const int v = solve(b->getMask(s), b->getMask(s == 'X' ? 'O' : 'X'));
+    return v > 0 ? float(101 - v) : v < 0 ? float(-101 - v) : 0.0f;
+}
+
+float _4by4XO_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta,
+                          char blankCell, int depth)
+{
+    const float v = evaluate(player->get_board_ptr(), player);
+    return aiTurn ? v : -v;
+}
 
-    for (int i = 0; i < (int)possibleMoves.size(); i++) {
-        if (i != idx) {
-            delete possibleMoves[i];
+/**
+ * @brief Scores every legal slide with the solved table and picks the
+ * fastest win, else a draw, else the slowest loss.
+ */
+Move<char>* _4by4XO_AI::bestMove(Player<char>* player, char blankCell, int depth)
+{
+    auto* b = dynamic_cast<_4by4XO_Board*>(player->get_board_ptr());
+    if (!b) throw invalid_argument("Invalid board in bestMove()");
+
+    using D = _4by4XO_Board::Direction;
+    const char s = player->get_symbol();
+    const uint16_t own = b->getMask(s), opp = b->getMask(s == 'X' ? 'O' : 'X');
+    const uint16_t empty = uint16_t(~(own | opp));
+
+    int bestScore = INT_MIN, bestFrom = -1, bestTo = -1;
+    for (int d = D::UP; d <= D::RIGHT; d++) {
+        uint16_t dest = _4by4XO_Board::slides(own, empty, D(d));
+        while (dest) {
+            const int to = int(bitset<16>(uint16_t((dest & -dest) - 1)).count());
+            dest &= uint16_t(dest - 1);
+            const int from = _4by4XO_Board::slideSource(to, D(d));
+            const uint16_t next = uint16_t(own ^ (1u << from) ^ (1u << to));
+
+            // Child value is from the opponent's side: a loss there is our win
+            int score;
+            if (_4by4XO_Board::hasLine(next)) score = 1000;
+            else {
+                const int v = solve(opp, next);
+                score = v < 0 ? 1000 + v : v > 0 ? -1000 + v : 0;
+            }
+            if (score > bestScore) { bestScore = score; bestFrom = from; bestTo = to; }
         }
     }
 
-    return chosen;
-}
\ No newline at end of file
+    if (bestFrom < 0) return nullptr;
+    return new _4by4XO_Move(bestFrom / 4, bestFrom % 4, bestTo / 4, bestTo % 4, s);
+}
@@ -9,12 +9,15 @@
  *  - Board size: 4x4
  *  - Players MOVE existing X or O tokens to adjacent empty cells
  *  - Win: 3 consecutive identical symbols (row, column, diagonal)
- *  - Draw: too many moves without a win
+ *  - Draw: the same position occurs a third time with the same side to
+ *    move, or the opponent is left without a legal slide
  */
 
 #pragma once
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
+#include <cstdint>
+#include <vector>
 
 /**
  * @class _4by4XO_Move
@@ -49,47 +52,61 @@ public:
 
 /**
  * @class _4by4XO_AI
- * @brief Simple AI for sliding 4x4 Tic-Tac-Toe.
+ * @brief Perfect-play AI for sliding 4x4 Tic-Tac-Toe.
  *
  * @ingroup AI
  *
- * Responsibilities:
- *  - Generate valid moves
- *  - Currently random; placeholder for Minimax
+ * The game has only 1820 × 495 × 2 positions (4 X and 4 O tokens on 16
+ * cells, side to move), so it is solved once by retrograde analysis into
+ * a shared table: every position is a win or loss in a known number of
+ * plies, or a draw (cycles and stalemates). bestMove looks up each legal
+ * slide and plays the fastest win, else a draw, else the slowest loss.
+ * Move generation and lookup allocate nothing; the depth argument is
+ * ignored.
  */
 class _4by4XO_AI : public AI {
 public:
     _4by4XO_AI() = default;
 
     /**
-     * @brief Evaluates board for Minimax (unused currently).
+     * @brief Solved value of the board for a player.
      * @param board Pointer to board
      * @param player Pointer to AI player
-     * @return Always 0.0f
+     * @return 100 - plies for a forced win, -(100 - plies) for a forced loss, 0 for a draw
      */
-    float evaluate(Board<char>* board, Player<char>* player) override { return 0.0f; }
+    float evaluate(Board<char>* board, Player<char>* player) override;
 
     /**
-     * @brief Placeholder Minimax algorithm.
+     * @brief Solved value from the AI's point of view (table lookup).
      * @param aiTurn True if AI turn
      * @param player Pointer to AI player
-     * @param alpha Alpha value
-     * @param beta Beta value
+     * @param alpha Alpha value (unused)
+     * @param beta Beta value (unused)
      * @param blankCell Empty cell symbol
-     * @param depth Search depth
-     * @return Always 0.0f
+     * @param depth Search depth (unused)
+     * @return Value as in evaluate()
      */
     float minimax(bool aiTurn, Player<char>* player, float alpha, float beta,
-                  char blankCell, int depth) override { return 0.0f; }
+                  char blankCell, int depth) override;
 
     /**
      * @brief Computes the best move for AI.
      * @param player Pointer to AI player
      * @param blankCell Empty cell symbol
      * @param depth Maximum search depth (unused)
-     * @return Pointer to selected Move<char> (caller responsible for memory)
+     * @return Pointer to selected Move<char> (caller responsible for memory),
+     *         nullptr if the player cannot move
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+    /**
+     * @brief Solved value of a position.
+     * @param own Tokens of the side to move
+     * @param opp Tokens of the other side
+     * @return 1 + plies to a forced win, -(1 + plies) to a forced loss
+     *         (-1: the opponent already has a line), or 0 for a draw
+     */
+    static int solve(uint16_t own, uint16_t opp);
 };
 
 /**
@@ -102,10 +119,46 @@ public:
  *  - Track board state
  *  - Apply sliding moves
  *  - Check win/draw/game-over conditions
+ *
+ * Tokens are kept as one 16-bit mask per player (bit 4*row+col); slides and
+ * lines are computed with shifts. Every position reached is recorded with
+ * its side to move so repetitions can be counted.
  */
 class _4by4XO_Board : public Board<char>
 {
+    uint16_t maskX = 0;              ///< X tokens
+    uint16_t maskO = 0;              ///< O tokens
+    std::vector<uint64_t> positions; ///< Keys of all positions reached (see key())
+
+    /** @brief Position key: X mask, O mask, X to move */
+    uint64_t key() const;
+
 public:
+    /** @brief Slide directions */
+    enum Direction { UP, DOWN, LEFT, RIGHT };
+
+    /**
+     * @brief Destinations of all tokens in pieces sliding one way.
+     * @param pieces Tokens to move
+     * @param empty Free cells
+     * @param dir Direction of the slide
+     * @return Cells reachable in that direction (bit per destination)
+     */
+    static uint16_t slides(uint16_t pieces, uint16_t empty, Direction dir);
+
+    /** @brief Source cell of the slide landing on to, in direction dir */
+    static int slideSource(int to, Direction dir);
+
+    /** @brief True if a mask holds 3 in a row in any direction */
+    static bool hasLine(uint16_t mask);
+
+    /** @brief True if the token set can make at least one slide */
+    static bool canMove(uint16_t pieces, uint16_t empty);
+
+    /** @brief Tokens of one symbol */
+    uint16_t getMask(char symbol) const { return symbol == 'X' ? maskX : maskO; }
+
+
     /** @brief Initializes the board with starting X/O positions */
     _4by4XO_Board();
 
@@ -133,7 +186,7 @@ public:
     /**
      * @brief Checks for draw condition.
      * @param player Pointer to last played player
-     * @return True if draw
+     * @return True on threefold repetition or if the opponent cannot move
      */
     bool is_draw(Player<char>* player) override;
 
@@ -143,6 +196,9 @@ public:
      * @return True if game finished
      */
     bool game_is_over(Player<char>* player) override;
+
+    /** @brief Put the tokens back on their starting cells and forget the repetition history. */
+    void reset() override;
 };
 
 /**
@@ -176,4 +232,7 @@ public:
      * @return Pointer to Move<char>
      */
     Move<char>* get_move(Player<char>* player) override;
+
+private:
+    _4by4XO_AI ai; ///< Table-driven AI
 };
\ No newline at end of file
@@ -8,7 +8,7 @@
  * This variant implements:
  *  - 6x7 board with column-based placement
  *  - Win, draw detection
- *  - Minimax-based AI
+ *  - Alpha-beta AI on the shared k-in-a-row bitboards
  *  - UI for human and AI interaction
  */
 
@@ -18,6 +18,7 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
 #include "../../header/Custom_UI.h"
+#include "../../header/KInARowBoard.h"
 using namespace std;
 
 /**
@@ -26,137 +27,35 @@ using namespace std;
  *
  * @ingroup Connect4
  *
- * Responsibilities:
- *  - Track board state
- *  - Apply player moves
- *  - Detect winning and draw conditions
+ * A 6x7 gravity KInARowBoard won by four in a row. Moves name a column
+ * (the row of a Move is ignored); symbol 0 takes back the top mark of the
+ * column.
  */
-class FOUR_Board : public Board<char> {
-private:
-    char blank_symbol = '.';     ///< Symbol representing empty cells
-
+class FOUR_Board : public KInARowBoard<6, 7, 4, true> {
 public:
-    int last_row[7]{};           ///< Tracks the number of filled cells in each column
-
     /** @brief Constructs an empty Connect-Four board. */
-    FOUR_Board();
-
-    /**
-     * @brief Applies a move to the board.
-     * @param move Pointer to a Move object containing row, column, and symbol
-     * @return True if the move was applied successfully
-     */
-    bool update_board(Move<char>* move) override;
-
-    /**
-     * @brief Checks whether the given player has won.
-     * @param player Pointer to the player to check
-     * @return True if the player has a winning configuration
-     */
-    bool is_win(Player<char>* player) override;
-
-    /**
-     * @brief Connect-Four does not use losing detection.
-     * @param player Pointer to the player to check
-     * @return Always false
-     */
-    bool is_lose(Player<char>* player) { return false; }
-
-    /**
-     * @brief Checks whether the game ended in a draw.
-     * @param player Pointer to the player (not used)
-     * @return True if all columns are full without a winner
-     */
-    bool is_draw(Player<char>* player) override;
-
-    /**
-     * @brief Checks whether the game is over (win or draw).
-     * @param player Pointer to the player (not used)
-     * @return True if game has ended
-     */
-    bool game_is_over(Player<char>* player) override;
-
-    /**
-     * @brief Returns the actual last filled row index in a column.
-     * @param y Column index
-     * @return Row index of the topmost filled cell
-     */
-    int get_last_row(int y) { return 5 - last_row[y]; }
-
-    /**
-     * @brief Increases the filled count of a column.
-     * @param y Column index
-     * @return New row index after increment
-     */
-    int increase_last_row(int y) { return 5 - last_row[y]++; }
+    FOUR_Board() : KInARowBoard<6, 7, 4, true>('.') {}
 
     /**
-     * @brief Decreases the filled count of a column.
+     * @brief Returns the row the next mark in a column lands on.
      * @param y Column index
-     * @return New row index after decrement
+     * @return Row index, -1 if the column is full
      */
-    int decrease_last_row(int y) { return 5 - last_row[y]--; }
+    int get_last_row(int y) const { return landing_row(y); }
 };
 
 /**
  * @class Four_AI
- * @brief Implements a minimax-based AI for Connect-Four.
+ * @brief Alpha-beta AI for Connect-Four.
  *
  * @ingroup AI
  *
- * Responsibilities:
- *  - Evaluate board states
- *  - Generate optimal moves using minimax
+ * The shared k-in-a-row search with centre columns tried first.
  */
-class Four_AI : public AI {
+class Four_AI : public KInARowAI<FOUR_Board> {
 public:
-    Four_AI() = default;
-
-    /**
-     * @brief Evaluates the current board state from AI perspective.
-     * @param board Pointer to the board
-     * @param player Pointer to AI player
-     * @return Score evaluation
-     */
-    float evaluate(Board<char>* board, Player<char>* player) override;
-
-    /**
-     * @brief Minimax algorithm with alpha-beta pruning.
-     * @param aiTurn True if AI's turn
-     * @param player Pointer to AI player
-     * @param alpha Alpha value
-     * @param beta Beta value
-     * @param blankCell Symbol representing empty cells
-     * @param depth Remaining search depth
-     * @return Minimax evaluation score
-     */
-    float minimax(bool aiTurn, Player<char>* player,
-                  float alpha, float beta,
-                  char blankCell, int depth) override;
-
-    /**
-     * @brief Checks if any moves are still available.
-     * @param board Pointer to the board
-     * @return True if at least one column is not full
-     */
-    bool isMovesLeft(Board<char>* board);
-
-    /**
-     * @brief Finds the next open row in a given column.
-     * @param board Pointer to the board
-     * @param col Column index
-     * @return Row index of the next empty cell in the column
-     */
-    int get_next_available_row(Board<char>* board, int col);
-
-    /**
-     * @brief Computes the best possible move for the AI.
-     * @param player Pointer to AI player
-     * @param blankCell Symbol representing empty cells
-     * @param depth Maximum search depth
-     * @return Pointer to the chosen Move<char>
-     */
-    Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+    /** @brief Construct with 2^tableBits table entries (4 MB by default). */
+    explicit Four_AI(int tableBits = 18) : KInARowAI<FOUR_Board>(tableBits) {}
 };
 
 /**
@@ -172,6 +71,7 @@ public:
 class FOUR_UI : public Custom_UI<char> {
 private:
     char AI, OOP; ///< Symbols for AI and opponent
+    Four_AI ai;   ///< Search kept across moves
 
 public:
     /** @brief Constructs the Connect-Four UI handler. */
@@ -1,4 +1,5 @@
 #include "Large_Tic_Tac_Toe.h"
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -10,89 +11,146 @@
 #include <cstdlib>
 #include <ctime>
 #include <random>
+#include <bitset>
+#include <cmath>
 
 using namespace std;
 
 // ============================================================================
-// Activation Functions
+// Large_XO_Symmetry Implementation
 // ============================================================================
 
-/**
- * @brief ReLU activation function.
- * @param x Input value
- * @return max(0, x)
- */
-auto relu = [](double x) { return x > 0.0 ? x : 0.0; };
+namespace {
 
 /**
- * @brief Derivative of ReLU activation.
- * @param x Input value
- * @return 1 if x > 0 else 0
+ * @brief Precomputed cell permutations and per-row mask tables.
  */
-auto relu_derivative = [](double x) { return x > 0.0 ? 1.0 : 0.0; };
+struct SymmetryTables {
+    int cell[8][25];           ///< cell[s][idx] = image of idx under s
+    uint32_t row[8][5][32];    ///< row[s][r][bits] = image of row r's bits
+
+    SymmetryTables() {
+        for (int s = 0; s < 8; ++s)
+            for (int r = 0; r < 5; ++r)
+                for (int c = 0; c < 5; ++c) {
+                    int nr = r, nc = c;
+                    switch (s) {
+                        case 1: nr = c;     nc = 4 - r; break; // rotate 90
+                        case 2: nr = 4 - r; nc = 4 - c; break; // rotate 180
+                        case 3: nr = 4 - c; nc = r;     break; // rotate 270
+                        case 4: nr = r;     nc = 4 - c; break; // mirror left-right
+                        case 5: nr = 4 - r; nc = c;     break; // mirror top-bottom
+                        case 6: nr = c;     nc = r;     break; // main diagonal
+                        case 7: nr = 4 - c; nc = 4 - r; break; // anti-diagonal
+                        default: break;
+                    }
+                    cell[s][5 * r + c] = 5 * nr + nc;
+                }
+
+        for (int s = 0; s < 8; ++s)
+            for (int r = 0; r < 5; ++r)
+                for (uint32_t bits = 0; bits < 32; ++bits) {
+                    uint32_t out = 0;
+                    for (int c = 0; c < 5; ++c)
+                        if (bits & (1u << c)) out |= 1u << cell[s][5 * r + c];
+                    row[s][r][bits] = out;
+                }
+    }
+};
 
-/**
- * @brief Linear activation function.
- * @param x Input value
- * @return x
- */
-auto linear = [](double x) { return x; };
+const SymmetryTables& symmetryTables() {
+    static const SymmetryTables tables;
+    return tables;
+}
+
+} // namespace
+
+int Large_XO_Symmetry::mapCell(int s, int idx) {
+    return symmetryTables().cell[s][idx];
+}
+
+uint32_t Large_XO_Symmetry::apply(int s, uint32_t mask) {
+    const auto& row = symmetryTables().row[s];
+    return row[0][mask & 31] | row[1][(mask >> 5) & 31] | row[2][(mask >> 10) & 31]
+         | row[3][(mask >> 15) & 31] | row[4][(mask >> 20) & 31];
+}
+
+uint64_t Large_XO_Symmetry::canonical(uint32_t own, uint32_t opp, int& sym) {
+    uint64_t best = UINT64_MAX;
+    sym = 0;
+    for (int s = 0; s < COUNT; ++s) {
+        uint64_t key = (uint64_t(apply(s, own)) << 25) | apply(s, opp);
+        if (key < best) {
+            best = key;
+            sym = s;
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// Large_XO_EvalCache Implementation
+// ============================================================================
+
+Large_XO_EvalCache::Large_XO_EvalCache(int log2Entries)
+    : table(size_t(1) << log2Entries), mask((uint64_t(1) << log2Entries) - 1) {}
 
 /**
- * @brief Derivative of linear activation.
- * @param x Input value
- * @return 1
+ * @brief Mix the key (splitmix64 finalizer) so nearby masks spread out.
  */
-auto linear_derivative = [](double x) { return 1.0; };
+size_t Large_XO_EvalCache::indexOf(uint64_t key) const {
+    key ^= key >> 30; key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27; key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return size_t(key & mask);
+}
+
+bool Large_XO_EvalCache::probe(uint64_t key, float q[25]) {
+    size_t idx = indexOf(key);
+    lock_guard<mutex> lock(locks[idx % STRIPES]);
+
+    const Entry& e = table[idx];
+    if (e.key != key) {
+        missCount.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    copy(e.q, e.q + 25, q);
+    hitCount.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+void Large_XO_EvalCache::store(uint64_t key, const float q[25]) {
+    size_t idx = indexOf(key);
+    lock_guard<mutex> lock(locks[idx % STRIPES]);
+
+    Entry& e = table[idx];
+    e.key = key;
+    copy(q, q + 25, e.q);
+}
+
+void Large_XO_EvalCache::clear() {
+    for (int s = 0; s < STRIPES; ++s) locks[s].lock();
+    for (auto& e : table) e.key = EMPTY;
+    for (int s = 0; s < STRIPES; ++s) locks[s].unlock();
+}
 
 // ============================================================================
 // Large_XO_Board Implementation
 // ============================================================================
 
-uint32_t Large_XO_Board::win3Masks[48] = {0};
-
 // ----------------------------- Constructor -----------------------------
 
 /**
- * @brief Construct the 5×5 board and generate all 3-in-a-row bit masks.
+ * @brief Construct an empty 5×5 board.
  *
- * The base Board is initialized with dummy size (1×1) because this game
- * uses its own bitboard representation instead of the inherited matrix.
+ * The bitboards are the game state; the inherited 5×5 matrix is kept in
+ * sync as a readable copy for get_cell and get_board_matrix.
  */
 Large_XO_Board::Large_XO_Board()
-    : Board(1, 1), emptyCell('.')
+    : Board(5, 5), emptyCell('.')
 {
-    // Initialize human-readable board (used only for display functions)
+    // Human-readable copy of the bitboards (get_board_matrix / get_cell)
     board.assign(5, vector<char>(5, emptyCell));
-
-    // Precompute 48 unique 3-in-a-row masks only once
-    if (win3Masks[0] == 0) {
-        size_t maskIdx = 0;
-
-        // Horizontal
-        for (int r = 0; r < 5; ++r)
-            for (int c = 0; c <= 2; ++c)
-                win3Masks[maskIdx++] =
-                    (1u << (5*r+c)) | (1u << (5*r+c+1)) | (1u << (5*r+c+2));
-
-        // Vertical
-        for (int c = 0; c < 5; ++c)
-            for (int r = 0; r <= 2; ++r)
-                win3Masks[maskIdx++] =
-                    (1u << (5*r+c)) | (1u << (5*(r+1)+c)) | (1u << (5*(r+2)+c));
-
-        // Diagonal ↘
-        for (int r = 0; r <= 2; ++r)
-            for (int c = 0; c <= 2; ++c)
-                win3Masks[maskIdx++] =
-                    (1u << (5*r+c)) | (1u << (5*(r+1)+c+1)) | (1u << (5*(r+2)+c+2));
-
-        // Diagonal ↙
-        for (int r = 0; r <= 2; ++r)
-            for (int c = 2; c < 5; ++c)
-                win3Masks[maskIdx++] =
-                    (1u << (5*r+c)) | (1u << (5*(r+1)+c-1)) | (1u << (5*(r+2)+c-2));
-    }
 }
 
 // ----------------------------- Accessors -----------------------------
@@ -134,6 +192,7 @@ bool Large_XO_Board::updateCell(size_t r, size_t c, char s) {
         boardX &= mask;
         boardO &= mask;
         boardXO &= mask;
+        board[r][c] = emptyCell;
         --nMoves;
         return true;
     }
@@ -143,6 +202,7 @@ bool Large_XO_Board::updateCell(size_t r, size_t c, char s) {
     else          boardO |= (1u << idx);
 
     boardXO |= (1u << idx);
+    board[r][c] = (s == 'X') ? 'X' : 'O';
     ++nMoves;
     return true;
 }
@@ -196,11 +256,26 @@ bool Large_XO_Board::is_draw(Player<char>* player) {
  * @brief Count the number of 3-in-a-row masks fully contained in a symbol's bitboard.
  */
 float Large_XO_Board::countWin(char sym) {
-    uint32_t& temp = (sym == 'X') ? boardX : boardO;
-    float score = 0;
-    for (auto mask : win3Masks)
-        score += ((temp & mask) == mask);
-    return score;
+    return float(countPatterns(sym == 'X' ? boardX : boardO));
+}
+
+/**
+ * @brief Each direction keeps the start cells of a run of three: AND the
+ *        mask with itself shifted by one and two steps, restricted to the
+ *        starts whose run stays on the board.
+ */
+int Large_XO_Board::countPatterns(uint32_t b) {
+    const uint32_t cols02 = 0x0739CE7;       // columns 0-2 of every row
+    const uint32_t rows02 = 0x0007FFF;       // rows 0-2
+    const uint32_t cols24 = cols02 << 2;     // columns 2-4
+
+    uint32_t horizontal = b & (b >> 1) & (b >> 2)  & cols02;
+    uint32_t vertical   = b & (b >> 5) & (b >> 10) & rows02;
+    uint32_t diagDown   = b & (b >> 6) & (b >> 12) & cols02 & rows02;
+    uint32_t diagUp     = b & (b >> 4) & (b >> 8)  & cols24 & rows02;
+
+    return int(bitset<32>(horizontal).count() + bitset<32>(vertical).count() +
+               bitset<32>(diagDown).count() + bitset<32>(diagUp).count());
 }
 
 /**
@@ -218,6 +293,96 @@ void Large_XO_Board::encode(char ai, Matrix<double>& input) {
     }
 }
 
+// ============================================================================
+// Large_XO_Solver Implementation
+// ============================================================================
+
+Large_XO_Solver::Large_XO_Solver(int log2Entries)
+    : table(size_t(1) << log2Entries), mask((uint64_t(1) << log2Entries) - 1) {}
+
+int Large_XO_Solver::solve(uint32_t own, uint32_t opp) {
+    int move;
+    return negamax(own, opp, -64, 64, move);
+}
+
+int Large_XO_Solver::bestMove(uint32_t own, uint32_t opp, int* value) {
+    int move = -1;
+    int v = negamax(own, opp, -64, 64, move);
+    if (value) *value = v;
+    return move;
+}
+
+/**
+ * @brief Alpha-beta on the final pattern difference (fail-soft).
+ */
+int Large_XO_Solver::negamax(uint32_t own, uint32_t opp, int alpha, int beta, int& move) {
+    ++nodeCount;
+    move = -1;
+
+    const uint32_t full = (1u << 25) - 1;
+    uint32_t empty = full & ~(own | opp);
+    int ownNow = Large_XO_Board::countPatterns(own);
+    int oppNow = Large_XO_Board::countPatterns(opp);
+
+    // Game ends with one empty cell left (24 moves)
+    if (bitset<32>(empty).count() <= 1) return ownNow - oppNow;
+
+    // Patterns only accumulate: bound by giving every empty cell to one side
+    int upper = Large_XO_Board::countPatterns(own | empty) - oppNow;
+    int lower = ownNow - Large_XO_Board::countPatterns(opp | empty);
+    if (upper <= alpha) return upper;
+    if (lower >= beta)  return lower;
+
+    uint64_t key = (uint64_t(own) << 25) | opp;
+    Entry& e = table[size_t((key * 0x9E3779B97F4A7C15ULL) >> 20) & mask];
+    int ttMove = -1;
+    if (e.key == key && e.bound != NONE) {
+        ttMove = e.move;
+        if (e.bound == EXACT) { move = ttMove; return e.value; }
+        if (e.bound == LOWER) alpha = max(alpha, int(e.value));
+        if (e.bound == UPPER) beta  = min(beta,  int(e.value));
+        if (alpha >= beta) { move = ttMove; return e.value; }
+    }
+
+    // Order: table move, then patterns completed + patterns blocked
+    int moves[25], keys[25], n = 0;
+    for (int idx = 0; idx < 25; ++idx) {
+        uint32_t bit = 1u << idx;
+        if (!(empty & bit)) continue;
+
+        int k = (idx == ttMove) ? 1000
+              : (Large_XO_Board::countPatterns(own | bit) - ownNow)
+              + (Large_XO_Board::countPatterns(opp | bit) - oppNow);
+
+        int i = n++;
+        while (i > 0 && keys[i - 1] < k) {
+            keys[i] = keys[i - 1];
+            moves[i] = moves[i - 1];
+            --i;
+        }
+        keys[i] = k;
+        moves[i] = idx;
+    }
+
+    const int alphaOrig = alpha;
+    int best = -64, child;
+    for (int i = 0; i < n; ++i) {
+        int v = -negamax(opp, own | (1u << moves[i]), -beta, -alpha, child);
+        if (v > best) {
+            best = v;
+            move = moves[i];
+        }
+        if (v > alpha) alpha = v;
+        if (alpha >= beta) break;
+    }
+
+    e.key = key;
+    e.value = int8_t(best);
+    e.move = int8_t(move);
+    e.bound = best <= alphaOrig ? UPPER : (best >= beta ? LOWER : EXACT);
+    return best;
+}
+
 // ============================================================================
 // Large_XO_UI Implementation
 // ============================================================================
@@ -322,32 +487,83 @@ void Large_XO_UI::display_board_matrix(const vector<vector<char>>& matrix) const
 // ============================================================================
 
 /**
- * @brief Initialize AI and load NN models for X and O.
+ * @brief Untrained network of the fixed 25-512-512-512-25 architecture.
  */
-Large_XO_AI::Large_XO_AI() {
-    srand((unsigned)time(nullptr));
-
+static shared_ptr<NeuralNetwork> untrainedNetwork() {
     // NN structure: 25 → 512 → 512 → 512 → 25
     vector<int> layers = {25, 512, 512, 512, 25};
-    vector<function<double(double)>> acts =
-        {relu, relu, relu, linear};
-    vector<function<double(double)>> derivs =
-        {relu_derivative, relu_derivative, relu_derivative, linear_derivative};
+    vector<Activation> acts =
+        {Activation::ReLU, Activation::ReLU, Activation::ReLU, Activation::Linear};
+    return make_shared<NeuralNetwork>(layers, acts);
+}
 
-    try {
-        // X network
-        NNX = make_shared<NeuralNetwork>(layers, acts, derivs);
-        NNX->load("netX.bin");
+/**
+ * @brief Model-format files are memory-mapped and shared (architecture
+ *        comes from the file); legacy raw files are loaded into the fixed
+ *        architecture.
+ */
+shared_ptr<NeuralNetwork> Large_XO_AI::loadNetwork(const string& filename) {
+    if (model::isModelFile(filename))
+        return NeuralNetwork::open(filename);
+
+    auto net = untrainedNetwork();
+    net->load(filename);
+    return net;
+}
+
+/**
+ * @brief Initialize AI and load NN models for X and O.
+ *
+ * If loading fails the AI still plays, with untrained networks whose
+ * weights differ from run to run.
+ */
+Large_XO_AI::Large_XO_AI()
+{
+    srand((unsigned)time(nullptr));
 
-        // O network
-        NNO = make_shared<NeuralNetwork>(layers, acts, derivs);
-        NNO->load("netO.bin");
+    try {
+        setNetworks(loadNetwork("netX.bin"), loadNetwork("netO.bin"));
     }
     catch (const exception& e) {
         cerr << "Error initializing AI networks: " << e.what() << "\n";
+        setNetworks(untrainedNetwork(), untrainedNetwork());
     }
 }
 
+/**
+ * @brief Quiet variant for tools: a missing file gives an untrained
+ *        network drawn from the seed, identical in every instance.
+ */
+Large_XO_AI::Large_XO_AI(uint32_t untrainedSeed)
+{
+    shared_ptr<NeuralNetwork> nets[2];
+    const char* files[2] = { "netX.bin", "netO.bin" };
+    for (int i = 0; i < 2; ++i) {
+        if (ifstream(files[i])) {
+            nets[i] = loadNetwork(files[i]);
+            continue;
+        }
+        nets[i] = untrainedNetwork();
+        nets[i]->randomize(untrainedSeed + uint32_t(i));
+    }
+    setNetworks(nets[0], nets[1]);
+}
+
+/**
+ * @brief Install the networks and start the accumulators and cache afresh.
+ */
+void Large_XO_AI::setNetworks(shared_ptr<NeuralNetwork> netX, shared_ptr<NeuralNetwork> netO) {
+    NNX = std::move(netX);
+    NNO = std::move(netO);
+    evalCache = make_shared<Large_XO_EvalCache>();
+
+    // Accumulators start from the empty board (all-zero input)
+    accX.acc.assign(Large_XO_Symmetry::COUNT, Accumulator(NNX));
+    accO.acc.assign(Large_XO_Symmetry::COUNT, Accumulator(NNO));
+
+    newSearch();
+}
+
 // ----------------------------- Evaluate Board -----------------------------
 
 /**
@@ -369,123 +585,320 @@ float Large_XO_AI::evaluate(Board<char>* b, Player<char>* player) {
     }
 
     // Neural network evaluation
-    Matrix<double> input;
-    board->encode(ai, input);
-    Matrix<double> out = NN->predict(input);
+    float q[25];
+    predictQ(board, ai, q);
 
     // Choose best Q-value among empty cells
-    double bestQ = -1e9;
+    float bestQ = -1e9f;
     for (int idx = 0; idx < 25; ++idx)
         if (board->getCell(idx / 5, idx % 5) == board->getEmptyCell())
-            bestQ = max(bestQ, out(idx, 0));
+            bestQ = max(bestQ, q[idx]);
+
+    return bestQ;
+}
+
+// ----------------------------- NN Evaluation -----------------------------
+
+/**
+ * @brief Q-values for every cell, evaluated on the canonical orientation.
+ */
+void Large_XO_AI::predictQ(Large_XO_Board* board, char side, float q[25]) {
+    char other = (side == 'X') ? 'O' : 'X';
+    uint32_t own = board->getMask(side);
+    uint32_t opp = board->getMask(other);
+
+    int sym = 0;
+    uint64_t key = useSymmetry ? Large_XO_Symmetry::canonical(own, opp, sym)
+                               : (uint64_t(own) << 25) | opp;
+    key |= uint64_t(NN == NNO) << 50;         // separate entries per network
+    key |= uint64_t(useSymmetry) << 51;       // orientation mode
+
+    float canon[25];
+    if (!evalCache->probe(key, canon)) {
+        // Accumulators encode X as +1, so O's perspective negates the input
+        Matrix<double> out = evaluateNet(board->getMask('X'), board->getMask('O'), sym,
+                                         side == 'X' ? 1.0 : -1.0);
+
+        for (int idx = 0; idx < 25; ++idx)
+            canon[idx] = static_cast<float>(out(idx, 0));
+        evalCache->store(key, canon);
+    }
+
+    // Map canonical Q back to this orientation
+    for (int idx = 0; idx < 25; ++idx)
+        q[idx] = canon[Large_XO_Symmetry::mapCell(sym, idx)];
+}
+
+/**
+ * @brief Incremental first layer + remaining layers in one orientation.
+ */
+Matrix<double> Large_XO_AI::evaluateNet(uint32_t xMask, uint32_t oMask, int sym, double scale) {
+    AccumulatorSet& set = (NN == NNO) ? accO : accX;
+    Accumulator& acc = set.acc[sym];
+
+    // Apply only the cells that differ from what the accumulator reflects
+    uint32_t changed = (set.x[sym] ^ xMask) | (set.o[sym] ^ oMask);
+    for (int idx = 0; changed && idx < 25; ++idx) {
+        uint32_t bit = 1u << idx;
+        if (!(changed & bit)) continue;
+        changed &= ~bit;
+
+        double before = (set.x[sym] & bit) ? 1.0 : ((set.o[sym] & bit) ? -1.0 : 0.0);
+        double after  = (xMask & bit) ? 1.0 : ((oMask & bit) ? -1.0 : 0.0);
+        acc.add(Large_XO_Symmetry::mapCell(sym, idx), after - before);
+    }
+    set.x[sym] = xMask;
+    set.o[sym] = oMask;
 
-    return static_cast<float>(bestQ);
+    return acc.evaluate(scale);
 }
 
 // ----------------------------- Minimax Algorithm -----------------------------
 
 /**
- * @brief Minimax search with alpha-beta pruning and NN move ordering.
+ * @brief Minimax value from the AI's perspective (wraps the negamax search).
  */
 float Large_XO_AI::minimax(
     bool aiTurn,
     Player<char>* player,
     float alpha,
     float beta,
-    char blankCell,
+    char /*blankCell*/,
     int depth)
 {
     auto* board = dynamic_cast<Large_XO_Board*>(player->get_board_ptr());
-    char ai  = player->get_symbol();
-    char opp = (ai == 'X') ? 'O' : 'X';
-    char turn = aiTurn ? ai : opp;
 
-    // Terminal node
-    if (depth == 0 || board->game_is_over(nullptr))
-        return evaluate(board, player);
+    if (aiTurn)
+        return search(board, player, true, alpha, beta, depth, 0);
+    return -search(board, player, false, -beta, -alpha, depth, 0);
+}
+
+/**
+ * @brief Order empty cells: killers first, then by Q-value (or history).
+ */
+int Large_XO_AI::orderMoves(Large_XO_Board* board, char turn, int depth, int ply, int moves[25]) {
+    uint32_t occupied = board->getMask('X') | board->getMask('O');
+    const int* hist = history[turn == 'O'];
+
+    float q[25];
+    if (depth >= 2) predictQ(board, turn, q);   // network ordering where it pays off
+    else for (int idx = 0; idx < 25; ++idx) q[idx] = float(hist[idx]);
+
+    float key[25];
+    int n = 0;
+    for (int idx = 0; idx < 25; ++idx) {
+        if (occupied & (1u << idx)) continue;
+
+        float k = q[idx];
+        if (idx == killers[ply][0])      k = 2 * WINDOW;
+        else if (idx == killers[ply][1]) k = WINDOW;
+
+        // Insertion sort, best first
+        int i = n++;
+        while (i > 0 && key[i - 1] < k) {
+            key[i] = key[i - 1];
+            moves[i] = moves[i - 1];
+            --i;
+        }
+        key[i] = k;
+        moves[i] = idx;
+    }
+    return n;
+}
 
-    vector<pair<double,int>> moves;
+/**
+ * @brief Principal-variation search: the first move gets the full window,
+ *        later moves a null window and are re-searched only if they beat
+ *        alpha. Late moves are first tried one ply shallower.
+ */
+float Large_XO_AI::search(Large_XO_Board* board, Player<char>* player, bool aiTurn,
+                          float alpha, float beta, int depth, int ply) {
+    ++nodes;
 
-    // Move ordering using NN prediction
-    if (depth >= 2) {
-        Matrix<double> input;
-        board->encode(turn, input);
-        Matrix<double> out = NN->predict(input);
+    char ai   = player->get_symbol();
+    char turn = aiTurn ? ai : (ai == 'X' ? 'O' : 'X');
 
-        for (int i = 0; i < 25; ++i)
-            if (board->getCell(i / 5, i % 5) == blankCell)
-                moves.push_back({out(i, 0), i});
+    // Few cells left: exact value beats the network
+    if (!board->game_is_over(nullptr) && 25 - board->getMoveCount() <= endgameEmpties)
+        return solveExact(board, turn, aiTurn);
 
-        // Sort best-first for maximizing / minimizing
-        sort(moves.begin(), moves.end(),
-            aiTurn
-                ? [](pair<double,int>& a, pair<double,int>& b){ return a.first > b.first; }
-                : [](pair<double,int>& a, pair<double,int>& b){ return a.first < b.first; });
-    }
-    else {
-        // No ordering
-        for (int i = 0; i < 25; ++i)
-            if (board->getCell(i / 5, i % 5) == blankCell)
-                moves.push_back({0, i});
+    // Terminal node (evaluate() scores from the AI's side)
+    if (depth <= 0 || board->game_is_over(nullptr)) {
+        float v = evaluate(board, player);
+        return aiTurn ? v : -v;
     }
 
-    float best = aiTurn ? -1e9f : 1e9f;
+    int moves[25];
+    int n = orderMoves(board, turn, depth, ply, moves);
 
-    // Explore moves
-    for (auto& mv : moves) {
-        int r = mv.second / 5;
-        int c = mv.second % 5;
+    float best = -WINDOW;
+    for (int i = 0; i < n; ++i) {
+        int idx = moves[i];
+        int r = idx / 5, c = idx % 5;
 
         board->updateCell(r, c, turn);
-        float score = minimax(!aiTurn, player, alpha, beta, blankCell, depth - 1);
-        board->updateCell(r, c, 0);
-
-        if (aiTurn) {
-            best = max(best, score);
-            alpha = max(alpha, score);
+        float score;
+        if (i == 0) {
+            score = -search(board, player, !aiTurn, -beta, -alpha, depth - 1, ply + 1);
         }
         else {
-            best = min(best, score);
-            beta = min(beta, score);
+            // Null window just above alpha
+            float nullBeta = nextafter(alpha, WINDOW);
+            bool reduce = useLMR && depth >= LMR_MIN_DEPTH && i >= LMR_MIN_INDEX &&
+                          idx != killers[ply][0] && idx != killers[ply][1];
+
+            score = -search(board, player, !aiTurn, -nullBeta, -alpha,
+                            depth - 1 - (reduce ? 1 : 0), ply + 1);
+            if (reduce && score > alpha)
+                score = -search(board, player, !aiTurn, -nullBeta, -alpha, depth - 1, ply + 1);
+            if (score > alpha && score < beta)
+                score = -search(board, player, !aiTurn, -beta, -alpha, depth - 1, ply + 1);
         }
+        board->updateCell(r, c, 0);
+
+        if (score > best) best = score;
+        if (score > alpha) alpha = score;
 
-        // Prune branch
-        if (beta <= alpha) break;
+        // Prune branch, remember what caused it
+        if (alpha >= beta) {
+            if (killers[ply][0] != idx) {
+                killers[ply][1] = killers[ply][0];
+                killers[ply][0] = idx;
+            }
+            history[turn == 'O'][idx] += depth * depth;
+            break;
+        }
     }
 
     return best;
 }
 
+/**
+ * @brief Solve the position and scale it like evaluate()'s terminal score.
+ */
+float Large_XO_AI::solveExact(Large_XO_Board* board, char turn, bool aiTurn) {
+    char other = (turn == 'X') ? 'O' : 'X';
+    int diff = solver.solve(board->getMask(turn), board->getMask(other));
+
+    // evaluate() is from the AI's side; convert there and back
+    int aiDiff = aiTurn ? diff : -diff;
+    float v = aiDiff > 0 ? 10000.0f + aiDiff : (aiDiff < 0 ? -10000.0f + aiDiff : 0.0f);
+    return aiTurn ? v : -v;
+}
+
 // ----------------------------- Best Move -----------------------------
 
+void Large_XO_AI::newSearch() {
+    for (auto& k : killers) k[0] = k[1] = -1;
+    for (auto& side : history)
+        for (int& h : side) h /= 2;
+    nodes = 0;
+}
+
 /**
- * @brief Compute the best possible move using minimax search.
+ * @brief Score every legal root move with a full-window search.
  */
-Move<char>* Large_XO_AI::bestMove(Player<char>* player, char blankCell, int depth) {
+void Large_XO_AI::scoreMoves(Player<char>* player, char blankCell, int depth, float scores[25]) {
     auto* board = dynamic_cast<Large_XO_Board*>(player->get_board_ptr());
     char ai = player->get_symbol();
 
     // Use correct NN (for X or O)
     NN = (ai == 'X') ? NNX : NNO;
+    newSearch();
 
-    float bestVal = -1e9f;
-    int bestR = -1, bestC = -1;
-
-    // Try all legal moves
     for (int r = 0; r < 5; ++r)
         for (int c = 0; c < 5; ++c) {
+            scores[5 * r + c] = -1e9f;
             if (board->getCell(r, c) != blankCell) continue;
 
+            // Exact value per move (no root pruning), used for training targets
             board->updateCell(r, c, ai);
-            float val = minimax(false, player, -1e9f, 1e9f, blankCell, depth - 1);
+            scores[5 * r + c] = -search(board, player, false, -WINDOW, WINDOW, depth - 1, 1);
             board->updateCell(r, c, 0);
+        }
+}
+
+/**
+ * @brief One root iteration; alpha rises across moves so later moves are
+ *        only proven worse (null window) unless they beat the best so far.
+ */
+float Large_XO_AI::searchRoot(Large_XO_Board* board, Player<char>* player,
+                              vector<int>& moves, float alpha, float beta, int depth) {
+    char ai = player->get_symbol();
+    float best = -WINDOW;
+    size_t bestAt = 0;
+
+    for (size_t i = 0; i < moves.size(); ++i) {
+        int r = moves[i] / 5, c = moves[i] % 5;
+
+        board->updateCell(r, c, ai);
+        float score;
+        if (i == 0) {
+            score = -search(board, player, false, -beta, -alpha, depth - 1, 1);
+        }
+        else {
+            float nullBeta = nextafter(alpha, WINDOW);
+            score = -search(board, player, false, -nullBeta, -alpha, depth - 1, 1);
+            if (score > alpha && score < beta)
+                score = -search(board, player, false, -beta, -alpha, depth - 1, 1);
+        }
+        board->updateCell(r, c, 0);
+
+        if (score > best) {
+            best = score;
+            bestAt = i;
+        }
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+
+    // Best move leads the next iteration
+    rotate(moves.begin(), moves.begin() + bestAt, moves.begin() + bestAt + 1);
+    return best;
+}
+
+/**
+ * @brief Iterative deepening with aspiration windows around the previous
+ *        iteration's score; a window that fails is widened to the full range.
+ */
+Move<char>* Large_XO_AI::bestMove(Player<char>* player, char /*blankCell*/, int depth) {
+    auto* board = dynamic_cast<Large_XO_Board*>(player->get_board_ptr());
+    char ai = player->get_symbol();
+
+    // Use correct NN (for X or O)
+    NN = (ai == 'X') ? NNX : NNO;
+    newSearch();
+
+    // Endgame: play the solved move
+    if (25 - board->getMoveCount() <= endgameEmpties && !board->game_is_over(nullptr)) {
+        char opp = (ai == 'X') ? 'O' : 'X';
+        int idx = solver.bestMove(board->getMask(ai), board->getMask(opp));
+        return new Move<char>(idx / 5, idx % 5, ai);
+    }
+
+    int ordered[25];
+    int n = orderMoves(board, ai, 2, 0, ordered);
+    vector<int> moves(ordered, ordered + n);
+    if (moves.empty()) return new Move<char>(-1, -1, ai);
 
-            if (val > bestVal) {
-                bestVal = val;
-                bestR = r;
-                bestC = c;
+    float prev = 0.0f;
+    for (int d = 1; d <= depth; ++d) {
+        float alpha = (d == 1) ? -WINDOW : prev - ASPIRATION;
+        float beta  = (d == 1) ?  WINDOW : prev + ASPIRATION;
+
+        while (true) {
+            vector<int> tried = moves;
+            float score = searchRoot(board, player, tried, alpha, beta, d);
+
+            if (score <= alpha && alpha > -WINDOW) alpha = -WINDOW;   // fail low
+            else if (score >= beta && beta < WINDOW) beta = WINDOW;   // fail high
+            else {
+                moves = tried;
+                prev = score;
+                break;
             }
         }
+    }
 
-    return new Move<char>(bestR, bestC, ai);
-}
\ No newline at end of file
+    return new Move<char>(moves[0] / 5, moves[0] % 5, ai);
+}
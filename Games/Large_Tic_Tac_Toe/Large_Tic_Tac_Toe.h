@@ -19,9 +19,52 @@
 #include "../../header/Custom_UI.h"
 #include "../../header/AI.h"
 #include "../../Neural_Network/Include/NeuralNetwork.h"
+#include "../../Neural_Network/Include/Accumulator.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
+/**
+ * @class Large_XO_Symmetry
+ * @brief The 8 dihedral symmetries of the 5x5 board on 25-bit masks.
+ *
+ * @ingroup Large_XO
+ *
+ * Symmetries are applied through precomputed per-row tables (5 lookups per
+ * mask). Symmetry 0 is the identity; 1–3 are rotations by 90°, 180°, 270°;
+ * 4–7 are the horizontal, vertical, main-diagonal and anti-diagonal mirrors.
+ */
+class Large_XO_Symmetry
+{
+public:
+    static constexpr int COUNT = 8; ///< Number of symmetries
+
+    /**
+     * @brief Cell that index idx moves to under symmetry s.
+     * @param s Symmetry [0–7]
+     * @param idx Cell index 5*r+c
+     */
+    static int mapCell(int s, int idx);
+
+    /**
+     * @brief Apply symmetry s to a 25-bit cell mask.
+     */
+    static uint32_t apply(int s, uint32_t mask);
+
+    /**
+     * @brief Canonical (minimal) form of a position over all 8 symmetries.
+     * @param own Mask of the side to move
+     * @param opp Mask of the other side
+     * @param sym Receives the symmetry mapping the position to its canonical form
+     * @return (apply(sym, own) << 25) | apply(sym, opp)
+     */
+    static uint64_t canonical(uint32_t own, uint32_t opp, int& sym);
+};
+
 /**
  * @class Large_XO_Board
  * @brief 5x5 Tic-Tac-Toe board implementation using a bitboard for fast evaluation.
@@ -74,6 +117,13 @@ public:
     /** @brief Check if the game is over (board full). */
     bool game_is_over(Player<char>* /*player*/) override;
 
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        boardX = boardO = boardXO = 0;
+        nMoves = n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), emptyCell);
+    }
+
     /** @brief Check if the player has a winning configuration. */
     bool is_win(Player<char>* player) override;
 
@@ -98,27 +148,181 @@ public:
      */
     void encode(char ai, Matrix<double>& input);
 
+    /**
+     * @brief Bitmask of the cells holding a symbol.
+     * @param sym 'X' or 'O'
+     */
+    uint32_t getMask(char sym) const { return sym == 'X' ? boardX : boardO; }
+
+    /**
+     * @brief Number of 3-in-a-row patterns inside a cell mask.
+     *
+     * Counts all four directions with shifted ANDs and popcounts.
+     */
+    static int countPatterns(uint32_t mask);
+
 private:
     uint32_t boardX   = 0;        ///< Bitmask for X positions
     uint32_t boardO   = 0;        ///< Bitmask for O positions
     uint32_t boardXO  = 0;        ///< Bitmask for all occupied positions
-    static uint32_t win3Masks[48];///< All 3-in-a-row combinations
 
     char emptyCell = '.';         ///< Empty cell symbol
     int  nMoves    = 0;           ///< Number of moves played
 };
 
+/**
+ * @class Large_XO_EvalCache
+ * @brief Bounded, hash-indexed cache of network Q-vectors.
+ *
+ * @ingroup Large_XO
+ *
+ * A fixed power-of-two table of (key, 25 Q-values) entries indexed by a
+ * hash of the key; a colliding store replaces the old entry, so memory
+ * never grows. Keys are built from the two 25-bit masks and the side /
+ * network bits (see Large_XO_AI::predictQ).
+ *
+ * Safe to share between threads: buckets are guarded by striped locks.
+ */
+class Large_XO_EvalCache
+{
+public:
+    /**
+     * @param log2Entries Table size as a power of two (default 2^16, ~7 MB)
+     */
+    explicit Large_XO_EvalCache(int log2Entries = 16);
+
+    /**
+     * @brief Look up a key.
+     * @param key Position key
+     * @param q Receives the 25 cached values on a hit
+     * @return True on a hit
+     */
+    bool probe(uint64_t key, float q[25]);
+
+    /** @brief Store (or replace) the values for a key. */
+    void store(uint64_t key, const float q[25]);
+
+    /** @brief Drop every entry. */
+    void clear();
+
+    /** @brief Lookups that hit. */
+    uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+
+    /** @brief Lookups that missed. */
+    uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        uint64_t key = EMPTY; ///< Position key, EMPTY if unused
+        float q[25];          ///< Cached Q-values
+    };
+
+    static constexpr uint64_t EMPTY = ~uint64_t(0);
+    static constexpr int STRIPES = 64;
+
+    std::vector<Entry> table;          ///< Entry table (size = mask + 1)
+    uint64_t mask;                     ///< Index mask
+    std::mutex locks[STRIPES];         ///< Striped bucket locks
+    std::atomic<uint64_t> hitCount{0}; ///< Hit counter
+    std::atomic<uint64_t> missCount{0};///< Miss counter
+
+    size_t indexOf(uint64_t key) const;
+};
+
+/**
+ * @class Large_XO_Solver
+ * @brief Exact endgame solver on bitboards.
+ *
+ * @ingroup Large_XO
+ *
+ * Negamax alpha-beta to the end of the game (24 stones) on the final
+ * pattern difference. Uses a transposition table that persists across
+ * calls, bounds from the patterns each side could still complete, and move
+ * ordering by the table move, then immediate pattern gain (own patterns
+ * completed plus opponent patterns blocked).
+ */
+class Large_XO_Solver
+{
+public:
+    /**
+     * @param log2Entries Transposition table size as a power of two
+     */
+    explicit Large_XO_Solver(int log2Entries = 18);
+
+    /**
+     * @brief Exact final pattern difference with perfect play.
+     * @param own Mask of the side to move
+     * @param opp Mask of the other side
+     * @return countPatterns(own) - countPatterns(opp) at the end of the game
+     */
+    int solve(uint32_t own, uint32_t opp);
+
+    /**
+     * @brief Best move for the side to move.
+     * @param own Mask of the side to move
+     * @param opp Mask of the other side
+     * @param value Receives the solved value (may be null)
+     * @return Cell index 5*r+c, -1 if the game is over
+     */
+    int bestMove(uint32_t own, uint32_t opp, int* value = nullptr);
+
+    /** @brief Nodes visited since construction. */
+    uint64_t nodes() const { return nodeCount; }
+
+private:
+    enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        uint64_t key = 0;    ///< (own << 25) | opp
+        int8_t value = 0;    ///< Score (side to move)
+        uint8_t bound = NONE;///< Bound type of value
+        int8_t move = -1;    ///< Best move found
+    };
+
+    std::vector<Entry> table; ///< Transposition table (replace always)
+    uint64_t mask;            ///< Index mask
+    uint64_t nodeCount = 0;   ///< Node counter
+
+    int negamax(uint32_t own, uint32_t opp, int alpha, int beta, int& move);
+};
+
 /**
  * @class Large_XO_AI
  * @brief AI for 5x5 Tic-Tac-Toe using Minimax + Neural Network heuristic.
  *
  * @ingroup AI
+ *
+ * Search is principal-variation (negascout) alpha-beta: iterative deepening
+ * at the root with aspiration windows and alpha carried across root moves;
+ * moves are ordered by killer moves, then network Q-values (or the history
+ * table near the leaves). Optional late-move reductions search late moves
+ * one ply shallower and re-search them if they beat alpha.
  */
 class Large_XO_AI : public AI
 {
 public:
+    /**
+     * @brief Load netX.bin and netO.bin from the working directory.
+     *
+     * If either cannot be loaded an error is printed and both networks are
+     * untrained, with weights that differ from run to run.
+     */
     Large_XO_AI();
 
+    /**
+     * @brief Load netX.bin and netO.bin, replacing a missing file by an
+     *        untrained network drawn from @p untrainedSeed (for self-play
+     *        bootstrapping and repeatable benchmarks).
+     * @throws std::runtime_error if a file exists but cannot be loaded
+     */
+    explicit Large_XO_AI(std::uint32_t untrainedSeed);
+
+    /**
+     * @brief Load one Q-network file, in the model or the legacy format.
+     * @throws std::runtime_error if the file is missing or does not fit
+     */
+    static std::shared_ptr<NeuralNetwork> loadNetwork(const std::string& filename);
+
     /**
      * @brief Evaluate a board using neural network + terminal heuristics.
      * @param board Pointer to the board
@@ -155,10 +359,141 @@ public:
                          char blankCell,
                          int depth = 6) override;
 
+    /**
+     * @brief Minimax value of every root move (used for self-play targets).
+     * @param player Pointer to AI player (board taken from it)
+     * @param blankCell Symbol for empty cells
+     * @param depth Search depth, root ply included
+     * @param scores Receives 25 values indexed 5*r+c; occupied cells get -1e9
+     */
+    void scoreMoves(Player<char>* player,
+                    char blankCell,
+                    int depth,
+                    float scores[25]);
+
+    /**
+     * @brief Evaluate positions in canonical (symmetry-reduced) orientation.
+     *
+     * When enabled (default) the network sees each symmetry class in one
+     * orientation and results are cached per class, so the up to 8
+     * equivalent positions met in a search cost one forward pass.
+     */
+    void setSymmetry(bool enabled) { useSymmetry = enabled; evalCache->clear(); }
+
+    /**
+     * @brief Use a shared evaluation cache (e.g. one per process for
+     *        several AIs on worker threads). Networks must be the same.
+     */
+    void setEvalCache(std::shared_ptr<Large_XO_EvalCache> cache) { evalCache = std::move(cache); }
+
+    /** @brief Evaluation cache used by this AI. */
+    const std::shared_ptr<Large_XO_EvalCache>& getEvalCache() const { return evalCache; }
+
+    /**
+     * @brief Solve positions exactly once at most @p empties cells are empty.
+     * @param empties Threshold (0 disables the solver; default 10)
+     */
+    void setEndgameEmpties(int empties) { endgameEmpties = empties; }
+
+    /** @brief Nodes visited by the last bestMove / scoreMoves call. */
+    uint64_t lastNodes() const { return nodes; }
+
+    /**
+     * @brief Enable late-move reductions (default off).
+     *
+     * Saves roughly a third of the nodes at depth 4, but at the shallow
+     * depths used here it sometimes picks a slightly worse move.
+     */
+    void setLateMoveReductions(bool enabled) { useLMR = enabled; }
+
 private:
+    static constexpr int MAX_PLY = 26;        ///< Deeper than any 5x5 game
+    static constexpr float WINDOW = 1e9f;     ///< Full search window bound
+    static constexpr float ASPIRATION = 0.25f;///< Half-width of root aspiration windows
+    static constexpr int LMR_MIN_DEPTH = 3;   ///< Reduce only with this much depth left
+    static constexpr int LMR_MIN_INDEX = 4;   ///< Moves searched before reducing
+
+    /**
+     * @brief Negamax principal-variation search.
+     * @param aiTurn True if the AI is to move
+     * @param alpha Lower bound, side-to-move perspective
+     * @param beta Upper bound, side-to-move perspective
+     * @param depth Remaining depth
+     * @param ply Distance from the root
+     * @return Score from the side to move's perspective
+     */
+    float search(Large_XO_Board* board, Player<char>* player, bool aiTurn,
+                 float alpha, float beta, int depth, int ply);
+
+    /**
+     * @brief Root search over @p moves (reordered best-first on return).
+     * @return Best score, AI perspective (a bound if outside (alpha, beta))
+     */
+    float searchRoot(Large_XO_Board* board, Player<char>* player,
+                     std::vector<int>& moves, float alpha, float beta, int depth);
+
+    /**
+     * @brief Fill @p moves with the empty cells, best-first.
+     * @return Number of moves
+     */
+    int orderMoves(Large_XO_Board* board, char turn, int depth, int ply, int moves[25]);
+
+    /** @brief Reset killers and age the history table before a new search. */
+    void newSearch();
+
+    /** @brief Use these networks, with fresh accumulators and eval cache. */
+    void setNetworks(std::shared_ptr<NeuralNetwork> netX, std::shared_ptr<NeuralNetwork> netO);
+
+    /**
+     * @brief Exact value in evaluate() units, side-to-move perspective.
+     */
+    float solveExact(Large_XO_Board* board, char turn, bool aiTurn);
+
+    Large_XO_Solver solver;   ///< Exact endgame search
+    int endgameEmpties = 10;  ///< Solve at or below this many empty cells
+
+    int killers[MAX_PLY][2];  ///< Two most recent cutoff moves per ply
+    int history[2][25] = {};  ///< Cutoff counts per side (X, O) and cell
+    uint64_t nodes = 0;       ///< Node counter
+    bool useLMR = false;      ///< Late-move reductions enabled
+
+    /**
+     * @brief Network Q-values for every cell, from @p side's perspective.
+     * @param board Board to evaluate
+     * @param side Symbol whose stones encode as +1
+     * @param q Receives 25 values indexed 5*r+c
+     */
+    void predictQ(Large_XO_Board* board, char side, float q[25]);
+
+    /**
+     * @brief First-layer sums of one network for each board orientation.
+     *
+     * Entry s accumulates the X=+1 / O=-1 encoding of the board seen
+     * under symmetry s, together with the masks it currently reflects.
+     */
+    struct AccumulatorSet {
+        std::vector<Accumulator> acc; ///< One per symmetry
+        uint32_t x[8] = {};           ///< X mask reflected by acc[s]
+        uint32_t o[8] = {};           ///< O mask reflected by acc[s]
+    };
+
+    /**
+     * @brief Network output for the current position in orientation @p sym.
+     *
+     * Brings the orientation's accumulator up to date by adding one weight
+     * column per cell that changed since it was last used (typically the
+     * moves made/unmade in between), then evaluates the remaining layers.
+     */
+    Matrix<double> evaluateNet(uint32_t xMask, uint32_t oMask, int sym, double scale);
+
+    bool useSymmetry = true;                        ///< Canonicalize before evaluating
+    std::shared_ptr<Large_XO_EvalCache> evalCache;  ///< Position -> Q, kept across moves
+
     std::shared_ptr<NeuralNetwork> NN;   ///< Shared neural network
     std::shared_ptr<NeuralNetwork> NNX;  ///< NN specialized for X
     std::shared_ptr<NeuralNetwork> NNO;  ///< NN specialized for O
+    AccumulatorSet accX;                 ///< Incremental first layer of NNX
+    AccumulatorSet accO;                 ///< Incremental first layer of NNO
     char aiSymbol  = 'X';
     char oppSymbol = 'O';
 };
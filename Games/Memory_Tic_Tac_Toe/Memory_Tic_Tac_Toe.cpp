@@ -4,7 +4,7 @@
  *
  * Features:
  *  - Board logic: moves, game state checks, win/draw detection
- *  - AI logic: minimax algorithm with alpha-beta pruning
+ *  - AI logic: determinized search over the AI's information set
  *  - UI logic: human input, AI/computer moves, board display
  */
 
@@ -15,6 +15,8 @@
 #include <limits>
 #include <stdexcept>
 #include <cstdlib>
+#include <bitset>
+#include <algorithm>
 
 using namespace std;
 
@@ -41,11 +43,15 @@ bool Memory_Board::update_board(Move<char>* move)
     if (x < 0 || x >= rows || y < 0 || y >= columns)
         throw out_of_range("Move coordinates out of bounds");
 
+    uint16_t bit = uint16_t(1u << (x * 3 + y));
+
     // Undo move if mark is blank or zero
     if (mark == 0 || mark == blank_symbol)
     {
         if (board[x][y] != blank_symbol) n_moves--; // decrement move count
         board[x][y] = blank_symbol;
+        boardX &= ~bit;
+        boardO &= ~bit;
         return true;
     }
 
@@ -53,6 +59,8 @@ bool Memory_Board::update_board(Move<char>* move)
     if (board[x][y] == blank_symbol)
     {
         board[x][y] = toupper(mark);
+        if (board[x][y] == 'X') boardX |= bit;
+        else                    boardO |= bit;
         n_moves++;
         return true;
     }
@@ -60,6 +68,19 @@ bool Memory_Board::update_board(Move<char>* move)
     return false; // Cell already occupied
 }
 
+// Check a bitboard against the 8 lines
+bool Memory_Board::hasLine(uint16_t mask)
+{
+    static const uint16_t lines[8] = {
+        0007, 0070, 0700,       // rows
+        0111, 0222, 0444,       // columns
+        0421, 0124              // diagonals
+    };
+    for (uint16_t line : lines)
+        if ((mask & line) == line) return true;
+    return false;
+}
+
 // Check if the given player has a winning line
 bool Memory_Board::is_win(Player<char>* player)
 {
@@ -176,37 +197,145 @@ float Memory_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float b
     return best;
 }
 
-// Compute the best move for AI
-Move<char>* Memory_AI::bestMove(Player<char>* player, char blankCell, int depth)
+Memory_AI::Memory_AI(uint64_t seed) : rng(seed) {}
+
+// Exact value for the side to move, memoized over all positions
+int Memory_AI::solve(uint16_t own, uint16_t opp)
+{
+    // 2^18 (own, opp) pairs, filled once on first use
+    static const vector<int8_t> table = [] {
+        vector<int8_t> t(1u << 18, 0);
+        vector<bool> done(1u << 18, false);
+
+        auto rec = [&](auto&& self, uint16_t me, uint16_t them) -> int {
+            uint32_t key = (uint32_t(me) << 9) | them;
+            if (done[key]) return t[key];
+
+            uint16_t empty = uint16_t(~(me | them) & 0777);
+            int best = empty ? -100 : 0;
+            for (int idx = 0; idx < 9; ++idx)
+            {
+                uint16_t bit = uint16_t(1u << idx);
+                if (!(empty & bit)) continue;
+
+                uint16_t next = me | bit;
+                // A win scores 1 + the cells left empty after it
+                int v = Memory_Board::hasLine(next)
+                            ? int(bitset<9>(empty).count())
+                            : -self(self, them, next);
+                best = max(best, v);
+            }
+
+            done[key] = true;
+            t[key] = int8_t(best);
+            return best;
+        };
+        rec(rec, 0, 0);
+        return t;
+    }();
+
+    return table[(uint32_t(own) << 9) | opp];
+}
+
+// Remember new opponent moves, drop stale memory, and forget at random
+void Memory_AI::observe(uint16_t occupied)
+{
+    // Cells disappeared: a new game (or an undo) started
+    if ((lastOccupied & occupied) != lastOccupied)
+        resetMemory();
+
+    // A move of ours that was not applied is not ours
+    memOwn &= occupied;
+    memOpp &= occupied;
+
+    // Everything that appeared since our last move is the opponent's.
+    // Without a move of ours to compare against (first turn, or joining a
+    // game in progress) the stones on the board stay unknown.
+    if (lastOccupied)
+        memOpp |= occupied & ~lastOccupied & ~memOwn;
+
+    if (forgetRate > 0.0)
+    {
+        bernoulli_distribution forget(forgetRate);
+        for (int idx = 0; idx < 9; ++idx)
+        {
+            uint16_t bit = uint16_t(1u << idx);
+            if ((memOwn | memOpp) & bit && forget(rng))
+            {
+                memOwn &= ~bit;
+                memOpp &= ~bit;
+            }
+        }
+    }
+}
+
+// Compute the best move for AI from its information set
+Move<char>* Memory_AI::bestMove(Player<char>* player, char /*blankCell*/, int /*depth*/)
 {
     auto* board = dynamic_cast<Memory_Board*>(player->get_board_ptr());
     if (!board || !player) throw invalid_argument("Invalid board or player in bestMove()");
 
     char ai = player->get_symbol();
-    float bestVal = -INF;
-    int bestR = -1, bestC = -1;
-
-    // Evaluate all possible moves
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            if (board->get_cell(i, j) == blankCell)
-            {
-                Move<char> move(i, j, ai);
-                board->update_board(&move);
+    uint16_t occupied = board->getOccupied();   // visible to any player
+    observe(occupied);
+
+    // Stone counts follow from the move count (X moves first)
+    int stones = int(bitset<9>(occupied).count());
+    int ownCount = (ai == 'X') ? (stones + 1) / 2 : stones / 2;
+    int needOwn = ownCount - int(bitset<9>(memOwn).count());
+
+    uint16_t unknown = occupied & ~(memOwn | memOpp);
+    int cells[9], n = 0;
+    for (int idx = 0; idx < 9; ++idx)
+        if (unknown & (1u << idx)) cells[n++] = idx;
+
+    // Average exact value of every move over consistent determinizations.
+    // If memory contradicts every one of them, average over all fillings.
+    float total[9] = {};
+    int worlds = 0;
+    for (int pass = 0; pass < 2 && worlds == 0; ++pass)
+    {
+        const bool consistent = (pass == 0);
+        for (uint32_t pick = 0; pick < (1u << n); ++pick)
+        {
+            if (consistent && int(bitset<9>(pick).count()) != needOwn) continue;
 
-                float val = minimax(false, player, -INF, INF, blankCell, depth - 1);
+            uint16_t own = memOwn, opp = memOpp;
+            for (int i = 0; i < n; ++i)
+                ((pick >> i) & 1u ? own : opp) |= uint16_t(1u << cells[i]);
 
-                // Undo move
-                move = Move<char>(i, j, 0);
-                board->update_board(&move);
+            // The game is not over, so nobody can have a line yet
+            if (consistent && (Memory_Board::hasLine(own) || Memory_Board::hasLine(opp))) continue;
 
-                if (val > bestVal) { bestVal = val; bestR = i; bestC = j; }
+            ++worlds;
+            for (int idx = 0; idx < 9; ++idx)
+            {
+                uint16_t bit = uint16_t(1u << idx);
+                if (occupied & bit) continue;
+                total[idx] += Memory_Board::hasLine(own | bit)
+                                  ? float(9 - stones)
+                                  : float(-solve(opp, own | bit));
             }
+        }
+    }
+
+    // Best average, ties broken at random
+    float bestVal = -INF;
+    int bestIdx = -1, ties = 0;
+    for (int idx = 0; idx < 9; ++idx)
+    {
+        if (occupied & (1u << idx)) continue;
+        float v = worlds ? total[idx] / worlds : 0.0f;
+        if (bestIdx < 0 || v > bestVal) { bestVal = v; bestIdx = idx; ties = 1; }
+        else if (v == bestVal && uniform_int_distribution<int>(0, ties++)(rng) == 0) bestIdx = idx;
+    }
 
-    if (bestR == -1 || bestC == -1)
+    if (bestIdx == -1)
         throw runtime_error("No valid moves left for AI");
 
-    return new Move<char>(bestR, bestC, ai);
+    memOwn |= uint16_t(1u << bestIdx);
+    lastOccupied = occupied | uint16_t(1u << bestIdx);
+    return new Move<char>(bestIdx / 3, bestIdx % 3, ai);
 }
 
 //--------------------------------------- Memory_UI Implementation
@@ -258,8 +387,7 @@ Move<char>* Memory_UI::get_move(Player<char>* player)
     {
         try
         {
-            Memory_AI aiMove;
-            return aiMove.bestMove(player, '.', 9);
+            return ai.bestMove(player, '.', 9);
         }
         catch (const exception& e)
         {
@@ -18,6 +18,7 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
 #include "../../header/Custom_UI.h"
+#include <cstdint>
 #include <limits>
 #include <vector>
 #include <random>
@@ -40,6 +41,8 @@ using namespace std;
 class Memory_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Symbol representing empty cells
+    uint16_t boardX = 0;     ///< Bitboard of X cells (bit 3*r+c)
+    uint16_t boardO = 0;     ///< Bitboard of O cells
 
 public:
     /**
@@ -82,11 +85,34 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        boardX = boardO = 0;
+        n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), blank_symbol);
+    }
+
     /**
      * @brief Returns the symbol representing blank cells.
      * @return Character representing blank cells
      */
     char get_blank_symbol() const { return blank_symbol; }
+
+    /**
+     * @brief Bitboard of the cells holding a symbol (bit 3*r+c).
+     * @param sym 'X' or 'O'
+     */
+    uint16_t getMask(char sym) const { return sym == 'X' ? boardX : boardO; }
+
+    /**
+     * @brief Bitboard of occupied cells: the only thing players can see.
+     */
+    uint16_t getOccupied() const { return boardX | boardO; }
+
+    /**
+     * @brief True if a bitboard contains a 3-in-a-row.
+     */
+    static bool hasLine(uint16_t mask);
 };
 
 /**
@@ -98,10 +124,24 @@ public:
  * Responsibilities:
  *  - Evaluate board states
  *  - Generate the best move using minimax
+ *
+ * bestMove() plays from the information a player really has: which cells
+ * are occupied, plus its own memory of who played where. Memory is built
+ * from its own moves and from the cells that became occupied between its
+ * turns (stones already on the board at its first turn stay unknown); each
+ * remembered cell may be forgotten with a configurable probability per
+ * turn. Unknown occupied cells are filled in every way consistent with the
+ * stone counts (determinizations), positions where the game would already
+ * be over are dropped, and each legal move is scored by its average exact
+ * value over the rest (memoized bitboard solve). If no filling is
+ * consistent, all of them are averaged.
  */
 class Memory_AI : public AI {
 public:
-    Memory_AI() = default;
+    /**
+     * @param seed Seed for forgetting and tie-breaking (random by default)
+     */
+    explicit Memory_AI(uint64_t seed = std::random_device{}());
 
     /**
      * @brief Evaluates the board state from AI perspective.
@@ -124,13 +164,41 @@ public:
     float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override;
 
     /**
-     * @brief Determines the optimal move for AI using minimax.
+     * @brief Chooses a move from the AI's information set.
      * @param player Pointer to AI player
      * @param blankCell Symbol for empty cells
-     * @param depth Maximum search depth
+     * @param depth Unused (every determinization is solved exactly)
      * @return Pointer to the chosen Move<char>
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 9) override;
+
+    /**
+     * @brief Probability of forgetting each remembered cell per turn.
+     * @param p 0 = perfect recall (default 0.1)
+     */
+    void setForgetRate(double p) { forgetRate = p; }
+
+    /** @brief Restart the forgetting / tie-break generator from a seed. */
+    void setSeed(uint64_t seed) { rng.seed(seed); }
+
+    /** @brief Forget everything (start of a new game). */
+    void resetMemory() { memOwn = memOpp = lastOccupied = 0; }
+
+private:
+    /**
+     * @brief Exact value for the side to move: +(1 + empties) for a win,
+     *        negative for a loss, 0 for a draw (faster wins score higher).
+     */
+    static int solve(uint16_t own, uint16_t opp);
+
+    /** @brief Update memory from the visible occupancy. */
+    void observe(uint16_t occupied);
+
+    uint16_t memOwn = 0;       ///< Cells remembered as own
+    uint16_t memOpp = 0;       ///< Cells remembered as the opponent's
+    uint16_t lastOccupied = 0; ///< Occupancy seen at the end of the last turn
+    double forgetRate = 0.1;   ///< Per-cell, per-turn forgetting probability
+    std::mt19937_64 rng;       ///< Forgetting / tie-break generator
 };
 
 /**
@@ -167,6 +235,9 @@ public:
      * @param matrix Two-dimensional grid of board characters
      */
     void display_board_matrix(const vector<vector<char>>& matrix) const;
+
+private:
+    Memory_AI ai; ///< Keeps its memory across turns
 };
 
 /** @} */ // end of Memory_XO
@@ -1,8 +1,34 @@
 #include "Obstacles_Tic_Tac_Toe.h"
 #include <cstdint>
 #include <algorithm>
+#include <bitset>
 #include <random>
 
+namespace {
+
+/// Number of set bits.
+inline int popcount64(uint64_t x) { return int(std::bitset<64>(x).count()); }
+
+/// Index of the n-th (0-based) set bit of x.
+inline int nthBit(uint64_t x, int n)
+{
+    for (int idx = 0; idx < 64; ++idx)
+        if ((x >> idx) & 1ULL)
+            if (n-- == 0) return idx;
+    return -1;
+}
+
+/// splitmix64 step: advances state, returns the next value.
+inline uint64_t nextRandom(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
 /// Initialize static array of winning 4-in-a-row masks.
 uint64_t Obstacles_Board::win4Masks[54] {};
 
@@ -22,9 +48,12 @@ uint64_t Obstacles_Board::win4Masks[54] {};
  *  - boardX      bits for X moves
  *  - boardO      bits for O moves
  *  - boardTraps  bits for traps (blocked cells)
+ *
+ * The trap generator starts from a random seed; use setTrapSeed() for
+ * reproducible games.
  */
 Obstacles_Board::Obstacles_Board()
-    : Board(6, 6), emptyCell('.')
+    : Board(6, 6), emptyCell('.'), trapRng(std::random_device{}())
 {
     board.assign(6, vector<char>(6, emptyCell));
 
@@ -138,11 +167,11 @@ std::vector<size_t> Obstacles_Board::getAvailableMove()
     std::vector<size_t> avail;
     avail.reserve(36);
 
-    uint64_t full = boardX | boardO | boardTraps;
+    uint64_t free = getAvailableMask();
 
     for (size_t idx = 0; idx < 36; ++idx)
     {
-        if ((full & (1ULL << idx)) == 0)
+        if (free & (1ULL << idx))
             avail.push_back(idx);
     }
 
@@ -159,6 +188,96 @@ int Obstacles_Board::getMoveCount()
 }
 
 
+/* ============================================================
+    drawTraps()
+   ============================================================ */
+/**
+ * @brief Picks two distinct free cells with the board's generator.
+ *
+ * @param exclude Cells to treat as taken (the move being played)
+ * @return Trap mask (empty if fewer than two cells are free).
+ */
+uint64_t Obstacles_Board::drawTraps(uint64_t exclude)
+{
+    uint64_t free = getAvailableMask() & ~exclude;
+    int n = popcount64(free);
+    if (n < 2) return 0;
+
+    uint64_t first = 1ULL << nthBit(free, int(nextRandom(trapRng) % n));
+    free &= ~first;
+    uint64_t second = 1ULL << nthBit(free, int(nextRandom(trapRng) % (n - 1)));
+
+    return first | second;
+}
+
+
+/* ============================================================
+    placeMove() / undoMove()
+   ============================================================ */
+/**
+ * @brief Places a symbol and the given traps, recording both for undo.
+ */
+bool Obstacles_Board::placeMove(size_t idx, char s, uint64_t traps)
+{
+    return apply(idx, s, traps, trapRng);
+}
+
+bool Obstacles_Board::apply(size_t idx, char s, uint64_t traps, uint64_t rngBefore)
+{
+    if (idx >= 36 || nMoves >= 36) return false;
+
+    uint64_t bit = 1ULL << idx;
+    if (!(getAvailableMask() & bit)) return false;
+
+    if (s == 'X') boardX |= bit;
+    else          boardO |= bit;
+
+    HistoryEntry& h = history[nMoves++];
+    h.cell = uint8_t(idx);
+    h.traps = traps & getAvailableMask();
+    h.rngBefore = rngBefore;
+    boardTraps |= h.traps;
+
+    board[idx / 6][idx % 6] = s;
+    setCells(h.traps, '#');
+
+    return true;
+}
+
+/**
+ * @brief Removes the last move and exactly the traps it added, and
+ *        rewinds the trap generator.
+ */
+bool Obstacles_Board::undoMove()
+{
+    if (nMoves == 0) return false;
+
+    const HistoryEntry& h = history[--nMoves];
+    uint64_t mask = ~(1ULL << h.cell);
+    boardX     &= mask;
+    boardO     &= mask;
+    boardTraps &= ~h.traps;
+    trapRng     = h.rngBefore;
+
+    setCells((1ULL << h.cell) | h.traps, emptyCell);
+    return true;
+}
+
+
+/**
+ * @brief Keeps the inherited matrix in step with the bitboards, so
+ *        get_cell and get_board_matrix see the same board.
+ */
+void Obstacles_Board::setCells(uint64_t mask, char s)
+{
+    for (; mask; mask &= mask - 1)
+    {
+        int idx = nthBit(mask, 0);
+        board[idx / 6][idx % 6] = s;
+    }
+}
+
+
 /* ============================================================
     updateCell()
    ============================================================ */
@@ -171,6 +290,7 @@ int Obstacles_Board::getMoveCount()
  * 
  * Special behavior:
  *  - After a successful move, two new random traps are added.
+ *  - Clearing the last move played undoes it (including its traps).
  */
 bool Obstacles_Board::updateCell(size_t r, size_t c, char s)
 {
@@ -178,44 +298,21 @@ bool Obstacles_Board::updateCell(size_t r, size_t c, char s)
 
     if (idx >= 36) return false;
 
-    uint64_t occupied = boardX | boardO | boardTraps;
-
-    // If placing a move and it's already occupied fail.
-    if (s != 0 && (occupied & (1ULL << idx)))
-        return false;
-
     // Clearing a cell
     if (s == 0)
     {
-        uint64_t mask = ~(1ULL << idx);
-        boardX     &= mask;
-        boardO     &= mask;
-        boardTraps &= mask;
-
-        --nMoves;
-        return true;
+        if (nMoves > 0 && history[nMoves - 1].cell == idx)
+            return undoMove();
+        return false;
     }
 
-    // Placing X or O
-    if (s == 'X') boardX |= (1ULL << idx);
-    else          boardO |= (1ULL << idx);
-
-    ++nMoves;
-
-    // Add 2 new random traps
-    auto avail = getAvailableMove();
-    if (avail.size() >= 2)
-    {
-        size_t i1 = avail[rand() % avail.size()];
-        boardTraps |= (1ULL << i1);
-
-        avail.erase(std::find(avail.begin(), avail.end(), i1));
-
-        size_t i2 = avail[rand() % avail.size()];
-        boardTraps |= (1ULL << i2);
-    }
+    // Placing X or O, then 2 new random traps
+    uint64_t bit = 1ULL << idx;
+    if (!(getAvailableMask() & bit))
+        return false;
 
-    return true;
+    uint64_t before = trapRng;
+    return apply(idx, s, drawTraps(bit), before);
 }
 
 
@@ -282,13 +379,13 @@ bool Obstacles_Board::is_lose(Player<char>* player)
     is_draw()
    ============================================================ */
 /**
- * @brief Draw occurs if board is full and no one wins.
+ * @brief Draw occurs if no free cell is left and no one wins.
  */
 bool Obstacles_Board::is_draw(Player<char>* player)
 {
     return !is_win(player) &&
            !is_lose(player) &&
-           nMoves == 36;
+           getAvailableMask() == 0;
 }
 
 
@@ -313,7 +410,7 @@ Obstacles_UI::Obstacles_UI()
  *   Prompts for input.
  *
  * Computer:
- *   Selects a random available move.
+ *   Expectimax search over moves and trap placements.
  */
 Move<char>* Obstacles_UI::get_move(Player<char>* player)
 {
@@ -330,8 +427,7 @@ Move<char>* Obstacles_UI::get_move(Player<char>* player)
     }
     else if(player->get_type() == PlayerType::COMPUTER)
     {
-        Obstacles_AI ai;
-        return ai.bestMove(player, '.');
+        return ai.bestMove(player, '.', Obstacles_AI::MAX_DEPTH);
     }
 
     return new Move<char>(r, c, player->get_symbol());
@@ -381,10 +477,176 @@ void Obstacles_UI::display_board_matrix(const vector<vector<char>> &matrix) cons
     cout << endl;
 }
 
+/* ============================================================
+    Obstacles_AI
+   ============================================================ */
+Obstacles_AI::Obstacles_AI(uint64_t seed)
+    : rng(seed)
+{}
+
+
+/**
+ * @brief True if the mask contains a 4-in-a-row.
+ */
+bool Obstacles_AI::hasWin(uint64_t mask)
+{
+    const uint64_t* lines = Obstacles_Board::getWinMasks();
+    for (int i = 0; i < Obstacles_Board::WIN_MASKS; ++i)
+        if ((mask & lines[i]) == lines[i]) return true;
+    return false;
+}
+
+
+/**
+ * @brief Open lines weighted by stones (1, 10, 100), each scaled by the
+ *        chance that the next two traps miss all its free cells.
+ */
+float Obstacles_AI::expectedEval(uint64_t own, uint64_t opp, uint64_t traps)
+{
+    static const float weight[5] = { 0.0f, 1.0f, 10.0f, 100.0f, 1000.0f };
+
+    uint64_t free = Obstacles_Board::ALL_CELLS & ~(own | opp | traps);
+    int n = popcount64(free);
+    float pairs = n >= 2 ? float(n) * float(n - 1) / 2.0f : 0.0f;
+
+    const uint64_t* lines = Obstacles_Board::getWinMasks();
+    float score = 0.0f;
+
+    for (int i = 0; i < Obstacles_Board::WIN_MASKS; ++i)
+    {
+        uint64_t line = lines[i];
+        if (line & traps) continue;
+
+        int a = popcount64(line & own);
+        int b = popcount64(line & opp);
+        if (a && b) continue;               // dead line
+
+        // P(neither trap lands on this line's free cells)
+        float survive = 1.0f;
+        if (pairs > 0.0f)
+        {
+            int m = n - popcount64(line & free);
+            survive = float(m) * float(m - 1) / 2.0f / pairs;
+        }
+
+        score += survive * (weight[a] - weight[b]);
+    }
+
+    return score;
+}
+
+
+/**
+ * @brief Decision node (negamax): a completed line wins immediately,
+ *        otherwise the move is followed by a chance node.
+ */
+float Obstacles_AI::search(uint64_t own, uint64_t opp, uint64_t traps, int depth)
+{
+    uint64_t free = Obstacles_Board::ALL_CELLS & ~(own | opp | traps);
+    if (free == 0) return 0.0f;             // draw
+
+    float best = -2.0f * WIN_SCORE;
+    for (uint64_t rest = free; rest; rest &= rest - 1)
+    {
+        uint64_t bit = rest & (~rest + 1);
+        uint64_t next = own | bit;
+
+        // Faster wins score higher
+        float v = hasWin(next) ? WIN_SCORE + float(depth)
+                               : chance(next, opp, traps, depth);
+        best = std::max(best, v);
+    }
+    return best;
+}
+
+
+/**
+ * @brief Chance node after a move: exact expectation at the horizon,
+ *        sampled trap pairs above it.
+ */
+float Obstacles_AI::chance(uint64_t mover, uint64_t other, uint64_t traps, int depth)
+{
+    if (depth <= 1)
+        return expectedEval(mover, other, traps);
+
+    uint64_t free = Obstacles_Board::ALL_CELLS & ~(mover | other | traps);
+    int n = popcount64(free);
+    if (n < 2)
+        return -search(other, mover, traps, depth - 1);
+
+    float sum = 0.0f;
+    for (int s = 0; s < samples; ++s)
+    {
+        int i = int(rng() % uint64_t(n));
+        int j = int(rng() % uint64_t(n - 1));
+        uint64_t first = 1ULL << nthBit(free, i);
+        uint64_t second = 1ULL << nthBit(free & ~first, j);
+
+        sum += -search(other, mover, traps | first | second, depth - 1);
+    }
+    return sum / float(samples);
+}
+
+
+/**
+ * @brief Static value: decided games, else the expected line score.
+ */
+float Obstacles_AI::evaluate(Board<char>* b, Player<char>* player)
+{
+    auto* board = dynamic_cast<Obstacles_Board*>(b);
+    char me = player->get_symbol();
+    char them = (me == 'X') ? 'O' : 'X';
+
+    uint64_t own = board->getMask(me), opp = board->getMask(them);
+    if (hasWin(own)) return WIN_SCORE;
+    if (hasWin(opp)) return -WIN_SCORE;
+    return expectedEval(own, opp, board->getTraps());
+}
+
+
+float Obstacles_AI::minimax(bool aiTurn, Player<char>* player, float, float, char, int depth)
+{
+    auto* board = dynamic_cast<Obstacles_Board*>(player->get_board_ptr());
+    if (depth <= 0 || board->game_is_over(player))
+        return evaluate(board, player);
+
+    char me = player->get_symbol();
+    char them = (me == 'X') ? 'O' : 'X';
+    uint64_t own = board->getMask(me), opp = board->getMask(them);
+
+    float v = aiTurn ? search(own, opp, board->getTraps(), depth)
+                     : search(opp, own, board->getTraps(), depth);
+    return aiTurn ? v : -v;
+}
+
+
 Move<char> *Obstacles_AI::bestMove(Player<char> *player, char blankCell, int depth)
 {
     auto* board = dynamic_cast<Obstacles_Board*>(player->get_board_ptr());
-    auto avail = board->getAvailableMove();
-    size_t idx = avail[rand() % avail.size()];
-    return new Move<char>(idx/6, idx%6, player->get_symbol());
-}
\ No newline at end of file
+    char me = player->get_symbol();
+    char them = (me == 'X') ? 'O' : 'X';
+
+    uint64_t own = board->getMask(me), opp = board->getMask(them);
+    uint64_t traps = board->getTraps();
+    uint64_t free = board->getAvailableMask();
+    depth = std::max(1, std::min(depth, MAX_DEPTH));
+
+    int bestIdx = -1;
+    float best = -2.0f * WIN_SCORE;
+    for (uint64_t rest = free; rest; rest &= rest - 1)
+    {
+        uint64_t bit = rest & (~rest + 1);
+        uint64_t next = own | bit;
+
+        float v = hasWin(next) ? WIN_SCORE + float(depth)
+                               : chance(next, opp, traps, depth);
+        if (v > best)
+        {
+            best = v;
+            bestIdx = nthBit(bit, 0);
+        }
+    }
+
+    if (bestIdx < 0) return nullptr;          // no free cell
+    return new Move<char>(bestIdx / 6, bestIdx % 6, me);
+}
@@ -13,12 +13,18 @@
 #include "../../header/Custom_UI.h"
 #include "../../header/AI.h"
 #include <cstdint>
+#include <random>
 #include <vector>
 
 /**
  * @class Obstacles_Board
  * @brief Modified Tic-Tac-Toe board supporting traps and 64-bit bitboard logic.
  * @ingroup Obstacles_XO
+ *
+ * Every move is followed by two traps on random free cells. Traps come
+ * from a seedable generator that is part of the board state, and each move
+ * records the traps it added, so undoing a move restores both the cells
+ * and the generator exactly.
  */
 class Obstacles_Board : public Board<char>
 {
@@ -44,10 +50,50 @@ public:
 
     /**
      * @brief Get all available moves.
-     * @return Vector of valid cell indices (0–63)
+     * @return Vector of valid cell indices (0–35)
      */
     std::vector<size_t> getAvailableMove();
 
+    /**
+     * @brief Bitmask of free cells (not X, O, or trap); no allocation.
+     */
+    uint64_t getAvailableMask() const { return ALL_CELLS & ~(boardX | boardO | boardTraps); }
+
+    /**
+     * @brief Bitmask of the cells holding a symbol.
+     * @param sym 'X' or 'O'
+     */
+    uint64_t getMask(char sym) const { return sym == 'X' ? boardX : boardO; }
+
+    /** @brief Bitmask of trapped cells. */
+    uint64_t getTraps() const { return boardTraps; }
+
+    /**
+     * @brief Reseed the trap generator (same seed + same moves = same traps).
+     */
+    void setTrapSeed(uint64_t seed) { trapRng = seed; }
+
+    /**
+     * @brief Place a symbol followed by the given traps (no randomness).
+     * @param idx Cell index 6*r+c
+     * @param s 'X' or 'O'
+     * @param traps Trap cells to add (must be free after the move)
+     * @return True if the move was applied
+     */
+    bool placeMove(size_t idx, char s, uint64_t traps);
+
+    /**
+     * @brief Undo the last move and the traps it added.
+     * @return False if no move is recorded
+     */
+    bool undoMove();
+
+    /** @brief The precomputed 4-in-a-row masks (WIN_MASKS entries). */
+    static const uint64_t* getWinMasks() { return win4Masks; }
+
+    static constexpr int WIN_MASKS = 54;                       ///< Number of 4-in-a-row masks
+    static constexpr uint64_t ALL_CELLS = (1ULL << 36) - 1;    ///< All 36 cells
+
     /**
      * @brief Get the total number of moves played.
      * @return Number of moves played
@@ -58,7 +104,7 @@ public:
      * @brief Attempt to place a symbol at the given position.
      * @param r Row index (0-based)
      * @param c Column index (0-based)
-     * @param s Symbol to place ('X' or 'O')
+     * @param s Symbol to place ('X' or 'O'), or 0 to undo the move at (r, c)
      * @return True if the move was applied successfully, false otherwise
      */
     bool updateCell(size_t r, size_t c, char s);
@@ -77,6 +123,13 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /** @brief Clear the board for a new game; the trap generator keeps its state. */
+    void reset() override {
+        boardX = boardO = boardTraps = 0;
+        nMoves = n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), emptyCell);
+    }
+
     /**
      * @brief Checks if a player has won.
      * @param player Pointer to the player
@@ -99,51 +152,103 @@ public:
     bool is_draw(Player<char>* player) override;
 
 private:
+    /** @brief One played move and what it changed. */
+    struct HistoryEntry {
+        uint64_t traps;                  ///< Traps added after the move
+        uint64_t rngBefore;              ///< Trap generator state before the move
+        uint8_t cell;                    ///< Cell played
+    };
+
+    /** @brief Pick two random free cells (outside @p exclude) with the board's generator. */
+    uint64_t drawTraps(uint64_t exclude);
+
+    /** @brief Place a move and its traps, recording the generator state before it. */
+    bool apply(size_t idx, char s, uint64_t traps, uint64_t rngBefore);
+
+    /** @brief Write a symbol into the matrix at every cell of a mask. */
+    void setCells(uint64_t mask, char s);
+
     uint64_t boardX = 0;                 ///< Bitboard representing X positions
     uint64_t boardO = 0;                 ///< Bitboard representing O positions
     uint64_t boardTraps = 0;             ///< Bitboard representing traps/obstacles
     static uint64_t win4Masks[54];       ///< Precomputed 4-in-a-row winning masks
     char emptyCell;                      ///< Symbol used for empty cells
     int nMoves = 0;                      ///< Number of moves played
+    uint64_t trapRng;                    ///< Trap generator state (splitmix64)
+    HistoryEntry history[36];            ///< Moves played, for undo
 };
 
 /**
  * @class Obstacles_AI
- * @brief AI implementation for Obstacles Tic-Tac-Toe.
+ * @brief Expectimax AI for Obstacles Tic-Tac-Toe.
  * @ingroup AI
+ *
+ * Decision nodes maximize (negamax); after every move a chance node
+ * averages over the two random traps. Inner chance nodes are sampled; the
+ * last one is computed exactly: a line survives two traps among n free
+ * cells with probability C(n-e, 2) / C(n, 2), where e is its free cells.
+ * Lines are the board's win4Masks. Works on bitmasks only (no allocation).
  */
 class Obstacles_AI : public AI {
 public:
-    Obstacles_AI() = default;
+    /**
+     * @param seed Seed for chance-node sampling (random by default)
+     */
+    explicit Obstacles_AI(uint64_t seed = std::random_device{}());
 
     /**
-     * @brief Evaluation function (not implemented, placeholder).
+     * @brief Static evaluation from the player's perspective.
      * @param board Pointer to the board
      * @param player Pointer to the AI player
-     * @return Always returns 0.0f
+     * @return Weighted count of open lines, ±WIN_SCORE if the game is decided
      */
-    float evaluate(Board<char>* board, Player<char>* player) override { return 0.0f; }
+    float evaluate(Board<char>* board, Player<char>* player) override;
 
     /**
-     * @brief Minimax search (not implemented, placeholder).
+     * @brief Expectimax value of the position (alpha/beta are unused:
+     *        chance nodes average, so plain cutoffs do not apply).
      * @param aiTurn True if it is the AI's turn
      * @param player Pointer to the AI player
-     * @param alpha Alpha pruning value
-     * @param beta Beta pruning value
+     * @param alpha Unused
+     * @param beta Unused
      * @param blankCell Symbol representing empty cells
-     * @param depth Search depth
-     * @return Always returns 0.0f
+     * @param depth Search depth in moves
+     * @return Value from the AI's perspective
      */
-    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override { return 0.0f; }
+    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override;
 
     /**
      * @brief Computes the best move for the player.
      * @param player Pointer to the player
      * @param blankCell Symbol representing empty cells
-     * @param depth Search depth (default 6)
-     * @return Pointer to the selected Move<char>
+     * @param depth Search depth in moves, capped at MAX_DEPTH
+     * @return Pointer to the selected Move<char>, nullptr if no cell is free
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+    /** @brief Restart the chance-node sampler from a seed. */
+    void setSeed(uint64_t seed) { rng.seed(seed); }
+
+    /** @brief Trap pairs sampled at inner chance nodes (default 4). */
+    void setChanceSamples(int n) { samples = n < 1 ? 1 : n; }
+
+    static constexpr float WIN_SCORE = 1e6f; ///< Value of a won game
+    static constexpr int MAX_DEPTH = 3;      ///< Depth cap (chance nodes multiply the tree)
+
+private:
+    /** @brief Best value for the side to move (@p own), negamax. */
+    float search(uint64_t own, uint64_t opp, uint64_t traps, int depth);
+
+    /** @brief Value after @p mover played, averaged over trap placement. */
+    float chance(uint64_t mover, uint64_t other, uint64_t traps, int depth);
+
+    /** @brief Line evaluation for @p own, expected over the next two traps. */
+    static float expectedEval(uint64_t own, uint64_t opp, uint64_t traps);
+
+    static bool hasWin(uint64_t mask);
+
+    std::mt19937_64 rng;  ///< Chance-node sampler
+    int samples = 4;      ///< Samples per inner chance node
 };
 
 /**
@@ -176,6 +281,7 @@ public:
 
 private:
     Obstacles_Board* board = nullptr;    ///< Pointer to the associated Obstacles_Board
+    Obstacles_AI ai;                     ///< Computer player
 };
 
 #endif // OBSTACLES_TIC_TAC_TOE_H
\ No newline at end of file
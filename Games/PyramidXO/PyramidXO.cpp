@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace std;
 
@@ -11,28 +13,52 @@ using namespace std;
 // PyramidXO_Board Implementation
 // ==============================
 
+const int8_t PyramidXO_Board::SHAPE[3][5] = {
+    { -1, -1,  0, -1, -1 },
+    { -1,  1,  2,  3, -1 },
+    {  4,  5,  6,  7,  8 }
+};
+
+const int8_t PyramidXO_Board::CELLS[9][2] = {
+    {0, 2}, {1, 1}, {1, 2}, {1, 3}, {2, 0}, {2, 1}, {2, 2}, {2, 3}, {2, 4}
+};
+
+const uint16_t PyramidXO_Board::LINES[7] = {
+    0x00E, 0x070, 0x0E0, 0x1C0, // rows
+    0x045,                      // column 2
+    0x013, 0x109                // diagonals
+};
+
 PyramidXO_Board::PyramidXO_Board() : Board<char>(3, 5) {
     n_moves = 0;   // Count filled pyramid cells
 }
 
+bool PyramidXO_Board::hasLine(uint16_t mask) {
+    for (uint16_t line : LINES)
+        if ((mask & line) == line) return true;
+    return false;
+}
+
 bool PyramidXO_Board::update_board(Move<char>* move) {
     int x = move->get_x();
     int y = move->get_y();
     char symbol = move->get_symbol();
 
-    // Invalid indices
-    if (x < 0 || x >= rows || y < 0 || y >= columns) {
+    // Invalid indices or outside the pyramid
+    if (x < 0 || x >= rows || y < 0 || y >= columns || SHAPE[x][y] < 0) {
         return false;
     }
 
-    // Check pyramid-shaped playable region
-    bool valid_shape = false;
-    if (x == 0 && y == 2) valid_shape = true;
-    else if (x == 1 && (y >= 1 && y <= 3)) valid_shape = true;
-    else if (x == 2 && (y >= 0 && y <= 4)) valid_shape = true;
+    const uint16_t bit = uint16_t(1u << SHAPE[x][y]);
 
-    if (!valid_shape) {
-        return false;
+    // Undo
+    if (symbol == 0) {
+        if (board[x][y] == 0) return false;
+        maskX &= uint16_t(~bit);
+        maskO &= uint16_t(~bit);
+        board[x][y] = 0;
+        n_moves--;
+        return true;
     }
 
     // Cell already used
@@ -42,27 +68,13 @@ bool PyramidXO_Board::update_board(Move<char>* move) {
 
     // Apply move
     board[x][y] = symbol;
+    (symbol == 'X' ? maskX : maskO) |= bit;
     n_moves++;
     return true;
 }
 
 bool PyramidXO_Board::is_win(Player<char>* player) {
-    char s = player->get_symbol();
-
-    // Horizontal wins
-    if (board[1][1] == s && board[1][2] == s && board[1][3] == s) return true;
-    if (board[2][0] == s && board[2][1] == s && board[2][2] == s) return true;
-    if (board[2][1] == s && board[2][2] == s && board[2][3] == s) return true;
-    if (board[2][2] == s && board[2][3] == s && board[2][4] == s) return true;
-
-    // Vertical (only column 2 has three cells)
-    if (board[0][2] == s && board[1][2] == s && board[2][2] == s) return true;
-
-    // Diagonals
-    if (board[0][2] == s && board[1][1] == s && board[2][0] == s) return true;
-    if (board[0][2] == s && board[1][3] == s && board[2][4] == s) return true;
-
-    return false;
+    return hasLine(getMask(player->get_symbol()));
 }
 
 bool PyramidXO_Board::is_lose(Player<char>* player) {
@@ -72,7 +84,7 @@ bool PyramidXO_Board::is_lose(Player<char>* player) {
 
 bool PyramidXO_Board::is_draw(Player<char>* player) {
     // Draw when pyramid is full and no wins
-    return (n_moves == 9 && !is_win(player));
+    return (n_moves == 9 && !hasLine(maskX) && !hasLine(maskO));
 }
 
 bool PyramidXO_Board::game_is_over(Player<char>* player) {
@@ -101,8 +113,6 @@ Move<char>* PyramidXO_UI::get_move(Player<char>* player) {
         cin >> x >> y;
     }
     else {
-        // Computer generates random pyramid move
-        PyramidXO_AI ai;
         return ai.bestMove(player, 0);
     }
 
@@ -173,28 +183,109 @@ void PyramidXO_UI::display_board_matrix(const vector<vector<char>>& matrix) cons
 // PyramidXO_AI Implementation
 // ==============================
 
-Move<char>* PyramidXO_AI::bestMove(Player<char>* player, char blankCell, int depth) {
-    vector<pair<int,int>> available;
-    auto* board = player->get_board_ptr();
+PyramidXO_AI::PyramidXO_AI() : table(1 << 18) {}
+
+/**
+ * @brief Negamax alpha-beta to the end of the game
+ *
+ * @details Nobody holds a line at a node. A completing cell wins at once;
+ * two opponent threats lose next move; a single threat must be blocked.
+ * Other moves are tried busiest cell first (cell 6 lies on four lines).
+ */
+int PyramidXO_AI::search(uint16_t own, uint16_t opp, int alpha, int beta) {
+    ++nodeCount;
+
+    const uint16_t free = uint16_t(~(own | opp) & 0x1FF);
+    if (!free) return 0;
+
+    uint16_t threats = 0;
+    for (int i = 0; i < 9; i++) {
+        if (!(free >> i & 1)) continue;
+        if (PyramidXO_Board::hasLine(uint16_t(own | 1u << i))) return WIN;
+        if (PyramidXO_Board::hasLine(uint16_t(opp | 1u << i))) threats |= uint16_t(1u << i);
+    }
+    if (threats & (threats - 1)) return -(WIN - 1);
+
+    Entry& e = table[own | opp << 9];
+    if (e.bound == EXACT) return e.value;
+    if (e.bound == LOWER && e.value >= beta) return e.value;
+    if (e.bound == UPPER && e.value <= alpha) return e.value;
+
+    static const int8_t ORDER[9] = { 6, 0, 2, 5, 7, 1, 3, 4, 8 };
+    const uint16_t candidates = threats ? threats : free;
+
+    const int alpha0 = alpha;
+    int best = -WIN - 1;
+    for (int cell : ORDER) {
+        if (!(candidates >> cell & 1)) continue;
+        int value = -search(opp, uint16_t(own | 1u << cell), -beta - 1, -alpha + 1);
+        // A result one ply further away is worth one point less
+        value -= (value > 0) - (value < 0);
+        best = std::max(best, value);
+        alpha = std::max(alpha, best);
+        if (alpha >= beta) break;
+    }
 
-    // Collect all legal pyramid cells
-    for (int r = 0; r < 5; ++r) {
-        for (int c = 0; c < 5; ++c) {
-            bool valid_shape = false;
-            if (r == 0 && c == 2) valid_shape = true;
-            else if (r == 1 && (c >= 1 && c <= 3)) valid_shape = true;
-            else if (r == 2 && (c >= 0 && c <= 4)) valid_shape = true;
+    e.value = int8_t(best);
+    e.bound = best <= alpha0 ? UPPER : best >= beta ? LOWER : EXACT;
+    return best;
+}
 
-            if (!valid_shape) continue;
+int PyramidXO_AI::playValue(uint16_t own, uint16_t opp, int cell) {
+    own |= uint16_t(1u << cell);
+    if (PyramidXO_Board::hasLine(own)) return WIN;
+    int value = -search(opp, own, -WIN - 1, WIN + 1);
+    return value - ((value > 0) - (value < 0));
+}
 
-            if (board->get_cell(r,c) == 0)
-                available.push_back({r,c});
-        }
+/**
+ * @brief Solved value for the player, who is assumed to move next
+ */
+float PyramidXO_AI::evaluate(Board<char>* b, Player<char>* player) {
+    auto* board = dynamic_cast<PyramidXO_Board*>(b);
+    if (!board || !player) throw invalid_argument("Invalid board or player in evaluate()");
+
+    const char me = player->get_symbol(), opp = (me == 'X') ? 'O' : 'X';
+    if (PyramidXO_Board::hasLine(board->getMask(me))) return float(WIN);
+    if (PyramidXO_Board::hasLine(board->getMask(opp))) return float(-WIN);
+    return float(search(board->getMask(me), board->getMask(opp), -WIN - 1, WIN + 1));
+}
+
+/**
+ * @brief Solved value from the AI's point of view
+ */
+float PyramidXO_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) {
+    auto* board = dynamic_cast<PyramidXO_Board*>(player ? player->get_board_ptr() : nullptr);
+    if (!board) throw invalid_argument("Invalid board or player in minimax()");
+
+    const char me = player->get_symbol(), opp = (me == 'X') ? 'O' : 'X';
+    const uint16_t own = board->getMask(me), theirs = board->getMask(opp);
+    if (PyramidXO_Board::hasLine(own)) return float(WIN);
+    if (PyramidXO_Board::hasLine(theirs)) return float(-WIN);
+
+    if (aiTurn) return float(search(own, theirs, -WIN - 1, WIN + 1));
+    return float(-search(theirs, own, -WIN - 1, WIN + 1));
+}
+
+/**
+ * @brief Plays the cell with the best solved value
+ */
+Move<char>* PyramidXO_AI::bestMove(Player<char>* player, char blankCell, int depth) {
+    auto* board = dynamic_cast<PyramidXO_Board*>(player ? player->get_board_ptr() : nullptr);
+    if (!board) throw invalid_argument("Invalid board or player in bestMove()");
+
+    const char me = player->get_symbol(), opp = (me == 'X') ? 'O' : 'X';
+    const uint16_t own = board->getMask(me), theirs = board->getMask(opp);
+
+    int best = -WIN - 2, bestCell = -1;
+    for (int cell = 0; cell < 9; cell++) {
+        if ((own | theirs) >> cell & 1) continue;
+        int value = playValue(own, theirs, cell);
+        if (value > best) { best = value; bestCell = cell; }
     }
 
-    // Pick random move
-    int idx = rand() % available.size();
-    return new Move<char>(available[idx].first,
-                          available[idx].second,
-                          player->get_symbol());
-}
\ No newline at end of file
+    if (bestCell < 0)
+        throw runtime_error("No valid moves left for AI");
+
+    return new Move<char>(PyramidXO_Board::CELLS[bestCell][0], PyramidXO_Board::CELLS[bestCell][1], me);
+}
@@ -10,6 +10,8 @@
 
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
+#include <cstdint>
+#include <vector>
 
 /**
  * @class PyramidXO_Board
@@ -20,22 +22,38 @@
  * Row 0:        (0,2)
  * Row 1:     (1,1)(1,2)(1,3)
  * Row 2: (2,0)(2,1)(2,2)(2,3)(2,4)
+ *
+ * The nine playable cells are numbered top to bottom, left to right, and
+ * each player's marks are kept as a 9-bit mask over that numbering.
  */
 class PyramidXO_Board : public Board<char>
 {
+    uint16_t maskX = 0; ///< Cells held by X
+    uint16_t maskO = 0; ///< Cells held by O
+
 public:
+    static const int8_t SHAPE[3][5];  ///< Cell number of each matrix position, -1 outside the pyramid
+    static const int8_t CELLS[9][2];  ///< Matrix row and column of each cell number
+    static const uint16_t LINES[7];   ///< The seven three-in-a-row masks
+
     /**
      * @brief Constructs and initializes the pyramid board.
      */
     PyramidXO_Board();
 
     /**
-     * @brief Attempts to place a symbol on the board.
+     * @brief Attempts to place (or, with symbol 0, remove) a symbol.
      * @param move Pointer to the move to apply
      * @return True if the move is legal and successfully executed; false otherwise
      */
     bool update_board(Move<char>* move) override;
 
+    /** @brief Cells held by the symbol as a 9-bit mask. */
+    uint16_t getMask(char symbol) const { return symbol == 'X' ? maskX : maskO; }
+
+    /** @brief True if the mask contains one of the lines. */
+    static bool hasLine(uint16_t mask);
+
     /**
      * @brief Checks if the player has lost (not used in this game).
      * @param player Pointer to the player
@@ -63,45 +81,86 @@ public:
      * @return True if the game is over; false otherwise
      */
     bool game_is_over(Player<char>* player) override;
+
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        maskX = maskO = 0;
+        n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), 0);
+    }
 };
 
 /**
  * @class PyramidXO_AI
- * @brief Simple AI choosing a random valid empty pyramid cell.
+ * @brief Perfect-play solver for Pyramid XO.
  * @ingroup AI
+ *
+ * @details Negamax alpha-beta on the two 9-bit masks, always searched to
+ * the end of the game. Positions are memoized in a table indexed directly
+ * by (mover, opponent) masks and kept for the lifetime of the AI, so after
+ * the first move every search is a handful of lookups. Faster wins score
+ * higher.
  */
 class PyramidXO_AI : public AI {
 public:
-    PyramidXO_AI() = default;
+    PyramidXO_AI();
 
     /**
-     * @brief Evaluation function (not implemented for this game)
+     * @brief Solved value of the position for the player to move
      * @param board Pointer to the game board
      * @param player Pointer to the player
-     * @return Always returns 0.0f
+     * @return Positive if the player wins, negative if it loses, 0 for a draw
      */
-    float evaluate(Board<char>* board, Player<char>* player) override { return 0.0f; }
+    float evaluate(Board<char>* board, Player<char>* player) override;
 
     /**
-     * @brief Minimax search (not used, returns default value)
+     * @brief Solved value from the AI's point of view
      * @param aiTurn True if AI's turn; false otherwise
      * @param player Pointer to the player
      * @param alpha Alpha value for pruning
      * @param beta Beta value for pruning
      * @param blankCell Symbol representing empty cells
-     * @param depth Depth of search
-     * @return Always returns 0.0f
+     * @param depth Ignored (the game is always solved)
+     * @return Game value
      */
-    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override { return 0.0f; }
+    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override;
 
     /**
-     * @brief Generates a random valid move within the pyramid.
+     * @brief Chooses the move with the best solved value.
      * @param player Pointer to the player making the move
      * @param blankCell Symbol representing empty cells
-     * @param depth Depth of search (default 6, unused here)
+     * @param depth Ignored (the game is always solved)
      * @return Pointer to the chosen Move<char>
+     * @throws std::runtime_error if the pyramid is full
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+    /** @brief Nodes searched since construction */
+    uint64_t nodes() const { return nodeCount; }
+
+private:
+    static constexpr int WIN = 20; ///< Score of a win on this move
+
+    enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        int8_t value = 0;     ///< Score for the side to move
+        uint8_t bound = NONE; ///< Bound type of value
+    };
+
+    /**
+     * @brief Negamax alpha-beta to the end of the game
+     * @param own Cells of the side to move
+     * @param opp Cells of the other side
+     * @return Score for the side to move
+     */
+    int search(uint16_t own, uint16_t opp, int alpha, int beta);
+
+    /** @brief Score of the side to move after it plays cell (see search()). */
+    int playValue(uint16_t own, uint16_t opp, int cell);
+
+    std::vector<Entry> table; ///< Memo indexed by own | opp << 9
+    uint64_t nodeCount = 0;   ///< Node counter
 };
 
 /**
@@ -140,4 +199,7 @@ public:
      * @param matrix The full 2D board matrix (3x5)
      */
     void display_board_matrix(const std::vector<std::vector<char>>& matrix) const override;
+
+private:
+    PyramidXO_AI ai; ///< Solver kept across moves
 };
\ No newline at end of file
@@ -1,10 +1,23 @@
 #include "SUS.h"
+#include <climits>
 #include <iostream>
 
 // ==============================
 // SUS_Board Implementation
 // ==============================
 
+const int SUS_Board::POW3[10] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561, 19683 };
+
+const uint8_t SUS_Board::LINES[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+    {0, 4, 8}, {2, 4, 6}
+};
+
+const uint8_t SUS_Board::CELL_LINES[9] = {
+    0x49, 0x11, 0xA1, 0x0A, 0xD2, 0x22, 0x8C, 0x14, 0x64
+};
+
 SUS_Board::SUS_Board() : Board(3, 3) {
     // Fill all cells with blank symbol
     for (auto &row : board)
@@ -12,24 +25,24 @@ SUS_Board::SUS_Board() : Board(3, 3) {
             cell = blank_symbol;
 }
 
+int SUS_Board::completed(int state, int cell) {
+    int count = 0;
+    for (int l = 0; l < 8; l++) {
+        if (!(CELL_LINES[cell] >> l & 1)) continue;
+        const uint8_t* c = LINES[l];
+        count += state / POW3[c[0]] % 3 == 1 && state / POW3[c[1]] % 3 == 2 &&
+                 state / POW3[c[2]] % 3 == 1;
+    }
+    return count;
+}
+
 /**
- * @brief Updates player scores based on last move
+ * @brief Credits the lines through (x, y) to the placing player
  */
 void SUS_Board::score(int x, int y, char sym) {
-    // Row
-    if (board[x][0]=='S' && board[x][1]=='U' && board[x][2]=='S')
-        sym == 'S' ? s_score++ : u_score++;
-
-    // Column
-    if (board[0][y]=='S' && board[1][y]=='U' && board[2][y]=='S')
-        sym == 'S' ? s_score++ : u_score++;
-
-    // Diagonal
-    if (board[0][0]=='S' && board[1][1]=='U' && board[2][2]=='S' && (x==y))
-        sym == 'S' ? s_score++ : u_score++;
-
-    if (board[0][2]=='S' && board[1][1]=='U' && board[2][0]=='S' && (x+y==2))
-        sym == 'S' ? s_score++ : u_score++;
+    const int cell = x * 3 + y;
+    gained[cell] = completed(code, cell);
+    (sym == 'S' ? s_score : u_score) += gained[cell];
 }
 
 /**
@@ -43,12 +56,19 @@ bool SUS_Board::update_board(Move<char> *move) {
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
         (board[x][y] == blank_symbol || mark == 0)) {
 
+        const int cell = x * 3 + y;
         if (mark == 0) { // Undo
+            if (board[x][y] == blank_symbol) return false;
             n_moves--;
+            (board[x][y] == 'S' ? s_score : u_score) -= gained[cell];
+            code -= (board[x][y] == 'S' ? 1 : 2) * POW3[cell];
+            gained[cell] = 0;
             board[x][y] = blank_symbol;
         } else { // Place move
             n_moves++;
-            board[x][y] = toupper(mark);
+            board[x][y] = letter(mark);
+            code += (board[x][y] == 'S' ? 1 : 2) * POW3[cell];
+            score(x, y, board[x][y]);
         }
 
         return true;
@@ -57,13 +77,13 @@ bool SUS_Board::update_board(Move<char> *move) {
 }
 
 bool SUS_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-    return (n_moves==9 && s_score>u_score && sym=='S');
+    const char sym = letter(player->get_symbol());
+    return n_moves == 9 && (sym == 'S' ? s_score > u_score : u_score > s_score);
 }
 
 bool SUS_Board::is_lose(Player<char>* player) {
-    const char sym = player->get_symbol();
-    return (n_moves==9 && s_score<u_score && sym=='S');
+    const char sym = letter(player->get_symbol());
+    return n_moves == 9 && (sym == 'S' ? s_score < u_score : u_score < s_score);
 }
 
 bool SUS_Board::is_draw(Player<char>* player) {
@@ -71,7 +91,7 @@ bool SUS_Board::is_draw(Player<char>* player) {
 }
 
 bool SUS_Board::game_is_over(Player<char>* player) {
-    return is_win(player) || is_draw(player);
+    return n_moves == 9;
 }
 
 
@@ -130,111 +150,75 @@ Move<char>* SUS_UI::get_move(Player<char> *player) {
 // ==============================
 
 /**
- * @brief Evaluate board for a player; +10 if AI owns SUS, -10 if opponent owns
+ * @brief Margin the side to move still gains under best play
+ *
+ * @details The table holds both sides for all 3^9 codes. A placement only
+ * raises the code, so filling it from the highest code down solves every
+ * child before its parents.
  */
-float SUS_AI::evaluate(Board<char>* board, Player<char>* player) {
-    char AI = player->get_symbol();
-    int score = 0;
-
-    // Rows
-    for (int i = 0; i < 3; i++) {
-        if (board->get_cell(i, 0) == 'S' && board->get_cell(i, 1) == 'U' && board->get_cell(i, 2) == 'S') {
-            char owner = board->get_cell(i, 1);
-            score += (owner == AI) ? 10 : -10;
-        }
-    }
-
-    // Columns
-    for (int j = 0; j < 3; j++) {
-        if (board->get_cell(0, j) == 'S' && board->get_cell(1, j) == 'U' && board->get_cell(2, j) == 'S') {
-            char owner = board->get_cell(1, j);
-            score += (owner == AI) ? 10 : -10;
+int SUS_AI::solve(int state, char letter) {
+    static const vector<int8_t> table = [] {
+        vector<int8_t> t(2 * SUS_Board::POW3[9], 0);
+        for (int code = SUS_Board::POW3[9] - 1; code >= 0; code--) {
+            for (int side = 0; side < 2; side++) {
+                int best = INT_MIN;
+                for (int cell = 0; cell < 9; cell++) {
+                    if (code / SUS_Board::POW3[cell] % 3) continue;
+                    const int child = code + (side + 1) * SUS_Board::POW3[cell];
+                    best = max(best, SUS_Board::completed(child, cell) - t[2 * child + 1 - side]);
+                }
+                t[2 * code + side] = int8_t(best == INT_MIN ? 0 : best);
+            }
         }
-    }
-
-    // Diagonals
-    if (board->get_cell(0,0)=='S' && board->get_cell(1,1)=='U' && board->get_cell(2,2)=='S') {
-        char owner = board->get_cell(1,1);
-        score += (owner == AI) ? 10 : -10;
-    }
-    if (board->get_cell(0,2)=='S' && board->get_cell(1,1)=='U' && board->get_cell(2,0)=='S') {
-        char owner = board->get_cell(1,1);
-        score += (owner == AI) ? 10 : -10;
-    }
-
-    return score;
+        return t;
+    }();
+    return table[2 * state + (letter == 'U')];
 }
 
-bool SUS_AI::isMovesLeft(Board<char>* board) {
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            if (board->get_cell(i,j)=='.') return true;
-    return false;
+/**
+ * @brief Solved final score difference for the player moving next
+ */
+float SUS_AI::evaluate(Board<char>* b, Player<char>* player) {
+    auto* board = dynamic_cast<SUS_Board*>(b);
+    if (!board || !player) throw invalid_argument("Invalid board or player in evaluate()");
+
+    const char me = SUS_Board::letter(player->get_symbol()), opp = me == 'S' ? 'U' : 'S';
+    return float(board->get_score(me) - board->get_score(opp) + solve(board->getState(), me));
 }
 
 /**
- * @brief Minimax algorithm with alpha-beta pruning
+ * @brief Solved final score difference from the AI's point of view
  */
 float SUS_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) {
-    auto* board = player->get_board_ptr();
-    float score = evaluate(board, player);
-
-    if (score >= 10) return score - depth;
-    if (score <= -10) return score + depth;
-    if (!isMovesLeft(board)) return 0;
-
-    float best = aiTurn ? INT_MIN : INT_MAX;
-    char symbol = aiTurn ? player->get_symbol() : (player->get_symbol() == 'X' ? 'O' : 'X');
-
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (board->get_cell(i,j)=='.') {
-                Move<char> move(i,j,symbol);
-                board->update_board(&move);
-                float val = minimax(!aiTurn, player, alpha, beta, blankCell, depth+1);
-                best = aiTurn ? max(best,val) : min(best,val);
-                Move<char> undo(i,j,0);
-                board->update_board(&undo);
-
-                if (aiTurn) alpha = max(alpha,best);
-                else beta = min(beta,best);
-                if (beta <= alpha) break;
-            }
-        }
-        if (beta <= alpha) break;
-    }
+    auto* board = dynamic_cast<SUS_Board*>(player ? player->get_board_ptr() : nullptr);
+    if (!board) throw invalid_argument("Invalid board or player in minimax()");
 
-    return best;
+    const char me = SUS_Board::letter(player->get_symbol()), opp = me == 'S' ? 'U' : 'S';
+    const int diff = board->get_score(me) - board->get_score(opp);
+    return float(aiTurn ? diff + solve(board->getState(), me) : diff - solve(board->getState(), opp));
 }
 
 /**
- * @brief Returns the best move for AI
+ * @brief Returns the move with the best solved margin
  */
 Move<char>* SUS_AI::bestMove(Player<char>* player, char blankCell, int depth) {
-    auto* board = player->get_board_ptr();
-    char AI = player->get_symbol();
-    float bestVal = INT_MIN;
-    int bestRow = -1, bestCol = -1;
-    float alpha = INT_MIN, beta = INT_MAX;
-
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (board->get_cell(i,j)=='.') {
-                Move<char> move(i,j,AI);
-                board->update_board(&move);
-                float moveVal = minimax(false, player, alpha, beta, blankCell, 1);
-                Move<char> undo(i,j,0);
-                board->update_board(&undo);
-
-                if (moveVal > bestVal) {
-                    bestVal = moveVal;
-                    bestRow = i;
-                    bestCol = j;
-                }
-                alpha = max(alpha,bestVal);
-            }
+    auto* board = dynamic_cast<SUS_Board*>(player ? player->get_board_ptr() : nullptr);
+    if (!board) throw invalid_argument("Invalid board or player in bestMove()");
+
+    const char me = SUS_Board::letter(player->get_symbol()), opp = me == 'S' ? 'U' : 'S';
+    const int state = board->getState();
+    int bestVal = INT_MIN, bestCell = -1;
+
+    for (int cell = 0; cell < 9; cell++) {
+        if (state / SUS_Board::POW3[cell] % 3) continue;
+        const int child = state + (me == 'S' ? 1 : 2) * SUS_Board::POW3[cell];
+        const int value = SUS_Board::completed(child, cell) - solve(child, opp);
+        if (value > bestVal) {
+            bestVal = value;
+            bestCell = cell;
         }
     }
 
-    return new Move<char>(bestRow,bestCol,AI);
-}
\ No newline at end of file
+    if (bestCell < 0) return nullptr;
+    return new Move<char>(bestCell / 3, bestCell % 3, me);
+}
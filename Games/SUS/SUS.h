@@ -12,6 +12,7 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
 #include "../../header/Custom_UI.h"
+#include <cstdint>
 #include <random>
 
 using namespace std;
@@ -29,8 +30,14 @@ private:
     char blank_symbol = '.';      ///< Symbol used to denote an empty cell.
     int s_score{};                ///< Score for player using symbol 'S'.
     int u_score{};                ///< Score for player using symbol 'U'.
+    int code{};                   ///< Cells in base 3 (0 empty, 1 'S', 2 'U'), cell i at digit i.
+    int gained[9]{};              ///< Points credited by the placement on each cell.
 
 public:
+    static const int POW3[10];           ///< Powers of 3 (digit weights of the state code)
+    static const uint8_t LINES[8][3];    ///< Cells of the rows, columns and diagonals
+    static const uint8_t CELL_LINES[9];  ///< Bit l set if line l passes through the cell
+
     /**
      * @brief Constructs an empty 3x3 SUS board.
      */
@@ -38,94 +45,132 @@ public:
 
     /**
      * @brief Applies or undoes a move on the board.
-     * @param move Pointer to the move to apply
+     * @param move Pointer to the move to apply (symbol 0 undoes)
      * @return True if the board was successfully updated
+     *
+     * Scores are maintained here: placing credits the S-U-S lines the move
+     * completes, undoing takes them back.
      */
     bool update_board(Move<char>* move) override;
 
     /**
      * @brief Checks if the given player has won.
      * @param player Pointer to the player
-     * @return True if the player has won
+     * @return True if the board is full and the player scored more
      */
     bool is_win(Player<char>* player) override;
 
     /**
      * @brief Checks if the given player has lost.
      * @param player Pointer to the player
-     * @return True if the player has lost
+     * @return True if the board is full and the player scored less
      */
     bool is_lose(Player<char>* player) override;
 
     /**
      * @brief Checks if the game ended in a draw.
      * @param player Pointer to the player
-     * @return True if the game is a draw
+     * @return True if the board is full and the scores are equal
      */
     bool is_draw(Player<char>* player) override;
 
     /**
      * @brief Determines whether the game is over.
      * @param player Pointer to the player
-     * @return True if the game has ended (win or draw)
+     * @return True once all nine cells are filled
      */
     bool game_is_over(Player<char>* player) override;
 
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        s_score = u_score = code = 0;
+        std::fill(std::begin(gained), std::end(gained), 0);
+        n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), blank_symbol);
+    }
+
     /**
-     * @brief Updates scoring after a move.
+     * @brief Credits the S-U-S lines completed by a placement.
      * @param x Row index of the move
      * @param y Column index of the move
      * @param sym Symbol placed
      */
     void score(int x, int y, char sym);
+
+    /** @brief Current cells in base 3 (see code). */
+    int getState() const { return code; }
+
+    /** @brief Points scored by the given player so far. */
+    int get_score(char sym) const { return letter(sym) == 'S' ? s_score : u_score; }
+
+    /**
+     * @brief Letter played by a player symbol.
+     *
+     * The Unity wrapper seats 'X'/'O' players; X plays S and O plays U.
+     */
+    static char letter(char sym) { return (sym == 'U' || sym == 'u' || sym == 'O' || sym == 'o') ? 'U' : 'S'; }
+
+    /**
+     * @brief Number of S-U-S lines through a cell of a state code.
+     * @param state Cells in base 3
+     * @param cell Cell index (row * 3 + column)
+     */
+    static int completed(int state, int cell);
 };
 
 /**
  * @class SUS_AI
- * @brief Artificial intelligence for the SUS game using Minimax with alpha-beta pruning.
+ * @brief Perfect-play solver for the SUS game.
  * @ingroup AI
+ *
+ * @details Every one of the 3^9 cell assignments is solved once, for
+ * either side to move, into a shared table of final score margins (points
+ * the mover still gains minus points the opponent still gains under best
+ * play). Scores already on the board do not change future play, so the
+ * margin added to the current difference decides the game, and a move
+ * costs nine table lookups.
  */
 class SUS_AI : public AI {
 public:
     SUS_AI() = default;
 
     /**
-     * @brief Evaluates the board state for the given player.
+     * @brief Final score difference for the player, assuming it moves next.
      * @param board Pointer to the board
      * @param player Pointer to the player
-     * @return Evaluation score
+     * @return Own minus opponent score at the end of best play
      */
     float evaluate(Board<char>* board, Player<char>* player) override;
 
     /**
-     * @brief Minimax with alpha-beta pruning.
+     * @brief Solved final score difference from the AI's point of view.
      * @param aiTurn True if it's the AI's turn
      * @param player Pointer to the AI player
-     * @param alpha Alpha boundary
-     * @param beta Beta boundary
+     * @param alpha Ignored (the game is solved)
+     * @param beta Ignored (the game is solved)
      * @param blankCell Symbol used for empty cells
-     * @param depth Maximum recursion depth
-     * @return Resulting Minimax score
+     * @param depth Ignored (the game is solved)
+     * @return AI minus opponent score at the end of best play
      */
     float minimax(bool aiTurn, Player<char>* player,
                   float alpha, float beta,
                   char blankCell, int depth) override;
 
-    /**
-     * @brief Checks if any empty cells remain.
-     * @param board Pointer to the board
-     * @return True if there are remaining moves
-     */
-    bool isMovesLeft(Board<char>* board);
-
     /**
      * @brief Computes the best move for the player.
      * @param player Pointer to the player
      * @param blankCell Empty cell symbol
-     * @param depth Search depth (default: 9)
-     * @return Pointer to the chosen move
+     * @param depth Ignored (the game is solved)
+     * @return Pointer to the chosen move, nullptr if the board is full
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 9) override;
+
+    /**
+     * @brief Margin the side to move still gains under best play.
+     * @param state Cells in base 3 (see SUS_Board::getState)
+     * @param letter Letter of the side to move ('S' or 'U')
+     */
+    static int solve(int state, char letter);
 };
 
 /**
@@ -86,15 +86,6 @@ bool Ultimate_Board::update_board(Move<char>* move) {
         }
 
         small_board_check(x, y, mark);
-
-        // Display large board for debugging (can move to UI)
-        cout << "\nLarge Board (3x3 small board results):\n";
-        for (int i=0;i<3;i++){
-            for (int j=0;j<3;j++) cout << setw(3) << large_board[i][j] << " ";
-            cout << endl;
-        }
-        cout << endl;
-
         return true;
     }
 
@@ -169,6 +160,30 @@ void Ultimate_UI::display_board_matrix(const vector<vector<char>>& matrix) const
         else cout << "\n   " << string((cell_width + 2) * cols, '-') << "\n";
     }
     cout << endl;
+
+    if (rows != 9 || cols != 9) return;
+
+    // Small board results, derived from the matrix as Ultimate_Board does
+    auto result = [&](int bi, int bj) {
+        auto at = [&](int i, int j) { return matrix[bi * 3 + i][bj * 3 + j]; };
+        auto line = [&](char a, char b, char c) { return a == b && b == c && a != '.'; };
+        for (int i = 0; i < 3; ++i) {
+            if (line(at(i, 0), at(i, 1), at(i, 2))) return at(i, 0);
+            if (line(at(0, i), at(1, i), at(2, i))) return at(0, i);
+        }
+        if (line(at(0, 0), at(1, 1), at(2, 2)) || line(at(0, 2), at(1, 1), at(2, 0))) return at(1, 1);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                if (at(i, j) == '.') return '.';
+        return '#';
+    };
+
+    cout << "Large Board (3x3 small board results):\n";
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) cout << setw(3) << result(i, j) << " ";
+        cout << endl;
+    }
+    cout << endl;
 }
 
 /**
@@ -199,11 +214,16 @@ Move<char>* Ultimate_AI::bestMove(Player<char>* player, char blankCell, int dept
     vector<pair<int,int>> available;
     auto* board = player->get_board_ptr();
 
+    auto* ultimate = dynamic_cast<Ultimate_Board*>(board);
+    if (!ultimate) throw invalid_argument("Invalid board or player in bestMove()");
+
     for (int r = 0; r < 9; ++r)
         for (int c = 0; c < 9; ++c)
-            if (board->get_cell(r,c) == blankCell)
+            if (board->get_cell(r,c) == blankCell && ultimate->is_playable(r, c))
                 available.push_back({r,c});
 
-    int idx = rand() % available.size();
+    if (available.empty()) return nullptr;
+
+    size_t idx = rng() % available.size();
     return new Move<char>(available[idx].first, available[idx].second, player->get_symbol());
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
+#include <cstdint>
+#include <random>
 
 using namespace std;
 
@@ -72,6 +74,16 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        small_board = 0;
+        full = true;
+        win = false;
+        n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), blank_symbol);
+        for (auto& row : large_board) std::fill(row.begin(), row.end(), blank_symbol);
+    }
+
     /**
      * @brief Evaluates the small board corresponding to the last move.
      * @param x Row of the last move.
@@ -85,6 +97,9 @@ public:
      * @return True if every small board is won or drawn.
      */
     bool all_small_boards_done();
+
+    /** @brief True if (x, y) lies in a small board that is still open. */
+    bool is_playable(int x, int y) const { return large_board[x / 3][y / 3] == blank_symbol; }
 };
 
 /**
@@ -94,7 +109,13 @@ public:
  */
 class Ultimate_AI : public AI {
 public:
-    Ultimate_AI() = default;
+    /**
+     * @param seed Seed for the move choice (random by default)
+     */
+    explicit Ultimate_AI(uint64_t seed = random_device{}()) : rng(seed) {}
+
+    /** @brief Restart the move generator from a seed. */
+    void setSeed(uint64_t seed) { rng.seed(seed); }
 
     /**
      * @brief Evaluates the board state (placeholder, returns 0.0).
@@ -129,6 +150,9 @@ public:
      * @return Pointer to the chosen Move<char>.
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+private:
+    mt19937_64 rng; ///< Move generator
 };
 
 /**
@@ -0,0 +1,374 @@
+#include "Word_Dictionary.h"
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr char          Word_Dictionary::MAGIC[4];
+constexpr std::uint32_t Word_Dictionary::VERSION;
+constexpr std::uint32_t Word_Dictionary::TERMINAL;
+constexpr std::uint32_t Word_Dictionary::ENDIAN_MARK;
+
+namespace {
+
+/** Letter index 0..25, or -1 */
+int letter(char ch) {
+    ch = char(std::toupper(static_cast<unsigned char>(ch)));
+    return (ch >= 'A' && ch <= 'Z') ? ch - 'A' : -1;
+}
+
+std::uint32_t children(std::uint32_t mask) {
+    return std::uint32_t(std::bitset<26>(mask & 0x3FFFFFFu).count());
+}
+
+/*--------------------------------------------------------------
+ | Builder: trie -> merged nodes -> shared child blocks
+ *-------------------------------------------------------------*/
+
+struct TrieNode {
+    std::uint32_t mask = 0;
+    std::vector<int> child; ///< Trie node per set bit, in letter order
+};
+
+class Builder {
+public:
+    explicit Builder(const std::vector<std::string>& sorted) {
+        trie_.emplace_back();
+        for (const auto& w : sorted) insert(w);
+    }
+
+    std::vector<Word_Dictionary::Node> layout(std::uint32_t& root) {
+        // Merge equal subtrees bottom-up (DAWG)
+        canon_.assign(trie_.size(), -1);
+        const int rootId = canonical(0);
+
+        records_.clear();
+        blocks_.clear();
+        root = place({ rootId });
+        return std::move(records_);
+    }
+
+private:
+    void insert(const std::string& w) {
+        int n = 0;
+        for (char ch : w) {
+            const int k = ch - 'A';
+            TrieNode& node = trie_[n];
+            const std::uint32_t bit = 1u << k;
+            const int slot = int(children(node.mask & (bit - 1)));
+            if (!(node.mask & bit)) {
+                const int next = int(trie_.size());
+                trie_[n].mask |= bit;
+                trie_[n].child.insert(trie_[n].child.begin() + slot, next);
+                trie_.emplace_back();
+            }
+            n = trie_[n].child[slot];
+        }
+        trie_[n].mask |= Word_Dictionary::TERMINAL;
+    }
+
+    /** Canonical id of a trie node: equal (mask, children) share one id. */
+    int canonical(int n) {
+        if (canon_[n] >= 0) return canon_[n];
+        std::vector<int> sig{ int(trie_[n].mask) };
+        for (int c : trie_[n].child) sig.push_back(canonical(c));
+
+        auto it = ids_.find(sig);
+        if (it == ids_.end()) {
+            it = ids_.emplace(sig, int(unique_.size())).first;
+            unique_.push_back(sig);
+        }
+        return canon_[n] = it->second;
+    }
+
+    /** Offset of a child block, emitting it (and its descendants) once. */
+    std::uint32_t place(const std::vector<int>& block) {
+        auto it = blocks_.find(block);
+        if (it != blocks_.end()) return it->second;
+
+        const std::uint32_t offset = std::uint32_t(records_.size());
+        blocks_.emplace(block, offset);
+        records_.resize(records_.size() + block.size());
+
+        for (size_t i = 0; i < block.size(); i++) {
+            const std::vector<int>& sig = unique_[block[i]];
+            const std::vector<int> kids(sig.begin() + 1, sig.end());
+            const std::uint32_t first = kids.empty() ? 0 : place(kids);
+            records_[offset + i] = { std::uint32_t(sig[0]), first };
+        }
+        return offset;
+    }
+
+    std::vector<TrieNode> trie_;
+    std::vector<int> canon_;
+    std::map<std::vector<int>, int> ids_;
+    std::vector<std::vector<int>> unique_;     ///< Signature per canonical id
+    std::map<std::vector<int>, std::uint32_t> blocks_;
+    std::vector<Word_Dictionary::Node> records_;
+};
+
+} // namespace
+
+/*--------------------------------------------------------------
+ | Construction
+ *-------------------------------------------------------------*/
+
+Word_Dictionary::Word_Dictionary() : owned_(1, Node{ 0, 0 }) {
+    std::memcpy(header_.magic, MAGIC, sizeof(MAGIC));
+    header_.version = VERSION;
+    header_.endian = ENDIAN_MARK;
+    header_.nodeCount = 1;
+    nodes_ = owned_.data();
+}
+
+Word_Dictionary::Word_Dictionary(const std::string& filename) {
+    if (is_compiled(filename)) {
+        if (map_file(filename)) {
+            try {
+                check_header(filename, mappedSize_);
+                validate(filename);
+            }
+            catch (...) {
+                unmap(); // the destructor does not run for a throwing constructor
+                throw;
+            }
+            return;
+        }
+
+        // No mapping available: read the records instead, checking the
+        // header against the file size before allocating
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        const std::streamoff fileSize = in.tellg();
+        in.seekg(0);
+        if (fileSize < 0 || !in.read(reinterpret_cast<char*>(&header_), sizeof(header_)))
+            throw std::runtime_error("Word_Dictionary: " + filename + " is truncated");
+        check_header(filename, std::size_t(fileSize));
+        owned_.resize(header_.nodeCount);
+        if (!in.read(reinterpret_cast<char*>(owned_.data()), std::streamsize(owned_.size() * sizeof(Node))))
+            throw std::runtime_error("Word_Dictionary: " + filename + " is truncated");
+        nodes_ = owned_.data();
+        validate(filename);
+        return;
+    }
+
+    std::ifstream in(filename);
+    if (!in) throw std::runtime_error("Can't Find \"" + filename + "\"");
+
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word) words.push_back(word);
+    *this = from_words(std::move(words));
+}
+
+Word_Dictionary::~Word_Dictionary() {
+    unmap();
+}
+
+Word_Dictionary::Word_Dictionary(Word_Dictionary&& other) noexcept {
+    *this = std::move(other);
+}
+
+Word_Dictionary& Word_Dictionary::operator=(Word_Dictionary&& other) noexcept {
+    if (this == &other) return *this;
+    unmap();
+
+    header_ = other.header_;
+    owned_ = std::move(other.owned_);
+    mapping_ = other.mapping_;
+    mappedSize_ = other.mappedSize_;
+#ifdef _WIN32
+    fileHandle_ = other.fileHandle_;
+    mapHandle_ = other.mapHandle_;
+    other.fileHandle_ = other.mapHandle_ = nullptr;
+#endif
+    nodes_ = mapping_ ? other.nodes_ : owned_.data();
+
+    other.mapping_ = nullptr;
+    other.mappedSize_ = 0;
+    other.owned_.assign(1, Node{ 0, 0 });
+    other.nodes_ = other.owned_.data();
+    other.header_.nodeCount = 1;
+    other.header_.wordCount = other.header_.root = 0;
+    other.header_.minLength = other.header_.maxLength = 0;
+    return *this;
+}
+
+Word_Dictionary Word_Dictionary::from_words(std::vector<std::string> words) {
+    // Uppercase, drop entries with non-letters, sort and dedupe
+    size_t kept = 0;
+    for (auto& w : words) {
+        bool ok = !w.empty();
+        for (char& ch : w) {
+            const int k = letter(ch);
+            if (k < 0) { ok = false; break; }
+            ch = char('A' + k);
+        }
+        if (!ok) continue;
+        if (&words[kept] != &w) words[kept] = std::move(w);
+        ++kept;
+    }
+    words.resize(kept);
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    Word_Dictionary dict;
+    std::uint32_t root = 0;
+    dict.owned_ = Builder(words).layout(root);
+    dict.nodes_ = dict.owned_.data();
+    dict.header_.nodeCount = std::uint32_t(dict.owned_.size());
+    dict.header_.wordCount = std::uint32_t(words.size());
+    dict.header_.root = root;
+
+    size_t shortest = SIZE_MAX, longest = 0;
+    for (const auto& w : words) {
+        shortest = std::min(shortest, w.size());
+        longest = std::max(longest, w.size());
+    }
+    dict.header_.minLength = std::uint16_t(words.empty() ? 0 : shortest);
+    dict.header_.maxLength = std::uint16_t(longest);
+    return dict;
+}
+
+bool Word_Dictionary::is_compiled(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4] = {};
+    if (!in.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+void Word_Dictionary::save(const std::string& filename) const {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Word_Dictionary: cannot create " + filename);
+    out.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    out.write(reinterpret_cast<const char*>(nodes_), std::streamsize(header_.nodeCount * sizeof(Node)));
+    if (!out) throw std::runtime_error("Word_Dictionary: failed writing " + filename);
+}
+
+/*--------------------------------------------------------------
+ | Lookup
+ *-------------------------------------------------------------*/
+
+bool Word_Dictionary::contains(const char* word, std::size_t len) const {
+    if (len == 0) return false;
+    const Node* node = nodes_ + header_.root;
+    for (std::size_t i = 0; i < len; i++) {
+        const int k = letter(word[i]);
+        if (k < 0 || !(node->mask >> k & 1)) return false;
+        node = nodes_ + node->first + children(node->mask & ((1u << k) - 1));
+    }
+    return (node->mask & TERMINAL) != 0;
+}
+
+void Word_Dictionary::for_each_word(std::size_t length, const std::function<void(const std::string&)>& visit) const {
+    if (length == 0) return;
+    std::string word(length, 'A');
+
+    // Depth is bounded by length, so a corrupt file cannot loop forever
+    std::function<void(std::uint32_t, std::size_t)> walk = [&](std::uint32_t n, std::size_t depth) {
+        const Node& node = nodes_[n];
+        if (depth == length) {
+            if (node.mask & TERMINAL) visit(word);
+            return;
+        }
+        std::uint32_t child = node.first;
+        for (int k = 0; k < 26; k++) {
+            if (!(node.mask >> k & 1)) continue;
+            word[depth] = char('A' + k);
+            walk(child++, depth + 1);
+        }
+    };
+    walk(header_.root, 0);
+}
+
+/*--------------------------------------------------------------
+ | File mapping
+ *-------------------------------------------------------------*/
+
+bool Word_Dictionary::map_file(const std::string& filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < LONGLONG(sizeof(WordDictHeader))) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!map) { CloseHandle(file); return false; }
+    void* view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(map); CloseHandle(file); return false; }
+    fileHandle_ = file;
+    mapHandle_ = map;
+    mapping_ = view;
+    mappedSize_ = std::size_t(size.QuadPart);
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < off_t(sizeof(WordDictHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* view = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    mapping_ = view;
+    mappedSize_ = std::size_t(st.st_size);
+#endif
+
+    std::memcpy(&header_, mapping_, sizeof(header_));
+    nodes_ = reinterpret_cast<const Node*>(static_cast<const char*>(mapping_) + sizeof(WordDictHeader));
+    return true;
+}
+
+void Word_Dictionary::unmap() {
+    if (!mapping_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(mapping_);
+    CloseHandle(HANDLE(mapHandle_));
+    CloseHandle(HANDLE(fileHandle_));
+    mapHandle_ = fileHandle_ = nullptr;
+#else
+    ::munmap(mapping_, mappedSize_);
+#endif
+    mapping_ = nullptr;
+    mappedSize_ = 0;
+}
+
+void Word_Dictionary::check_header(const std::string& name, std::size_t fileSize) const {
+    if (std::memcmp(header_.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("Word_Dictionary: " + name + " is not a dictionary file");
+    if (header_.endian == 0x04030201u)
+        throw std::runtime_error("Word_Dictionary: " + name + " was built with the other byte order; rebuild it");
+    if (header_.version != VERSION || header_.endian != ENDIAN_MARK)
+        throw std::runtime_error("Word_Dictionary: unsupported version in " + name);
+    if (header_.nodeCount == 0 || header_.root >= header_.nodeCount)
+        throw std::runtime_error("Word_Dictionary: bad node count in " + name);
+    if (fileSize < sizeof(WordDictHeader) ||
+        (fileSize - sizeof(WordDictHeader)) / sizeof(Node) < header_.nodeCount)
+        throw std::runtime_error("Word_Dictionary: " + name + " is truncated");
+}
+
+void Word_Dictionary::validate(const std::string& name) const {
+    // Every child block must lie inside the node array
+    for (std::uint32_t i = 0; i < header_.nodeCount; i++) {
+        const Node& n = nodes_[i];
+        if (n.mask & 0x7C000000u)
+            throw std::runtime_error("Word_Dictionary: corrupt node in " + name);
+        if (std::uint64_t(n.first) + children(n.mask) > header_.nodeCount)
+            throw std::runtime_error("Word_Dictionary: corrupt node in " + name);
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file Word_Dictionary.h
+ * @brief Compact, memory-mapped word dictionaries for the word games.
+ *
+ * @ingroup Word_XO
+ *
+ * A dictionary is a minimized trie (DAWG) over the letters A-Z. Compiled
+ * dictionaries (".wdic", see tools/build_dictionary.cpp) are memory-mapped,
+ * so opening a 100k-word list costs one validation pass over the node
+ * array instead of parsing and sorting text. Plain word lists are still
+ * accepted and compiled in memory.
+ *
+ * File layout (native byte order of the machine that built the file, so
+ * the node array can be mapped without conversion):
+ *  - WordDictHeader (32 bytes): magic "WDAW", version, node count, word
+ *    count, shortest/longest word length, root node index, byte-order mark
+ *  - nodes: uint32 mask (bit k = child for letter 'A'+k, bit 31 = a word
+ *    ends here), uint32 index of the first child
+ *
+ * Children of a node are stored contiguously in letter order, so the child
+ * for letter k is at first + popcount(mask & ((1 << k) - 1)). Identical
+ * child blocks are stored once, which merges shared suffixes.
+ *
+ * The loader rejects files whose byte-order mark does not read as
+ * ENDIAN_MARK; rebuild them from the word list on the target machine.
+ */
+
+#ifndef WORD_DICTIONARY_H
+#define WORD_DICTIONARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @struct WordDictHeader
+ * @brief Fixed-size header of a compiled dictionary.
+ */
+struct WordDictHeader {
+    char          magic[4];   ///< "WDAW"
+    std::uint32_t version;    ///< Format version
+    std::uint32_t nodeCount;  ///< Node records following the header
+    std::uint32_t wordCount;  ///< Distinct words
+    std::uint16_t minLength;  ///< Shortest word
+    std::uint16_t maxLength;  ///< Longest word
+    std::uint32_t root;       ///< Index of the root node
+    std::uint32_t endian;     ///< Word_Dictionary::ENDIAN_MARK in the writer's byte order
+    std::uint8_t  reserved[4];///< Zero
+};
+
+static_assert(sizeof(WordDictHeader) == 32, "WordDictHeader must be 32 bytes");
+
+/**
+ * @class Word_Dictionary
+ * @ingroup Word_XO
+ * @brief Read-only word set with O(length) lookups.
+ *
+ * Words are case-insensitive; anything that is not a letter makes a word
+ * unknown. Moving is allowed, copying is not (a dictionary may own a file
+ * mapping).
+ */
+class Word_Dictionary {
+public:
+    /** @brief Node record as stored in the file. */
+    struct Node {
+        std::uint32_t mask;  ///< Child letters (bits 0-25), terminal flag (bit 31)
+        std::uint32_t first; ///< Index of the first child
+    };
+
+    static constexpr char          MAGIC[4] = { 'W', 'D', 'A', 'W' };
+    static constexpr std::uint32_t VERSION  = 2;
+    static constexpr std::uint32_t TERMINAL = 0x80000000u;
+    static constexpr std::uint32_t ENDIAN_MARK = 0x01020304u;
+
+    /** @brief Empty dictionary. */
+    Word_Dictionary();
+
+    /**
+     * @brief Open a compiled dictionary or a plain word list.
+     * @param filename Path to a .wdic file or a whitespace-separated list
+     * @throws std::runtime_error if the file is missing or malformed
+     */
+    explicit Word_Dictionary(const std::string& filename);
+
+    ~Word_Dictionary();
+
+    Word_Dictionary(Word_Dictionary&& other) noexcept;
+    Word_Dictionary& operator=(Word_Dictionary&& other) noexcept;
+    Word_Dictionary(const Word_Dictionary&) = delete;
+    Word_Dictionary& operator=(const Word_Dictionary&) = delete;
+
+    /**
+     * @brief Build a dictionary from words in memory.
+     * @param words Words in any case; entries with non-letters are skipped
+     */
+    static Word_Dictionary from_words(std::vector<std::string> words);
+
+    /** @brief True if the file starts with the compiled-dictionary magic. */
+    static bool is_compiled(const std::string& filename);
+
+    /**
+     * @brief Write the dictionary in the compiled format.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename) const;
+
+    /** @brief Check a word of len characters. */
+    bool contains(const char* word, std::size_t len) const;
+
+    /** @brief Check a word. */
+    bool contains(const std::string& word) const { return contains(word.data(), word.size()); }
+
+    /**
+     * @brief Visit every word of one length in alphabetical order.
+     * @param length Word length
+     * @param visit Called with each word (uppercase)
+     */
+    void for_each_word(std::size_t length, const std::function<void(const std::string&)>& visit) const;
+
+    /** @brief Number of words. */
+    std::size_t size() const { return header_.wordCount; }
+
+    /** @brief Number of node records. */
+    std::size_t node_count() const { return header_.nodeCount; }
+
+    /** @brief Shortest word length (0 if empty). */
+    int min_length() const { return header_.minLength; }
+
+    /** @brief Longest word length (0 if empty). */
+    int max_length() const { return header_.maxLength; }
+
+private:
+    /** @brief Map a compiled file; false if mapping is unavailable. */
+    bool map_file(const std::string& filename);
+
+    /** @brief Release the mapping, if any. */
+    void unmap();
+
+    /**
+     * @brief Check magic, byte order, version and node count, and that the
+     *        node array fits in a file of fileSize bytes.
+     */
+    void check_header(const std::string& name, std::size_t fileSize) const;
+
+    /** @brief Check every child reference. */
+    void validate(const std::string& name) const;
+
+    WordDictHeader header_{};
+    const Node* nodes_ = nullptr;   ///< Mapped or owned node array
+    std::vector<Node> owned_;       ///< Storage when not mapped
+
+    void* mapping_ = nullptr;       ///< Start of the mapped file
+    std::size_t mappedSize_ = 0;    ///< Bytes mapped
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;    ///< Windows file handle
+    void* mapHandle_ = nullptr;     ///< Windows mapping handle
+#endif
+};
+
+#endif // WORD_DICTIONARY_H
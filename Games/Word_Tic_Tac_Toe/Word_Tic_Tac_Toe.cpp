@@ -2,11 +2,10 @@
 #include <iostream>
 #include <random>
 #include <cstdint>
-#include <set>
-#include <fstream>
+#include <cctype>
 #include <tuple>
 #include <algorithm>
-#include <random>
+#include <climits>
 
 // ============================================================================
 // Static Member Initialization
@@ -15,17 +14,32 @@
 /**
  * @brief Dictionary of valid words (forward) for the Word Tic-Tac-Toe board.
  */
-std::set<std::string> Word_XO_Board::dict;
+std::bitset<Word_XO_Board::WORD_SPACE> Word_XO_Board::words;
+
+/**
+ * @brief Words readable in either direction, for line checks.
+ */
+std::bitset<Word_XO_Board::WORD_SPACE> Word_XO_Board::lineWords;
+
+/**
+ * @brief Set once a dictionary has been compiled into the tables.
+ */
+bool Word_XO_Board::dictionaryLoaded = false;
 
 /**
- * @brief Dictionary of valid words in reverse for the Word Tic-Tac-Toe board.
+ * @brief Dictionary loaded by the first board if none was chosen.
  */
-std::set<std::string> Word_XO_Board::revDict;
+std::string Word_XO_Board::defaultDictionary = "dic.txt";
 
 /**
- * @brief Precomputed scoring table for AI heuristics on each board position.
+ * @brief Completing-letter masks per gap position and letter pair.
  */
-std::vector<std::pair<int, char>> Word_XO_UI::score[3][3];
+uint32_t Word_XO_Board::completers[3][26][26];
+
+/**
+ * @brief Letter pairs that leave a completable gap, per line positions.
+ */
+uint32_t Word_XO_Board::pairThreats[3][3][26];
 
 // ============================================================================
 // Word_XO_Board Implementation
@@ -34,28 +48,92 @@ std::vector<std::pair<int, char>> Word_XO_UI::score[3][3];
 /**
  * @brief Constructs a new Word_XO_Board object.
  *
- * @details Initializes a 3x3 board with empty cells and loads the dictionary
- * from "dic.txt" if not already loaded. Also stores reversed words for AI use.
+ * @details Initializes a 3x3 board with empty cells and loads the default
+ * dictionary ("dic.txt") if no dictionary has been loaded yet.
  * Throws a runtime exception if the dictionary file is missing.
  */
 Word_XO_Board::Word_XO_Board() : Board(3, 3), emptyCell('.')
 { 
-    if(dict.empty()) {
-        std::ifstream in("dic.txt");
-        if (in.fail()) throw std::runtime_error("Can't Find \"dic.txt\"");
-        std::string word;
-        while(in >> word) {
-            dict.insert(word);
-            std::reverse(word.begin(), word.end());
-            revDict.insert(word);
-        }
-    }
+    if(!dictionaryLoaded)
+        load_dictionary(defaultDictionary);
 
     for (auto &row : board)
         for (auto &cell : row)
             cell = emptyCell;
 }
 
+int Word_XO_Board::word_index(char a, char b, char c)
+{
+    if (a < 'A' || a > 'Z' || b < 'A' || b > 'Z' || c < 'A' || c > 'Z') return -1;
+    return (a - 'A') * 676 + (b - 'A') * 26 + (c - 'A');
+}
+
+bool Word_XO_Board::is_word(char a, char b, char c)
+{
+    int idx = word_index(a, b, c);
+    return idx >= 0 && words[idx];
+}
+
+bool Word_XO_Board::is_line_word(char a, char b, char c)
+{
+    int idx = word_index(a, b, c);
+    return idx >= 0 && lineWords[idx];
+}
+
+uint32_t Word_XO_Board::completing_letters(char a, char b, char c)
+{
+    auto letter = [](char ch) { return ch >= 'A' && ch <= 'Z'; };
+    const bool la = letter(a), lb = letter(b), lc = letter(c);
+    if (la + lb + lc != 2) return 0;
+    if (!la) return completers[0][b - 'A'][c - 'A'];
+    if (!lb) return completers[1][a - 'A'][c - 'A'];
+    return completers[2][a - 'A'][b - 'A'];
+}
+
+void Word_XO_Board::load_dictionary(const std::string& filename)
+{
+    use_dictionary(Word_Dictionary(filename));
+}
+
+/**
+ * @brief Compiles the 3-letter words of a dictionary into the forward and
+ * either-direction bitsets and the completing-letter masks.
+ */
+void Word_XO_Board::use_dictionary(const Word_Dictionary& dict)
+{
+    words.reset();
+    lineWords.reset();
+    std::fill(&completers[0][0][0], &completers[0][0][0] + 3 * 26 * 26, 0u);
+    std::fill(&pairThreats[0][0][0], &pairThreats[0][0][0] + 3 * 3 * 26, 0u);
+
+    dict.for_each_word(3, [](const std::string& word) {
+        words.set(word_index(word[0], word[1], word[2]));
+        lineWords.set(word_index(word[0], word[1], word[2]));
+        lineWords.set(word_index(word[2], word[1], word[0]));
+    });
+
+    for (int idx = 0; idx < WORD_SPACE; ++idx) {
+        if (!lineWords[idx]) continue;
+        const int a = idx / 676, b = idx / 26 % 26, c = idx % 26;
+        completers[0][b][c] |= 1u << a;
+        completers[1][a][c] |= 1u << b;
+        completers[2][a][b] |= 1u << c;
+    }
+
+    for (int p = 0; p < 3; ++p)
+        for (int q = 0; q < 3; ++q) {
+            if (p == q) continue;
+            const int gap = 3 - p - q;
+            for (int x = 0; x < 26; ++x)
+                for (int y = 0; y < 26; ++y) {
+                    const uint32_t mask = p < q ? completers[gap][x][y] : completers[gap][y][x];
+                    if (mask) pairThreats[p][q][x] |= 1u << y;
+                }
+        }
+
+    dictionaryLoaded = true;
+}
+
 /**
  * @brief Returns the symbol representing an empty cell.
  * @return The empty cell character ('.').
@@ -77,49 +155,17 @@ int Word_XO_Board::getMoveCount()
 /**
  * @brief Checks if any valid word exists on the current board.
  *
- * @details Scans all rows, columns, and diagonals for words in `dict` or `revDict`.
+ * @details Tests all rows, columns, and diagonals against `lineWords`.
  * @return True if a valid word is found, otherwise false.
  */
 bool Word_XO_Board::wordExist()
 {
-    std::string word;
-    bool isFound = false;
-
-    // Horizontal
-    for(int r = 0; r < 3; ++r) {
-        word.clear();
-        word.push_back(board[r][0]);
-        word.push_back(board[r][1]);
-        word.push_back(board[r][2]);
-        isFound |= (dict.find(word) != dict.end());
-        isFound |= (revDict.find(word) != revDict.end());
+    for(int i = 0; i < 3; ++i) {
+        if (is_line_word(board[i][0], board[i][1], board[i][2])) return true; // Horizontal
+        if (is_line_word(board[0][i], board[1][i], board[2][i])) return true; // Vertical
     }
-
-    // Vertical
-    for(int c = 0; c < 3; ++c) {
-        word.clear();
-        word.push_back(board[0][c]);
-        word.push_back(board[1][c]);
-        word.push_back(board[2][c]);
-        isFound |= (dict.find(word) != dict.end());
-        isFound |= (revDict.find(word) != revDict.end());
-    }
-
-    // Diagonal
-    word.clear();
-    for(int rc = 0; rc < 3; ++rc)
-        word.push_back(board[rc][rc]); 
-    isFound |= (dict.find(word) != dict.end());
-    isFound |= (revDict.find(word) != revDict.end());
-
-    // Anti-diagonal
-    word.clear();
-    for(int rc = 0; rc < 3; ++rc)
-        word.push_back(board[rc][2 - rc]); 
-    isFound |= (dict.find(word) != dict.end());
-    isFound |= (revDict.find(word) != revDict.end());
-
-    return isFound;
+    return is_line_word(board[0][0], board[1][1], board[2][2])    // Diagonal
+        || is_line_word(board[0][2], board[1][1], board[2][0]);   // Anti-diagonal
 }
 
 /**
@@ -201,17 +247,10 @@ bool Word_XO_Board::is_draw(Player<char> *player)
 // ============================================================================
 
 /**
- * @brief Constructs a new UI object and precomputes AI scores.
+ * @brief Constructs a new UI object.
  */
 Word_XO_UI::Word_XO_UI() : Custom_UI<char>("Word Tic Tac Toe"s, 5)
 {
-    if (score[0][0].empty()) {
-        for(int r = 0; r < 3; ++r) {
-            for(int c = 0; c < 3; ++c) {
-                score[r][c] = evaluate(r, c);
-            }
-        }
-    }
 }
 
 /**
@@ -268,148 +307,309 @@ Move<char> *Word_XO_UI::get_move(Player<char> *player)
         sym = rand() % 26 + 'A';
     } 
     else if (player->get_type() == PlayerType::AI) {
-        Word_AI AI;
         dynamic_cast<Word_XO_Board*>(player->get_board_ptr())->setLastPlayer(player);
-        return AI.bestMove(player, '.');
+        return ai.bestMove(player, '.');
     }
 
     dynamic_cast<Word_XO_Board*>(player->get_board_ptr())->setLastPlayer(player);
     return new Move<char>(r, c, sym);
 }
 
+// ============================================================================
+// Word_AI Implementation
+// ============================================================================
+
+namespace {
+
+const int LINES[8][3] = {
+    {0,1,2}, {3,4,5}, {6,7,8}, {0,3,6}, {1,4,7}, {2,5,8}, {0,4,8}, {2,4,6}
+};
+
+const uint8_t SYM[8][9] = {
+    {0,1,2,3,4,5,6,7,8}, {2,5,8,1,4,7,0,3,6}, {8,7,6,5,4,3,2,1,0}, {6,3,0,7,4,1,8,5,2},
+    {2,1,0,5,4,3,8,7,6}, {6,7,8,3,4,5,0,1,2}, {0,3,6,1,4,7,2,5,8}, {8,5,2,7,4,1,6,3,0}
+};
+
+/// Lines through each cell, with the cell's position in the line
+struct CellLines {
+    int count = 0;
+    int line[4], pos[4];
+};
+
+const CellLines* cellLines() {
+    static const auto table = [] {
+        std::vector<CellLines> t(9);
+        for (int l = 0; l < 8; ++l)
+            for (int p = 0; p < 3; ++p) {
+                CellLines& cl = t[LINES[l][p]];
+                cl.line[cl.count] = l;
+                cl.pos[cl.count++] = p;
+            }
+        return t;
+    }();
+    return table.data();
+}
+
+} // namespace
+
+Word_AI::Word_AI() : table(1 << 18) {}
+
+bool Word_AI::canComplete(const uint8_t cells[9])
+{
+    for (const auto& line : LINES) {
+        const uint8_t a = cells[line[0]], b = cells[line[1]], c = cells[line[2]];
+        if ((a != 0) + (b != 0) + (c != 0) != 2) continue;
+        const uint32_t mask = !a ? Word_XO_Board::completers[0][b - 1][c - 1]
+                            : !b ? Word_XO_Board::completers[1][a - 1][c - 1]
+                                 : Word_XO_Board::completers[2][a - 1][b - 1];
+        if (mask) return true;
+    }
+    return false;
+}
+
 /**
- * @brief Evaluates the potential score of each character for a given cell.
- *
- * @param r Row index of cell.
- * @param c Column index of cell.
- * @return Vector of pairs {score, character} sorted descending.
+ * @details Per empty cell: letters that would give the opponent a
+ * completion come from lines through the cell holding exactly one other
+ * letter, one pairThreats lookup each. Of the remaining letters, those
+ * whose pairThreats rows agree on every line through the cell whose other
+ * cells are both empty lead to equivalent games, so one represents them.
  */
-std::vector<std::pair<int, char>> Word_XO_UI::evaluate(size_t r, size_t c)
+int Word_AI::generate(const uint8_t cells[9], Candidate* out)
 {
-    std::vector<std::pair<int, char>> ret;
-    int posType = ((r == 1 && c == 1) ? 1 : ((r == 0 || r == 2) && (c == 0 || c == 2)) ? 0 : 2);
-
-    for(char ch = 'A'; ch <= 'Z'; ++ch) {
-        std::set<char> s1, s2;
-        for(auto& word : Word_XO_Board::dict) {
-            if(word[posType] != ch) continue;
-            int temp = 0;
-            for(int k = 0; k < 3; ++k) {
-                if(k == posType) continue;
-                if(temp == 0) s1.insert(word[k]);
-                else s2.insert(word[k]);
-                ++temp;
+    const CellLines* lines = cellLines();
+    int n = 0;
+
+    for (int i = 0; i < 9; ++i) {
+        if (cells[i]) continue;
+        const CellLines& cl = lines[i];
+
+        uint32_t unsafe = 0;
+        int open[4][2], openCount = 0; // (position, other position) pairs on open lines
+        for (int k = 0; k < cl.count; ++k) {
+            const int* line = LINES[cl.line[k]];
+            const int p = cl.pos[k];
+            int filled = 0, q = -1;
+            for (int j = 0; j < 3; ++j)
+                if (j != p && cells[line[j]]) { ++filled; q = j; }
+            if (filled == 1)
+                unsafe |= Word_XO_Board::pairThreats[q][p][cells[line[q]] - 1];
+            else if (filled == 0) {
+                open[openCount][0] = p;
+                open[openCount++][1] = (p == 0) ? 1 : 0;
+            }
+        }
+
+        uint32_t seen[26][8];
+        int kinds = 0;
+        for (int ch = 0; ch < 26; ++ch) {
+            if (unsafe >> ch & 1) continue;
+
+            uint32_t sig[8];
+            for (int k = 0; k < openCount; ++k) {
+                const int p = open[k][0], q1 = open[k][1], q2 = 3 - p - q1;
+                sig[2 * k]     = Word_XO_Board::pairThreats[p][q1][ch];
+                sig[2 * k + 1] = Word_XO_Board::pairThreats[p][q2][ch];
             }
+
+            bool duplicate = false;
+            for (int s = 0; s < kinds && !duplicate; ++s)
+                duplicate = std::equal(sig, sig + 2 * openCount, seen[s]);
+            if (duplicate) continue;
+
+            std::copy(sig, sig + 2 * openCount, seen[kinds++]);
+            out[n++] = { uint8_t(i), uint8_t(ch) };
+        }
+    }
+    return n;
+}
+
+uint64_t Word_AI::canonical(const uint8_t cells[9], int& sym)
+{
+    uint64_t best = UINT64_MAX;
+    for (int s = 0; s < 8; ++s) {
+        uint64_t image = 0;
+        for (int i = 0; i < 9; ++i)
+            image = image << 5 | cells[SYM[s][i]];
+        if (image < best) { best = image; sym = s; }
+    }
+    return best;
+}
+
+/**
+ * @brief Negamax alpha-beta with a transposition table.
+ *
+ * @details Wins n plies ahead score WIN - n; non-terminal leaves score 0.
+ * A position without safe moves is lost: every placement hands the
+ * opponent a completion.
+ */
+int Word_AI::search(uint8_t cells[9], int empties, int alpha, int beta, int depth)
+{
+    ++nodeCount;
+    if (nodeLimit ? nodeCount >= nodeLimit
+                  : (nodeCount & 1023) == 0 && std::chrono::steady_clock::now() > deadline)
+        aborted = true;
+    if (aborted) return 0;
+
+    if (canComplete(cells)) return WIN;
+    if (empties == 0 || depth == 0) return 0;
+
+    int sym = 0;
+    const uint64_t key = canonical(cells, sym) + 1;
+    Entry& e = table[(key * 0x9E3779B97F4A7C15ull) >> 46];
+    int hint = -1;
+    if (e.key == key) {
+        if (e.depth >= depth) {
+            if (e.bound == EXACT) return e.value;
+            if (e.bound == LOWER && e.value >= beta) return e.value;
+            if (e.bound == UPPER && e.value <= alpha) return e.value;
         }
-        ret.push_back({s1.size() + s2.size(), ch});
+        if (e.move != 0xFF) hint = SYM[sym][e.move / 26] * 26 + e.move % 26;
+    }
+
+    Candidate moves[9 * 26];
+    const int n = generate(cells, moves);
+    if (n == 0) return -(WIN - 1);
+
+    // TT move first
+    for (int i = 0; i < n; ++i)
+        if (moves[i].cell * 26 + moves[i].letter == hint) { std::swap(moves[0], moves[i]); break; }
+
+    const int alpha0 = alpha;
+    int best = -WIN - 1, bestMove = 0;
+    for (int i = 0; i < n && best < beta; ++i) {
+        cells[moves[i].cell] = uint8_t(moves[i].letter + 1);
+        int value = -search(cells, empties - 1, -beta - 1, -alpha + 1, depth - 1);
+        cells[moves[i].cell] = 0;
+        if (aborted) return 0;
+
+        value -= (value > 0) - (value < 0);
+        if (value > best) { best = value; bestMove = i; }
+        alpha = std::max(alpha, best);
+    }
+
+    // Store the move in the canonical frame
+    int canonCell = 0;
+    while (SYM[sym][canonCell] != moves[bestMove].cell) ++canonCell;
+
+    e.key = key;
+    e.value = int8_t(best);
+    e.depth = int8_t(depth);
+    e.bound = best <= alpha0 ? UPPER : best >= beta ? LOWER : EXACT;
+    e.move = uint8_t(canonCell * 26 + moves[bestMove].letter);
+    return best;
+}
+
+/**
+ * @brief Scores a finished board for a player.
+ */
+float Word_AI::evaluate(Board<char>* board, Player<char>* player)
+{
+    auto* b = dynamic_cast<Word_XO_Board*>(board);
+    if (!b || !player) throw std::invalid_argument("Invalid board or player in evaluate()");
+
+    if (b->is_win(player)) return float(WIN);
+    if (b->is_lose(player)) return float(-WIN);
+    return 0.0f;
+}
+
+/**
+ * @brief Depth-limited search from the current board (no time budget).
+ */
+float Word_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth)
+{
+    auto* b = dynamic_cast<Word_XO_Board*>(player->get_board_ptr());
+    if (!b) throw std::invalid_argument("Invalid board in minimax()");
+
+    uint8_t cells[9];
+    int empties = 0;
+    for (int i = 0; i < 9; ++i) {
+        char ch = b->get_cell(i / 3, i % 3);
+        cells[i] = (ch >= 'A' && ch <= 'Z') ? uint8_t(ch - 'A' + 1) : 0;
+        empties += !cells[i];
     }
-    std::sort(ret.rbegin(), ret.rend());
-    return ret;
+
+    aborted = false;
+    nodeLimit = 0;
+    deadline = std::chrono::steady_clock::time_point::max();
+    const int value = search(cells, empties, -WIN - 1, WIN + 1, depth);
+    return float(aiTurn ? value : -value);
 }
 
 /**
- * @brief Determines the best AI move for a given player using heuristics.
+ * @brief Determines the best AI move by iterative deepening within the
+ * time (or node) budget.
  *
  * @param player Pointer to player.
  * @param blankCell Character representing empty cells.
- * @param depth Depth for minimax (unused in current implementation).
+ * @param depth Ignored (see class description).
  * @return Pointer to the best Move.
  */
 Move<char> *Word_AI::bestMove(Player<char> *player, char blankCell, int depth)
 {
     Word_XO_Board* board = dynamic_cast<Word_XO_Board*>(player->get_board_ptr());
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    if(board->getMoveCount() == 0) {
-        int topCount = std::max(1, (int)(Word_XO_UI::score[1][1].size() * 0.3));
-        std::uniform_int_distribution<int> dis(0, topCount - 1);
-        return new Move<char> (1, 1, Word_XO_UI::score[1][1][dis(gen)].second);
+    if (!board) throw std::invalid_argument("Invalid board in bestMove()");
+
+    uint8_t cells[9];
+    int empties = 0;
+    for (int i = 0; i < 9; ++i) {
+        char ch = board->get_cell(i / 3, i % 3);
+        cells[i] = (ch >= 'A' && ch <= 'Z') ? uint8_t(ch - 'A' + 1) : 0;
+        empties += !cells[i];
     }
-
-    std::vector<std::vector<std::pair<int, int>>> lines = {
-        {{0,0},{0,1},{0,2}}, {{1,0},{1,1},{1,2}}, {{2,0},{2,1},{2,2}},
-        {{0,0},{1,0},{2,0}}, {{0,1},{1,1},{2,1}}, {{0,2},{1,2},{2,2}},
-        {{0,0},{1,1},{2,2}}, {{0,2},{1,1},{2,0}}
-    };
-
-    auto check_line_for_word = [&](std::vector<std::pair<int,int>> line) -> std::tuple<int,int,char> {
-        int emptyR=-1, emptyC=-1, filledCount=0;
-        for(const auto& coord : line) {
-            if(board->get_cell(coord.first,coord.second)==board->getEmptyCell()) {
-                emptyR=coord.first; emptyC=coord.second;
-            } else ++filledCount;
-        }
-        if(filledCount==2) {
-            for(char sym='A'; sym<='Z'; ++sym) {
-                std::string temp_word;
-                for(const auto& coord: line)
-                    temp_word.push_back((coord.first==emptyR && coord.second==emptyC)?sym:board->get_cell(coord.first,coord.second));
-                if(Word_XO_Board::dict.find(temp_word)!=Word_XO_Board::dict.end() ||
-                   Word_XO_Board::revDict.find(temp_word)!=Word_XO_Board::revDict.end())
-                    return {emptyR,emptyC,sym};
-            }
-        }
-        return {-1,-1,0};
-    };
-
-    std::vector<std::tuple<int,int,char>> winningMoves;
-    for(const auto& line: lines) {
-        auto m = check_line_for_word(line);
-        if(std::get<0>(m)!=-1) winningMoves.push_back(m);
-    }
-    if(!winningMoves.empty()) {
-        std::uniform_int_distribution<int> dis(0, winningMoves.size()-1);
-        auto [r,c,ch]=winningMoves[dis(gen)];
-        return new Move<char>(r,c,ch);
+    if (empties == 0) throw std::runtime_error("No valid moves left for AI");
+
+    // Complete a word if possible
+    for (const auto& line : LINES) {
+        const uint32_t mask = Word_XO_Board::completing_letters(
+            board->get_cell(line[0] / 3, line[0] % 3),
+            board->get_cell(line[1] / 3, line[1] % 3),
+            board->get_cell(line[2] / 3, line[2] % 3));
+        if (!mask) continue;
+        int gap = line[0];
+        for (int k : line) if (!cells[k]) gap = k;
+        int letter = 0;
+        while (!(mask >> letter & 1)) ++letter;
+        return new Move<char>(gap / 3, gap % 3, char('A' + letter));
     }
 
-    std::vector<std::pair<int,int>> emptyCells;
-    for(int r=0;r<3;++r)
-        for(int c=0;c<3;++c)
-            if(board->get_cell(r,c)==board->getEmptyCell())
-                emptyCells.push_back({r,c});
-
-    std::vector<std::pair<int,int>> safeMoves;
-    for(const auto& cell: emptyCells) {
-        int r=cell.first, c=cell.second; bool isSafe=true;
-        for(char ch='A'; ch<='Z' && isSafe; ++ch) {
-            Move<char> tempMove(r,c,ch); board->update_board(&tempMove);
-            for(const auto& line: lines) {
-                auto threat = check_line_for_word(line);
-                if(std::get<0>(threat)!=-1) { isSafe=false; break; }
-            }
-            Move<char> undoMove(r,c,0); board->update_board(&undoMove);
-        }
-        if(isSafe) safeMoves.push_back({r,c});
-    }
-    if(!safeMoves.empty()) {
-        int i = std::rand() % safeMoves.size();
-        int r = safeMoves[i].first, c = safeMoves[i].second;
-        int topCount = std::max(1,(int)(Word_XO_UI::score[r][c].size()*0.3));
-        std::uniform_int_distribution<int> dis(0,topCount-1);
-        return new Move<char>(r,c,Word_XO_UI::score[r][c][dis(gen)].second);
+    Candidate moves[9 * 26];
+    const int n = generate(cells, moves);
+    if (n == 0) {
+        // Every placement loses; fill the first empty cell
+        int i = 0;
+        while (cells[i]) ++i;
+        return new Move<char>(i / 3, i % 3, 'A');
     }
 
-    std::vector<std::tuple<int,int,char>> blockMoves;
-    for(const auto& [r,c]: emptyCells) {
-        for(char ch='A'; ch<='Z'; ++ch) {
-            Move<char> tempMove(r,c,ch); board->update_board(&tempMove);
-            bool blocksOpponent=true;
-            for(const auto& line: lines) {
-                auto opp = check_line_for_word(line);
-                if(std::get<0>(opp)!=-1) blocksOpponent=false;
-            }
-            Move<char> undoMove(r,c,0); board->update_board(&undoMove);
-            if(blocksOpponent) blockMoves.push_back({r,c,ch});
+    aborted = false;
+    nodeLimit = nodeBudget ? nodeCount + nodeBudget : 0;
+    deadline = nodeBudget ? std::chrono::steady_clock::time_point::max()
+                          : std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+
+    Candidate best = moves[0];
+    for (int d = 1; d <= empties; ++d) {
+        int alpha = -WIN - 1, bestValue = -WIN - 1;
+        Candidate iterBest = best;
+
+        // Previous best first
+        for (int i = 0; i < n; ++i)
+            if (moves[i].cell == best.cell && moves[i].letter == best.letter) { std::swap(moves[0], moves[i]); break; }
+
+        for (int i = 0; i < n; ++i) {
+            cells[moves[i].cell] = uint8_t(moves[i].letter + 1);
+            int value = -search(cells, empties - 1, -WIN - 1, -alpha + 1, d - 1);
+            cells[moves[i].cell] = 0;
+            if (aborted) break;
+
+            value -= (value > 0) - (value < 0);
+            if (value > bestValue) { bestValue = value; iterBest = moves[i]; }
+            alpha = std::max(alpha, bestValue);
         }
-    }
-    if(!blockMoves.empty()) {
-        std::uniform_int_distribution<int> dis(0,blockMoves.size()-1);
-        int idx = dis(gen);
-        return new Move<char>(std::get<0>(blockMoves[idx]), std::get<1>(blockMoves[idx]), std::get<2>(blockMoves[idx]));
+        if (aborted) break;
+
+        best = iterBest;
+        if (bestValue != 0) break; // leaves score 0, so any other value is proven
     }
 
-    std::uniform_int_distribution<int> dis('A','Z');
-    return new Move<char>(emptyCells[0].first, emptyCells[0].second,(char)dis(gen));
-}
\ No newline at end of file
+    return new Move<char>(best.cell / 3, best.cell % 3, char('A' + best.letter));
+}
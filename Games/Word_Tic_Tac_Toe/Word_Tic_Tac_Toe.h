@@ -4,6 +4,7 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/Custom_UI.h"
 #include "../../header/AI.h"
+#include "Word_Dictionary.h"
 
 /**
  * @file Word_Tic_Tac_Toe.h
@@ -13,7 +14,10 @@
  * @brief Classes for the Word-based Tic-Tac-Toe variant.
  */
 
-#include <set>
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -72,6 +76,13 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        nMoves = n_moves = 0;
+        lastPlayer = nullptr;
+        for (auto& row : board) std::fill(row.begin(), row.end(), emptyCell);
+    }
+
     /**
      * @brief Check if a player has won.
      * @param player Player to check.
@@ -93,16 +104,75 @@ public:
      */
     bool is_draw(Player<char>* player) override;
 
-    /// @brief Forward dictionary of valid words.
-    static std::set<std::string> dict;
+    /// @brief Number of 3-letter strings (26^3).
+    static constexpr int WORD_SPACE = 26 * 26 * 26;
 
-    /// @brief Reversed dictionary of valid words.
-    static std::set<std::string> revDict;
+    /**
+     * @brief Bit index of a 3-letter string.
+     * @return (a-'A')*676 + (b-'A')*26 + (c-'A'), or -1 if any character is not A-Z.
+     */
+    static int word_index(char a, char b, char c);
+
+    /**
+     * @brief Check whether a 3-letter string is in the dictionary.
+     * @return True if "abc" is a word.
+     */
+    static bool is_word(char a, char b, char c);
+
+    /**
+     * @brief Check whether a line reads as a word in either direction.
+     * @return True if "abc" or "cba" is a word.
+     */
+    static bool is_line_word(char a, char b, char c);
+
+    /**
+     * @brief Letters that complete a line with one empty cell.
+     * @details Exactly one of a, b, c must be a non-letter (the gap); the
+     * result has bit k set if putting 'A'+k there makes a word in either
+     * direction. Lines without exactly one gap give 0.
+     * @return 26-bit letter mask.
+     */
+    static uint32_t completing_letters(char a, char b, char c);
+
+    /**
+     * @brief Load a dictionary for all boards.
+     * @details Accepts a compiled dictionary (memory-mapped, see
+     * Word_Dictionary.h) or a plain word list; only 3-letter words are used.
+     * Call before constructing boards to play with a themed dictionary.
+     * @param filename Dictionary path.
+     * @throws std::runtime_error if the file is missing or malformed.
+     */
+    static void load_dictionary(const std::string& filename);
+
+    /**
+     * @brief Use the 3-letter words of an open dictionary.
+     * @param dict Dictionary; it is not referenced afterwards.
+     */
+    static void use_dictionary(const Word_Dictionary& dict);
+
+    /// @brief Dictionary the first board loads if none was loaded before.
+    static std::string defaultDictionary;
+
+    /// @brief Dictionary: bit word_index(a,b,c) set if "abc" is a word.
+    static std::bitset<WORD_SPACE> words;
+
+    /// @brief Bit word_index(a,b,c) set if "abc" or "cba" is a word.
+    static std::bitset<WORD_SPACE> lineWords;
+
+    /// @brief completers[gap][x][y]: letters completing a line whose other
+    /// two cells hold x then y (see completing_letters).
+    static uint32_t completers[3][26][26];
+
+    /// @brief pairThreats[p][q][x]: letters y such that x at line position p
+    /// and y at position q leave a gap some letter completes.
+    static uint32_t pairThreats[3][3][26];
 
 private:
+    static bool dictionaryLoaded;  ///< True once a dictionary is in the tables.
+
     int nMoves = 0;                ///< Number of moves made.
     char emptyCell;                ///< Symbol for empty cell.
-    Player<char>* lastPlayer;      ///< Pointer to last player.
+    Player<char>* lastPlayer = nullptr; ///< Pointer to last player.
 };
 
 // ============================================================================
@@ -112,44 +182,115 @@ private:
 /**
  * @class Word_AI
  * @ingroup AI
- * @brief AI engine for Word Tic-Tac-Toe.
+ * @brief Game-tree solver for Word Tic-Tac-Toe.
  *
- * @details Provides evaluation, minimax search with alpha-beta pruning,
- * and best-move computation.
+ * @details Iterative-deepening negamax with alpha-beta and a transposition
+ * table keyed by the canonical (dihedral) board; lines read both ways, so
+ * all 8 symmetries preserve the game. A position with a completable line
+ * is won for the side to move. Letters that would hand the opponent a
+ * completion are never searched (if nothing else is left the position is
+ * lost), and safe letters with the same effect on the open lines through
+ * their cell are searched once. Deepening stops when the game is solved or
+ * the time (or node) budget runs out; the last completed iteration's move
+ * is played.
  */
 class Word_AI : public AI {
 public:
-    Word_AI() = default;
+    Word_AI();
 
     /**
      * @brief Evaluate the board for a player.
      * @param board Pointer to the game board.
      * @param player Player being evaluated.
-     * @return Heuristic score.
+     * @return WIN if the player won, -WIN if they lost, 0 otherwise.
      */
-    float evaluate(Board<char>* board, Player<char>* player) override { return 0.0f; }
+    float evaluate(Board<char>* board, Player<char>* player) override;
 
     /**
-     * @brief Minimax search with alpha-beta pruning.
+     * @brief Negamax search with alpha-beta pruning from the current board.
      * @param aiTurn True if AI's turn.
      * @param player Player being evaluated.
      * @param alpha Alpha value for pruning.
      * @param beta Beta value for pruning.
      * @param blankCell Symbol representing empty cell.
      * @param depth Depth of search.
-     * @return Evaluation score.
+     * @return Score for the AI (faster wins score higher).
      */
     float minimax(bool aiTurn, Player<char>* player,
-                  float alpha, float beta, char blankCell, int depth) override { return 0.0f; }
+                  float alpha, float beta, char blankCell, int depth) override;
 
     /**
      * @brief Compute the best move for a player.
      * @param player Player requesting move.
      * @param blankCell Symbol representing empty cells.
-     * @param depth Depth of search (default 6).
+     * @param depth Ignored; the search deepens to the end of the game or
+     *        until the time (or node) budget runs out.
      * @return Pointer to the optimal Move<char>.
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+    /**
+     * @brief Set the thinking time per move.
+     * @param ms Budget in milliseconds (default 1000).
+     */
+    void setTimeBudget(int ms) { budgetMs = ms; }
+
+    /**
+     * @brief Limit each move by nodes instead of time, so the same position
+     *        gets the same move on any machine and under any load.
+     * @param n Nodes per move (0 = use the time budget, the default).
+     */
+    void setNodeBudget(uint64_t n) { nodeBudget = n; }
+
+    /** @brief Forget the transposition table, e.g. before a new game. */
+    void clearTable() { std::fill(table.begin(), table.end(), Entry()); }
+
+    /** @brief Nodes searched since construction. */
+    uint64_t nodes() const { return nodeCount; }
+
+    static constexpr int WIN = 100; ///< Score of a win on the next placement
+
+private:
+    enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        uint64_t key = 0;     ///< Canonical board + 1
+        int8_t value = 0;     ///< Score for the side to move
+        int8_t depth = -1;    ///< Remaining depth searched
+        uint8_t bound = NONE; ///< Bound type of value
+        uint8_t move = 0xFF;  ///< Best move in the canonical frame (cell*26+letter)
+    };
+
+    /// @brief Cell and letter (0..25) of a candidate move.
+    struct Candidate { uint8_t cell, letter; };
+
+    /**
+     * @brief Safe, de-duplicated moves of a position.
+     * @param cells Cell letters 1..26, 0 for empty.
+     * @param out Receives at most 9*26 moves.
+     * @return Number of moves.
+     */
+    static int generate(const uint8_t cells[9], Candidate* out);
+
+    /** @brief True if some line has one gap and a completing letter. */
+    static bool canComplete(const uint8_t cells[9]);
+
+    /** @brief Canonical key and the symmetry that produced it. */
+    static uint64_t canonical(const uint8_t cells[9], int& sym);
+
+    /**
+     * @brief Negamax alpha-beta.
+     * @return Score for the side to move (0 if the search was aborted).
+     */
+    int search(uint8_t cells[9], int empties, int alpha, int beta, int depth);
+
+    std::vector<Entry> table;   ///< Transposition table (replace always)
+    uint64_t nodeCount = 0;     ///< Node counter
+    int budgetMs = 1000;        ///< Time budget per move
+    uint64_t nodeBudget = 0;    ///< Node budget per move (0 = time budget)
+    uint64_t nodeLimit = 0;     ///< nodeCount at which the current move stops (0 = none)
+    bool aborted = false;       ///< Set when the budget runs out
+    std::chrono::steady_clock::time_point deadline; ///< End of the current budget
 };
 
 // ============================================================================
@@ -178,16 +319,8 @@ public:
      */
     Move<char>* get_move(Player<char>* player) override;
 
-    /**
-     * @brief Evaluate potential characters for a board position.
-     * @param r Row index.
-     * @param c Column index.
-     * @return Vector of (score, character) pairs for AI evaluation.
-     */
-    std::vector<std::pair<int, char>> evaluate(size_t r, size_t c);
-
-    /// @brief Precomputed scoring tables for AI heuristics.
-    static std::vector<std::pair<int, char>> score[3][3];
+private:
+    Word_AI ai; ///< Keeps its transposition table across moves
 };
 
 #endif // WORD_TIC_TAC_TOE_H
\ No newline at end of file
@@ -2,13 +2,44 @@
 #include <iomanip>
 #include <limits>
 #include <cctype>  // for toupper()
-#include <queue>
-#include <deque>
-#include <stack>
+#include <algorithm>
 #include "XO_inf.h"
 
 using namespace std;
 
+//--------------------------------------- XO_inf_State Implementation
+
+void XO_inf_State::play(int idx, char mark) {
+    (mark == 'X' ? x : o) |= uint16_t(1u << idx);
+    cells[(head + size) % 9] = uint8_t(idx);
+    ++size;
+
+    // Every third move the oldest mark on the board disappears
+    if (++moves % 3 == 0) {
+        const uint16_t old = uint16_t(~(1u << cells[head]));
+        x &= old;
+        o &= old;
+        head = uint8_t((head + 1) % 9);
+        --size;
+    }
+}
+
+uint64_t XO_inf_State::key() const {
+    // Cells oldest first (4 bits each), then which of them are X; moves % 6
+    // fixes both the side to move and the removal phase.
+    uint64_t k = 0;
+    for (int i = 0; i < size; ++i)
+        k = (k << 4) | cells[(head + i) % 9];
+    return (k << 18) | (uint64_t(x) << 9) | (uint64_t(size) << 3) | (moves % 6);
+}
+
+bool XO_inf_State::hasLine(uint16_t mask) {
+    static const uint16_t lines[8] = { 0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124 };
+    for (uint16_t line : lines)
+        if ((mask & line) == line) return true;
+    return false;
+}
+
 //--------------------------------------- XO_inf_Board Implementation
 
 /**
@@ -18,9 +49,14 @@ using namespace std;
  * Initializes a 3x3 board with all cells set to the blank symbol.
  */
 XO_inf_Board::XO_inf_Board() : Board(3, 3) {
-    for (auto& row : board)
-        for (auto& cell : row)
-            cell = blank_symbol;
+    undoHistory.reserve(16);
+    syncMatrix();
+}
+
+void XO_inf_Board::syncMatrix() {
+    for (int i = 0; i < 9; ++i)
+        board[i / 3][i % 3] = (state.x >> i & 1) ? 'X' : (state.o >> i & 1) ? 'O' : blank_symbol;
+    n_moves = state.moves;
 }
 
 /**
@@ -33,13 +69,11 @@ XO_inf_Board::XO_inf_Board() : Board(3, 3) {
  * @details
  * - For normal moves (`mark != 0`):
  *   - Validates cell coordinates and occupancy.
- *   - Updates the board and history.
- *   - Increments move counter `cnt` modulo 3.
- *   - Every third move, oldest move is pushed to `undoHistory`.
+ *   - Saves the current state, then places the mark; every third move the
+ *     oldest mark is removed.
  * - For undo moves (`mark == 0`):
- *   - Decrements move counter and resets cell.
- *   - Restores move from `undoHistory` if needed.
- *   - Updates `cnt` modulo 3.
+ *   - Restores the state saved before the last move, including any mark
+ *     that move removed.
  */
 bool XO_inf_Board::update_board(Move<char>* move) {
     int x = move->get_x();
@@ -49,34 +83,17 @@ bool XO_inf_Board::update_board(Move<char>* move) {
     if (x < 0 || x >= rows || y < 0 || y >= columns || (board[x][y] != blank_symbol && mark != 0))
         return false;
 
-   
-
     if (mark == 0) { // Undo move
-        --n_moves;
-        board[x][y] = blank_symbol;
-        history.pop_back();
-        if(cnt == 0 && !undoHistory.empty() ) {
-            history.push_front(undoHistory.top());
-            board[undoHistory.top().x][undoHistory.top().y] = undoHistory.top().symbol;
-            undoHistory.pop();
-        }
-        cnt = (cnt - 1 + 3) % 3;
-        return true;
+        if (undoHistory.empty()) return false;
+        state = undoHistory.back();
+        undoHistory.pop_back();
     }
-
-    // Apply normal move
-    board[x][y] = mark;
-    ++n_moves;
-    history.push_back({x, y, mark});
-    ++cnt;
-    cnt %= 3;
-
-    if (cnt == 0 && !history.empty()) {
-        undoHistory.push(history.front());
-        board[history.front().x][history.front().y] = blank_symbol;
-        history.pop_front();
+    else {
+        undoHistory.push_back(state);
+        state.play(x * 3 + y, mark);
     }
 
+    syncMatrix();
     return true;
 }
 
@@ -87,25 +104,7 @@ bool XO_inf_Board::update_board(Move<char>* move) {
  * @return True if the player has a winning line; false otherwise.
  */
 bool XO_inf_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
-
-    return false;
+    return XO_inf_State::hasLine(player->get_symbol() == 'X' ? state.x : state.o);
 }
 
 /**
@@ -115,7 +114,7 @@ bool XO_inf_Board::is_win(Player<char>* player) {
  * @return True if all cells are filled and no player has won.
  */
 bool XO_inf_Board::is_draw(Player<char>* player) {
-    return (n_moves == 9 && !is_win(player));
+    return state.empty() == 0 && !XO_inf_State::hasLine(state.x) && !XO_inf_State::hasLine(state.o);
 }
 
 /**
@@ -130,6 +129,8 @@ bool XO_inf_Board::game_is_over(Player<char>* player) {
 
 //--------------------------------------- XO_inf_AI Implementation
 
+XO_inf_AI::XO_inf_AI() : table(1 << 16) {}
+
 /**
  * @brief Evaluate the board from AI perspective.
  *
@@ -148,7 +149,86 @@ float XO_inf_AI::evaluate(Board<char>* b, Player<char>* player)
 }
 
 /**
- * @brief Minimax algorithm with alpha-beta pruning.
+ * @brief Negamax search with alpha-beta pruning and a transposition table.
+ *
+ * @details
+ * The side to move has no line (the game would be over), so a node is
+ * terminal only when the board is full. Moves are tried TT move first,
+ * then wins, then blocks, then centre, corners, edges. A win n plies
+ * ahead scores WIN - n; non-terminal leaves score 0.
+ */
+int XO_inf_AI::search(const XO_inf_State& s, char mark, int alpha, int beta, int depth, int& move)
+{
+    ++nodeCount;
+    move = -1;
+
+    const uint16_t free = s.empty();
+    if (free == 0 || depth == 0) return 0;
+
+    const uint64_t key = s.key() << 1 | (mark == 'X');
+    Entry& e = table[(key * 0x9E3779B97F4A7C15ull) >> 48];
+    if (e.key == key && e.bound != NONE) {
+        move = e.move;
+        if (e.depth >= depth) {
+            if (e.bound == EXACT) return e.value;
+            if (e.bound == LOWER && e.value >= beta) return e.value;
+            if (e.bound == UPPER && e.value <= alpha) return e.value;
+        }
+    }
+
+    // Order moves: TT move, wins, blocks, then centre/corners/edges
+    static const int8_t byCell[9] = { 2, 1, 2, 1, 3, 1, 2, 1, 2 };
+    const char opp = (mark == 'X') ? 'O' : 'X';
+    const uint16_t own = (mark == 'X') ? s.x : s.o, theirs = (mark == 'X') ? s.o : s.x;
+
+    int moves[9], keys[9], n = 0;
+    for (int i = 0; i < 9; ++i) {
+        if (!(free >> i & 1)) continue;
+        int k = byCell[i];
+        if (XO_inf_State::hasLine(uint16_t(theirs | 1u << i))) k += 10;
+        if (XO_inf_State::hasLine(uint16_t(own | 1u << i)))    k += 20;
+        if (i == move) k += 100;
+        moves[n] = i;
+        keys[n++] = k;
+    }
+    for (int i = 1; i < n; ++i)
+        for (int j = i; j > 0 && keys[j] > keys[j - 1]; --j) {
+            std::swap(keys[j], keys[j - 1]);
+            std::swap(moves[j], moves[j - 1]);
+        }
+
+    const int alpha0 = alpha;
+    int best = -WIN - 1, bestMove = moves[0];
+    for (int i = 0; i < n; ++i) {
+        XO_inf_State next = s;
+        next.play(moves[i], mark);
+
+        int value, reply;
+        if (XO_inf_State::hasLine(mark == 'X' ? next.x : next.o))
+            value = WIN;
+        else {
+            value = -search(next, opp, -beta - 1, -alpha + 1, depth - 1, reply);
+            // A result one ply further away is worth one point less
+            value -= (value > 0) - (value < 0);
+        }
+
+        if (value > best) { best = value; bestMove = moves[i]; }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    e.key = key;
+    e.value = int8_t(best);
+    e.depth = int8_t(depth);
+    e.move = int8_t(bestMove);
+    e.bound = best <= alpha0 ? UPPER : best >= beta ? LOWER : EXACT;
+
+    move = bestMove;
+    return best;
+}
+
+/**
+ * @brief Minimax value of the current position for the AI player.
  *
  * @param aiTurn True if it's AI's turn.
  * @param player Pointer to the AI player.
@@ -156,41 +236,22 @@ float XO_inf_AI::evaluate(Board<char>* b, Player<char>* player)
  * @param beta Beta value for pruning.
  * @param blankCell Symbol representing an empty cell.
  * @param depth Maximum recursion depth.
- * @return Best minimax score from the current board position.
+ * @return Score from the AI's point of view (see search()).
  */
 float XO_inf_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth)
 {
     auto* board = dynamic_cast<XO_inf_Board*>(player->get_board_ptr());
     if (!board || !player) throw invalid_argument("Invalid board or player in minimax()");
 
-    float score = evaluate(board, player);
-    if (score == 10 || score == -10 || board->is_draw(player) || depth == 0)
-        return score;
+    if (board->game_is_over(player)) return evaluate(board, player);
 
     char ai = player->get_symbol();
     char opp = (ai == 'X') ? 'O' : 'X';
-    char turn = aiTurn ? ai : opp;
-    float best = aiTurn ? -INF : INF;
+    int lo = int(std::max(alpha, float(-WIN - 1))), hi = int(std::min(beta, float(WIN + 1)));
+    int move;
 
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            if (board->get_cell(i, j) == blankCell)
-            {
-                Move<char> move(i, j, turn);
-                board->update_board(&move);
-
-                float val = minimax(!aiTurn, player, alpha, beta, blankCell, depth - 1);
-
-                move = Move<char>(i, j, 0); // Undo move
-                board->update_board(&move);
-
-                if (aiTurn) { best = max(best, val); alpha = max(alpha, val); }
-                else        { best = min(best, val); beta  = min(beta, val); }
-
-                if (beta <= alpha) return best;
-            }
-
-    return best;
+    if (aiTurn) return float(search(board->getState(), ai, lo, hi, depth, move));
+    return float(-search(board->getState(), opp, -hi, -lo, depth, move));
 }
 
 /**
@@ -208,29 +269,13 @@ Move<char>* XO_inf_AI::bestMove(Player<char>* player, char blankCell, int depth)
     auto* board = dynamic_cast<XO_inf_Board*>(player->get_board_ptr());
     if (!board || !player) throw invalid_argument("Invalid board or player in bestMove()");
 
-    char ai = player->get_symbol();
-    float bestVal = -INF;
-    int bestR = -1, bestC = -1;
-
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            if (board->get_cell(i, j) == blankCell)
-            {
-                Move<char> move(i, j, ai);
-                board->update_board(&move);
-
-                float val = minimax(false, player, -INF, INF, blankCell, depth - 1);
-
-                move = Move<char>(i, j, 0); // Undo move
-                board->update_board(&move);
-
-                if (val > bestVal) { bestVal = val; bestR = i; bestC = j; }
-            }
+    int move;
+    search(board->getState(), player->get_symbol(), -WIN - 1, WIN + 1, std::max(depth, 1), move);
 
-    if (bestR == -1 || bestC == -1)
+    if (move < 0)
         throw runtime_error("No valid moves left for AI");
 
-    return new Move<char>(bestR, bestC, ai);
+    return new Move<char>(move / 3, move % 3, player->get_symbol());
 }
 
 //--------------------------------------- XO_inf_UI Implementation
@@ -314,7 +359,6 @@ Move<char>* XO_inf_UI::get_move(Player<char>* player) {
         return new Move<char>(x, y, player->get_symbol());
     }
     else if (player->get_type() == PlayerType::AI) {
-        XO_inf_AI ai;
         return ai.bestMove(player, '.', 13);
     }
 
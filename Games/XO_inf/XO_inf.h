@@ -4,8 +4,8 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
 #include "../../header/Custom_UI.h"
-#include <deque>
-#include <stack>
+#include <cstdint>
+#include <vector>
 
 /**
  * @file XO_inf.h
@@ -18,16 +18,38 @@
 using namespace std;
 
 /**
- * @struct Vertex
+ * @struct XO_inf_State
  * @ingroup XO_inf
- * @brief Represents a single move on the board.
+ * @brief Complete position of infinite Tic-Tac-Toe in a few bytes.
  *
- * Stores the coordinates and symbol of a move.
+ * Two 9-bit masks hold the marks and a ring buffer holds the occupied
+ * cells in placement order, so "remove the oldest mark every third move"
+ * is a pop from the front. Together with the move count modulo 3 this is
+ * the whole game state; key() packs it into 64 bits without loss.
  */
-struct Vertex {
-    int x;       ///< Row coordinate.
-    int y;       ///< Column coordinate.
-    char symbol; ///< Symbol placed at this position.
+struct XO_inf_State {
+    uint16_t x = 0;      ///< Cells holding X (bit 3*r+c)
+    uint16_t o = 0;      ///< Cells holding O
+    uint8_t  cells[9];   ///< Occupied cells, oldest first (ring buffer)
+    uint8_t  head = 0;   ///< Index of the oldest entry in cells
+    uint8_t  size = 0;   ///< Number of marks on the board
+    uint8_t  moves = 0;  ///< Moves played
+
+    /**
+     * @brief Place a mark and apply the every-third-move removal.
+     * @param idx Cell index 3*r+c (must be empty)
+     * @param mark 'X' or 'O'
+     */
+    void play(int idx, char mark);
+
+    /** @brief Free cells. */
+    uint16_t empty() const { return uint16_t(~(x | o) & 0777); }
+
+    /** @brief Exact 64-bit encoding (marks, age order, move phase). */
+    uint64_t key() const;
+
+    /** @brief True if a mask contains a 3-in-a-row. */
+    static bool hasLine(uint16_t mask);
 };
 
 /**
@@ -35,22 +57,27 @@ struct Vertex {
  * @ingroup XO_inf
  * @brief Board class for infinite Tic-Tac-Toe.
  *
- * Maintains the board state, move history, and provides
- * logic for applying moves and checking game termination conditions.
+ * After every third move the oldest mark on the board disappears. The
+ * position lives in an XO_inf_State; undo restores a saved copy, so the
+ * removed mark comes back exactly. Marks on the board grow by two every
+ * three moves, so the board is full after at most 13 moves; a full board
+ * without a line is a draw.
  */
 class XO_inf_Board : public Board<char> {
 private:
     char blank_symbol = '.';      ///< Character used to represent an empty cell.
-    deque<Vertex> history;        ///< Move history for redo/undo.
-    stack<Vertex> undoHistory;    ///< Stack to support undo operations.
-    int cnt = 0;                  ///< Move counter.
+    XO_inf_State state;           ///< Current position.
+    std::vector<XO_inf_State> undoHistory; ///< Positions before each move, for undo.
+
+    /** @brief Copy the state into the character matrix. */
+    void syncMatrix();
 
 public:
     XO_inf_Board();
 
     /**
      * @brief Apply a move to the board.
-     * @param move Pointer to the move object.
+     * @param move Pointer to the move object (symbol 0 undoes the last move).
      * @return True if the move was applied successfully.
      */
     bool update_board(Move<char>* move);
@@ -72,7 +99,7 @@ public:
     /**
      * @brief Check if the game is a draw.
      * @param player Pointer to the active player.
-     * @return True if the game is drawn.
+     * @return True if the board is full and nobody has a line.
      */
     bool is_draw(Player<char>* player);
 
@@ -82,6 +109,16 @@ public:
      * @return True if the game has ended.
      */
     bool game_is_over(Player<char>* player);
+
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        state = XO_inf_State();
+        undoHistory.clear();
+        syncMatrix();
+    }
+
+    /** @brief Current position. */
+    const XO_inf_State& getState() const { return state; }
 };
 
 /**
@@ -91,10 +128,14 @@ public:
  *
  * Provides board evaluation, minimax search with alpha–beta pruning,
  * and best move computation.
+ *
+ * Search runs on XO_inf_State copies (no board calls) as negamax with a
+ * transposition table kept across moves. Wins score higher the sooner
+ * they happen. A 13-ply search reaches the end of every game.
  */
 class XO_inf_AI : public AI {
 public:
-    XO_inf_AI() {}
+    XO_inf_AI();
 
     /**
      * @brief Evaluate the score of the board state.
@@ -131,6 +172,33 @@ public:
     Move<char>* bestMove(Player<char>* player,
                          char blankCell,
                          int depth = 6) override;
+
+    /** @brief Nodes searched since construction. */
+    uint64_t nodes() const { return nodeCount; }
+
+private:
+    static constexpr int WIN = 100; ///< Score of an immediate win
+
+    enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        uint64_t key = 0;     ///< XO_inf_State::key()
+        int8_t value = 0;     ///< Score (side to move)
+        int8_t depth = -1;    ///< Remaining depth searched
+        uint8_t bound = NONE; ///< Bound type of value
+        int8_t move = -1;     ///< Best move found
+    };
+
+    /**
+     * @brief Negamax alpha-beta on a state.
+     * @param mark Symbol of the side to move
+     * @param move Receives the best move
+     * @return Score for the side to move
+     */
+    int search(const XO_inf_State& s, char mark, int alpha, int beta, int depth, int& move);
+
+    std::vector<Entry> table; ///< Transposition table (replace always)
+    uint64_t nodeCount = 0;   ///< Node counter
 };
 
 /**
@@ -160,6 +228,9 @@ public:
      * @return Pointer to the constructed move object.
      */
     Move<char>* get_move(Player<char>* player) override;
+
+private:
+    XO_inf_AI ai; ///< Keeps its transposition table across moves
 };
 
 #endif
\ No newline at end of file
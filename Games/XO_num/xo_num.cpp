@@ -8,6 +8,58 @@
 
 using namespace std;
 
+// ======================= XO_NUM_State =======================
+
+const uint8_t XO_NUM_State::LINES[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},   // rows
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},   // columns
+    {0, 4, 8}, {2, 4, 6}               // diagonals
+};
+
+const uint8_t XO_NUM_State::CELL_LINES[9] = {
+    0x49, 0x11, 0xA1,
+    0x0A, 0xD2, 0x22,
+    0x8C, 0x14, 0x64
+};
+
+uint16_t XO_NUM_State::pool(bool oddSide) const {
+    uint16_t mask = 0;
+    if (oddSide) { for (int k = 0; k < 5; k++) if (odd  >> k & 1) mask |= uint16_t(1u << (2 * k + 1)); }
+    else         { for (int k = 0; k < 4; k++) if (even >> k & 1) mask |= uint16_t(1u << (2 * k + 2)); }
+    return mask;
+}
+
+void XO_NUM_State::play(int idx, int num) {
+    cells |= uint64_t(num) << (4 * idx);
+    filled |= uint16_t(1u << idx);
+    if (num % 2) odd  &= uint8_t(~(1u << (num / 2)));
+    else         even &= uint8_t(~(1u << (num / 2 - 1)));
+    ++moves;
+}
+
+void XO_NUM_State::undo(int idx) {
+    const int num = get(idx);
+    cells &= ~(uint64_t(0xF) << (4 * idx));
+    filled &= uint16_t(~(1u << idx));
+    if (num % 2) odd  |= uint8_t(1u << (num / 2));
+    else         even |= uint8_t(1u << (num / 2 - 1));
+    --moves;
+}
+
+bool XO_NUM_State::lineThrough(int idx) const {
+    for (int l = 0; l < 8; l++) {
+        if (!(CELL_LINES[idx] >> l & 1)) continue;
+        const uint8_t* c = LINES[l];
+        const int a = get(c[0]), b = get(c[1]), d = get(c[2]);
+        if (a && b && d && a + b + d == 15) return true;
+    }
+    return false;
+}
+
+bool XO_NUM_State::hasLine() const {
+    return lineThrough(0) || lineThrough(4) || lineThrough(8);
+}
+
 // ======================= XO_NUM_Board =======================
 
 XO_NUM_Board::XO_NUM_Board() : Board(3, 3) {
@@ -29,56 +81,47 @@ bool XO_NUM_Board::update_board(Move<char>* move) {
     if (x < 0 || x >= rows || y < 0 || y >= columns)
         return false;
 
-    // Cannot overwrite unless undo
-    if (board[x][y] != blank_symbol && mark != 0)
-        return false;
+    const int idx = x * 3 + y;
 
-    if (mark == 0) { // Undo move
+    if (mark == 0) { // Undo move: the number goes back to its pool
+        if (!state.get(idx)) return false;
+        state.undo(idx);
         board[x][y] = blank_symbol;
-        n_moves++;
-        // Restore the number to the vector
-        if ((move->get_symbol() - '0') % 2 == 0) even.push_back(mark);
-        else odd.push_back(mark);
-    } else { // Apply move
-        board[x][y] = mark;
-        n_moves++;
-        // Remove number from available pool
-        if ((mark - '0') % 2 == 0) {
-            auto it = find(even.begin(), even.end(), mark);
-            if (it != even.end()) even.erase(it);
-        } else {
-            auto it = find(odd.begin(), odd.end(), mark);
-            if (it != odd.end()) odd.erase(it);
-        }
+        n_moves = state.moves;
+        return true;
     }
+
+    // Cannot overwrite; the number must be unused and of the mover's parity
+    const int num = mark - '0';
+    if (state.get(idx) || num < 1 || num > 9 || !(state.pool(state.oddToMove()) >> num & 1))
+        return false;
+
+    state.play(idx, num);
+    board[x][y] = mark;
+    n_moves = state.moves;
     return true;
 }
 
+string XO_NUM_Board::available_numbers() const {
+    string digits;
+    const uint16_t mask = state.pool(state.oddToMove());
+    for (int n = 1; n <= 9; n++)
+        if (mask >> n & 1) digits += char('0' + n);
+    return digits;
+}
+
 /**
- * @brief Returns true if a row, column, or diagonal sums to 15
+ * @brief Returns true if a full row, column, or diagonal sums to 15
  */
 bool XO_NUM_Board::is_win(Player<char>* player) {
-    auto sum = [](char a, char b, char c) { return (a - '0') + (b - '0') + (c - '0'); };
-
-    // Rows & columns
-    for (int i = 0; i < 3; i++)
-        if (sum(board[i][0], board[i][1], board[i][2]) == 15 ||
-            sum(board[0][i], board[1][i], board[2][i]) == 15)
-            return true;
-
-    // Diagonals
-    if (sum(board[0][0], board[1][1], board[2][2]) == 15 ||
-        sum(board[0][2], board[1][1], board[2][0]) == 15)
-        return true;
-
-    return false;
+    return state.hasLine();
 }
 
 /**
  * @brief Returns true if all moves used and no win
  */
 bool XO_NUM_Board::is_draw(Player<char>* player) {
-    return n_moves == 9 && !is_win(player);
+    return state.filled == 0x1FF && !state.hasLine();
 }
 
 /**
@@ -129,7 +172,7 @@ Move<char>* XO_NUM_UI::get_move(Player<char>* player) {
         cout << "\nEnter row and column (0-2): ";
         cin >> x >> y;
 
-        vector<char>& choices = (player->get_symbol() == '1') ? board->odd : board->even;
+        const string choices = board->available_numbers();
 
         cout << "Choose a number: ";
         for (char ch : choices) cout << ch << " ";
@@ -137,18 +180,13 @@ Move<char>* XO_NUM_UI::get_move(Player<char>* player) {
 
         cin >> num;
 
-        auto exist = [](vector<char>& v, char n) -> bool {
-            return find(v.begin(), v.end(), n) != v.end();
-        };
-
-        while (!exist(choices, num)) {
+        while (choices.find(num) == string::npos) {
             cout << "Invalid number, choose again: ";
             for (char ch : choices) cout << ch << " ";
             cout << endl;
             cin >> num;
         }
     } else {
-        XO_NUM_AI ai;
         return ai.bestMove(player, '.');
     }
 
@@ -157,31 +195,150 @@ Move<char>* XO_NUM_UI::get_move(Player<char>* player) {
 
 // ======================= XO_NUM_AI =======================
 
+XO_NUM_AI::XO_NUM_AI() : table(1 << 18) {}
+
+uint64_t XO_NUM_AI::canonical(uint64_t cells) {
+    static const uint8_t SYM[8][9] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8}, {2, 5, 8, 1, 4, 7, 0, 3, 6},
+        {8, 7, 6, 5, 4, 3, 2, 1, 0}, {6, 3, 0, 7, 4, 1, 8, 5, 2},
+        {2, 1, 0, 5, 4, 3, 8, 7, 6}, {6, 7, 8, 3, 4, 5, 0, 1, 2},
+        {0, 3, 6, 1, 4, 7, 2, 5, 8}, {8, 5, 2, 7, 4, 1, 6, 3, 0}
+    };
+    uint64_t best = cells;
+    for (int s = 1; s < 8; s++) {
+        uint64_t image = 0;
+        for (int i = 0; i < 9; i++)
+            image |= (cells >> (4 * SYM[s][i]) & 0xF) << (4 * i);
+        best = min(best, image);
+    }
+    return best;
+}
+
 /**
- * @brief Picks a random empty cell and number
+ * @brief Negamax alpha-beta to the end of the game
+ *
+ * @details Lines holding two numbers decide most nodes: if the mover owns
+ * the completing number it wins now; a move that leaves such a line for
+ * the opponent's pool loses on the next placement and is scored without
+ * a recursive call.
  */
-Move<char>* XO_NUM_AI::bestMove(Player<char>* player, char blankCell, int depth) {
-    auto* board = dynamic_cast<XO_NUM_Board*>(player->get_board_ptr());
-    vector<pair<int,int>> emptyCells;
+int XO_NUM_AI::search(XO_NUM_State& s, int alpha, int beta) {
+    ++nodeCount;
+
+    const uint16_t free = uint16_t(~s.filled & 0x1FF);
+    if (!free) return 0;
+
+    const uint16_t mine = s.pool(s.oddToMove()), theirs = s.pool(!s.oddToMove());
+
+    // Lines with two numbers: a win for us now, or a threat we must fill
+    uint8_t threats = 0;
+    for (int l = 0; l < 8; l++) {
+        const uint8_t* c = XO_NUM_State::LINES[l];
+        int count = 0, sum = 0;
+        for (int k = 0; k < 3; k++) if (int v = s.get(c[k])) { ++count; sum += v; }
+        if (count != 2 || sum >= 15 || sum < 6) continue;
+        if (mine >> (15 - sum) & 1) return WIN;
+        if (theirs >> (15 - sum) & 1) threats |= uint8_t(1u << l);
+    }
 
-    // Collect empty cells
-    for (int i = 0; i < board->get_rows(); i++)
-        for (int j = 0; j < board->get_columns(); j++)
-            if (board->get_cell(i,j) == blankCell)
-                emptyCells.push_back({i,j});
+    const uint64_t key = canonical(s.cells) + 1;
+    Entry& e = table[(key * 0x9E3779B97F4A7C15ull) >> 46];
+    if (e.key == key) {
+        if (e.bound == EXACT) return e.value;
+        if (e.bound == LOWER && e.value >= beta) return e.value;
+        if (e.bound == UPPER && e.value <= alpha) return e.value;
+    }
 
-    if (emptyCells.empty()) return nullptr;
+    const int alpha0 = alpha;
+    int best = -(WIN - 1);
+
+    for (int i = 0; i < 9 && best < beta; i++) {
+        if (!(free >> i & 1)) continue;
+        // A threat on a line not through this cell survives any number
+        if (threats & ~XO_NUM_State::CELL_LINES[i]) continue;
+
+        for (int num = 1; num <= 9; num++) {
+            if (!(mine >> num & 1)) continue;
+            s.play(i, num);
+
+            // Lines through i now holding two numbers the opponent can finish
+            bool loses = false;
+            for (int l = 0; l < 8 && !loses; l++) {
+                if (!(XO_NUM_State::CELL_LINES[i] >> l & 1)) continue;
+                const uint8_t* c = XO_NUM_State::LINES[l];
+                int count = 0, sum = 0;
+                for (int k = 0; k < 3; k++) if (int v = s.get(c[k])) { ++count; sum += v; }
+                loses = count == 2 && sum < 15 && sum >= 6 && (theirs >> (15 - sum) & 1);
+            }
+
+            if (!loses) {
+                int value = -search(s, -beta - 1, -alpha + 1);
+                value -= (value > 0) - (value < 0);
+                best = max(best, value);
+                alpha = max(alpha, best);
+            }
+            s.undo(i);
+
+            if (best >= beta) break;
+        }
+    }
+
+    e.key = key;
+    e.value = int8_t(best);
+    e.bound = best <= alpha0 ? UPPER : best >= beta ? LOWER : EXACT;
+    return best;
+}
+
+/**
+ * @brief Solved value of the board for the side to move
+ */
+float XO_NUM_AI::evaluate(Board<char>* b, Player<char>* player) {
+    auto* board = dynamic_cast<XO_NUM_Board*>(b);
+    if (!board) throw invalid_argument("Invalid board in evaluate()");
 
-    int cellIndex = rand() % emptyCells.size();
-    int x = emptyCells[cellIndex].first;
-    int y = emptyCells[cellIndex].second;
+    XO_NUM_State s = board->getState();
+    if (s.hasLine()) return float(-WIN); // the previous placement won
+    return float(search(s, -WIN - 1, WIN + 1));
+}
 
-    // Pick a number from remaining odd/even choices
-    vector<char>& choices = (player->get_symbol() == '1') ? board->odd : board->even;
-    if (choices.empty()) return nullptr;
+/**
+ * @brief Solved value from the AI's point of view
+ */
+float XO_NUM_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) {
+    const float value = evaluate(player->get_board_ptr(), player);
+    return aiTurn ? value : -value;
+}
 
-    int numIndex = rand() % choices.size();
-    char num = choices[numIndex];
+/**
+ * @brief Picks the move with the best solved value
+ *
+ * @details Immediate wins are taken directly; otherwise every (cell,
+ * number) pair is scored by search() with a window just above the best
+ * value so far. Ties keep the first move found.
+ */
+Move<char>* XO_NUM_AI::bestMove(Player<char>* player, char blankCell, int depth) {
+    auto* board = dynamic_cast<XO_NUM_Board*>(player->get_board_ptr());
+    if (!board) throw invalid_argument("Invalid board in bestMove()");
+
+    XO_NUM_State s = board->getState();
+    const uint16_t mine = s.pool(s.oddToMove());
+    int bestValue = -WIN - 1, bestCell = -1, bestNum = 0;
+
+    for (int i = 0; i < 9; i++) {
+        if (s.filled >> i & 1) continue;
+        for (int num = 1; num <= 9; num++) {
+            if (!(mine >> num & 1)) continue;
+            s.play(i, num);
+            int value = WIN;
+            if (!s.lineThrough(i)) {
+                value = -search(s, -WIN - 1, -bestValue + 1);
+                value -= (value > 0) - (value < 0);
+            }
+            s.undo(i);
+            if (value > bestValue) { bestValue = value; bestCell = i; bestNum = num; }
+        }
+    }
 
-    return new Move<char>(x, y, num);
-}
\ No newline at end of file
+    if (bestCell < 0) return nullptr;
+    return new Move<char>(bestCell / 3, bestCell % 3, char('0' + bestNum));
+}
@@ -3,6 +3,9 @@
 
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
+#include <cstdint>
+#include <string>
+#include <vector>
 
 /**
  * @file XO_num.h
@@ -14,6 +17,48 @@
 
 using namespace std;
 
+/**
+ * @struct XO_NUM_State
+ * @ingroup XO_num
+ * @brief Compact Numerical Tic-Tac-Toe position.
+ *
+ * Cell values are packed 4 bits per cell (0 = empty) into 36 bits; the
+ * unused numbers are a 5-bit odd mask (bit k = 2k+1) and a 4-bit even mask
+ * (bit k = 2k+2). Odd always moves first, so the side to move follows
+ * from the move count.
+ */
+struct XO_NUM_State {
+    uint64_t cells = 0;    ///< Value of cell i in bits 4i..4i+3
+    uint16_t filled = 0;   ///< Occupied cells (bit i)
+    uint8_t  odd = 0x1F;   ///< Unused odd numbers
+    uint8_t  even = 0x0F;  ///< Unused even numbers
+    uint8_t  moves = 0;    ///< Numbers placed
+
+    static const uint8_t LINES[8][3];  ///< Cells of each row, column and diagonal
+    static const uint8_t CELL_LINES[9]; ///< Lines through each cell (bit per line)
+
+    /** @brief Value in a cell (0 if empty). */
+    int get(int idx) const { return int(cells >> (4 * idx) & 0xF); }
+
+    /** @brief True if the odd player is to move. */
+    bool oddToMove() const { return moves % 2 == 0; }
+
+    /** @brief Numbers available to one side, as a mask over bits 1..9. */
+    uint16_t pool(bool oddSide) const;
+
+    /** @brief Place a number in an empty cell. */
+    void play(int idx, int num);
+
+    /** @brief Remove the number in a cell and return it to its pool. */
+    void undo(int idx);
+
+    /** @brief True if a full line through cell idx sums to 15. */
+    bool lineThrough(int idx) const;
+
+    /** @brief True if any full line sums to 15. */
+    bool hasLine() const;
+};
+
 /**
  * @class XO_NUM_Board
  * @ingroup XO_num
@@ -27,11 +72,9 @@ using namespace std;
 class XO_NUM_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Symbol representing empty cells
+    XO_NUM_State state;      ///< Current position
 
 public:
-    vector<char> odd{'1','3','5','7','9'};   ///< Available odd numbers
-    vector<char> even{'2','4','6','8'};      ///< Available even numbers
-
     /**
      * @brief Construct a new XO_NUM_Board object
      */
@@ -39,11 +82,24 @@ public:
 
     /**
      * @brief Apply or undo a move on the board
+     *
+     * The move symbol is the digit to place; it must come from the pool of
+     * the side to move (odd moves first). Symbol 0 clears the cell.
+     *
      * @param move Pointer to the move being applied
      * @return True if the move was applied successfully, false otherwise
      */
     bool update_board(Move<char>* move) override;
 
+    /**
+     * @brief Digits still available to the side to move
+     * @return e.g. "1379"
+     */
+    string available_numbers() const;
+
+    /** @brief Current position */
+    const XO_NUM_State& getState() const { return state; }
+
     /**
      * @brief Check if a player has won
      * @param player Pointer to the player to check
@@ -71,6 +127,13 @@ public:
      * @return True if the game ended (win or draw), false otherwise
      */
     bool game_is_over(Player<char>* player) override;
+
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        state = XO_NUM_State();
+        n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), blank_symbol);
+    }
 };
 
 // ============================================================================
@@ -80,42 +143,73 @@ public:
 /**
  * @class XO_NUM_AI
  * @ingroup AI
- * @brief Random-move AI for Numerical Tic-Tac-Toe
+ * @brief Perfect-play solver for Numerical Tic-Tac-Toe
  *
- * @details Chooses a random available cell and number from the player's pool.
+ * @details Negamax alpha-beta over (cell, number) moves on XO_NUM_State,
+ * always searched to the end of the game. Immediate wins are found from
+ * the line sums before any move is generated, and moves that hand the
+ * opponent a completing number are scored without recursion. Positions
+ * are stored under their canonical (dihedral) form in a transposition
+ * table kept for the lifetime of the AI. Faster wins score higher.
  */
 class XO_NUM_AI : public AI {
 public:
-    XO_NUM_AI() = default;
+    XO_NUM_AI();
 
     /**
-     * @brief Evaluate the board (not implemented)
+     * @brief Solved value of the position for the player
      * @param b Pointer to the board
-     * @param player Pointer to the player
-     * @return Default 0.0f
+     * @param player Pointer to the player (side to move is taken from the board)
+     * @return Positive if the side to move wins, negative if it loses, 0 for a draw
      */
-    float evaluate(Board<char>* b, Player<char>* player) override { return 0.0f; }
+    float evaluate(Board<char>* b, Player<char>* player) override;
 
     /**
-     * @brief Minimax (not implemented)
+     * @brief Solved value of the player's board from the AI's point of view
      * @param aiTurn True if AI's turn
      * @param player Pointer to the player
      * @param alpha Alpha value
      * @param beta Beta value
      * @param blankCell Empty cell symbol
-     * @param depth Search depth
-     * @return Default 0.0f
+     * @param depth Ignored (the game is always solved)
+     * @return Game value
      */
-    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override { return 0.0f; }
+    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override;
 
     /**
      * @brief Compute the best move
      * @param player Pointer to the player
      * @param blankCell Symbol for empty cells
-     * @param depth Search depth (default 6)
-     * @return Pointer to the chosen Move<char>
+     * @param depth Ignored (the game is always solved)
+     * @return Pointer to the chosen Move<char>, nullptr if the board is full
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+    /** @brief Nodes searched since construction */
+    uint64_t nodes() const { return nodeCount; }
+
+private:
+    static constexpr int WIN = 20; ///< Score of a win on the next placement
+
+    enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        uint64_t key = 0;     ///< Canonical cells + 1
+        int8_t value = 0;     ///< Score for the side to move
+        uint8_t bound = NONE; ///< Bound type of value
+    };
+
+    /**
+     * @brief Negamax alpha-beta to the end of the game
+     * @return Score for the side to move
+     */
+    int search(XO_NUM_State& s, int alpha, int beta);
+
+    /** @brief Smallest packed cell word over the 8 board symmetries */
+    static uint64_t canonical(uint64_t cells);
+
+    std::vector<Entry> table; ///< Transposition table (replace always)
+    uint64_t nodeCount = 0;   ///< Node counter
 };
 
 // ============================================================================
@@ -157,6 +251,9 @@ public:
      * @return Pointer to the generated Move<char>
      */
     Move<char>* get_move(Player<char>* player) override;
+
+private:
+    XO_NUM_AI ai; ///< Keeps its transposition table across moves
 };
 
 #endif // XO_NUM_H
\ No newline at end of file
@@ -4,13 +4,27 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <stdexcept>
 using namespace std;
 
+const uint16_t Anti_XO_Board::LINES[8] = {
+    0x007, 0x038, 0x1C0, // rows
+    0x049, 0x092, 0x124, // columns
+    0x111, 0x054         // diagonals
+};
+
 Anti_XO_Board::Anti_XO_Board():Board(3,3)
 {
     board.assign(3, vector<char>(3, '.'));
 }
 
+bool Anti_XO_Board::hasLine(uint16_t mask)
+{
+    for (uint16_t line : LINES)
+        if ((mask & line) == line) return true;
+    return false;
+}
+
 bool Anti_XO_Board::update_board(Move<char>* move)
 {
     int r = move->get_x();
@@ -20,45 +34,35 @@ bool Anti_XO_Board::update_board(Move<char>* move)
     if (r < 0 || r >= 3 || c < 0 || c >= 3)
         return false;
 
+    const uint16_t bit = uint16_t(1u << (r * 3 + c));
+
+    if (s == 0) {
+        if (board[r][c] == '.')
+            return false;
+        maskX &= uint16_t(~bit);
+        maskO &= uint16_t(~bit);
+        board[r][c] = '.';
+        n_moves--;
+        return true;
+    }
+
     if (board[r][c] != '.')
         return false;
 
     board[r][c] = s;
+    (s == 'X' ? maskX : maskO) |= bit;
+    n_moves++;
     return true;
 }
 
 bool Anti_XO_Board::is_lose(Player<char>* player)
 {
-    char sym = player->get_symbol();
-
-    for (int r = 0; r < 3; r++)
-        if (board[r][0] == sym && board[r][1] == sym && board[r][2] == sym)
-            return true;
-
-    for (int c = 0; c < 3; c++)
-        if (board[0][c] == sym && board[1][c] == sym && board[2][c] == sym)
-            return true;
-
-    if (board[0][0] == sym && board[1][1] == sym && board[2][2] == sym)
-        return true;
-
-    if (board[0][2] == sym && board[1][1] == sym && board[2][0] == sym)
-        return true;
-
-    return false;
+    return hasLine(getMask(player->get_symbol()));
 }
 
 bool Anti_XO_Board::is_draw(Player<char>* player)
 {
-    if (is_lose(player)) 
-        return false;
-
-    for (int r = 0; r < 3; r++)
-        for (int c = 0; c < 3; c++)
-            if (board[r][c] == '.')
-                return false;
-
-    return true;
+    return n_moves == 9 && !hasLine(maskX) && !hasLine(maskO);
 }
 
 bool Anti_XO_Board::game_is_over(Player<char>* player)
@@ -88,59 +92,110 @@ Move<char>* Anti_XO_UI::get_move(Player<char>* player)
         c = rand()%3;
     } 
     else if (player->get_type() == PlayerType::AI) {
-        Anti_AI ai;
         return ai.bestMove(player, '.');
     }
 
     return new Move<char>(r, c, player->get_symbol());
 }
 
-bool Anti_AI::bounded(int x, int y)
+Anti_AI::Anti_AI() : table(1 << 18) {}
+
+/**
+ * @brief Misère negamax alpha-beta to the end of the game
+ *
+ * @details Nobody holds a line at a node. Cells that would complete one of
+ * the mover's lines are never searched: they are only played when nothing
+ * else is left, and then the mover loses. Safe cells are tried centre,
+ * corners, edges.
+ */
+int Anti_AI::search(uint16_t own, uint16_t opp, int alpha, int beta)
 {
-    return (x>0 && x<3 && y>0 && y<3);
-}
+    ++nodeCount;
+
+    const uint16_t free = uint16_t(~(own | opp) & 0x1FF);
+    if (!free) return 0;
+
+    uint16_t safe = 0;
+    for (int i = 0; i < 9; i++)
+        if ((free >> i & 1) && !Anti_XO_Board::hasLine(uint16_t(own | 1u << i)))
+            safe |= uint16_t(1u << i);
+    if (!safe) return -WIN;
+
+    Entry& e = table[own | opp << 9];
+    if (e.bound == EXACT) return e.value;
+    if (e.bound == LOWER && e.value >= beta) return e.value;
+    if (e.bound == UPPER && e.value <= alpha) return e.value;
+
+    static const int8_t ORDER[9] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };
+
+    const int alpha0 = alpha;
+    int best = -WIN - 1;
+    for (int cell : ORDER) {
+        if (!(safe >> cell & 1)) continue;
+        int value = -search(opp, uint16_t(own | 1u << cell), -beta - 1, -alpha + 1);
+        // A result one ply further away is worth one point less
+        value -= (value > 0) - (value < 0);
+        best = max(best, value);
+        alpha = max(alpha, best);
+        if (alpha >= beta) break;
+    }
 
+    e.value = int8_t(best);
+    e.bound = best <= alpha0 ? UPPER : best >= beta ? LOWER : EXACT;
+    return best;
+}
 
-Move<char> *Anti_AI::bestMove(Player<char> *player, char blankCell, int depth)
+int Anti_AI::playValue(uint16_t own, uint16_t opp, int cell)
 {
-    auto* board = player->get_board_ptr();
-    char s = player->get_symbol();
-
-    vector<pair<int, pair<int,int>>> scores;
-
-    int dx[8] = { -1,-1, 0, 1, 1, 1, 0,-1 };
-    int dy[8] = {  0, 1, 1, 1, 0,-1,-1,-1 };
+    own |= uint16_t(1u << cell);
+    if (Anti_XO_Board::hasLine(own)) return -WIN;
+    int value = -search(opp, own, -WIN - 1, WIN + 1);
+    return value - ((value > 0) - (value < 0));
+}
 
-    for (int x = 0; x < 3; x++) {
-        for (int y = 0; y < 3; y++) {
-            if (board->get_cell(x, y) != '.') continue;
+float Anti_AI::evaluate(Board<char>* b, Player<char>* player)
+{
+    auto* board = dynamic_cast<Anti_XO_Board*>(b);
+    if (!board || !player) throw invalid_argument("Invalid board or player in evaluate()");
 
-            int danger = 0;
+    const char me = player->get_symbol(), opp = (me == 'X') ? 'O' : 'X';
+    if (Anti_XO_Board::hasLine(board->getMask(me))) return float(-WIN);
+    if (Anti_XO_Board::hasLine(board->getMask(opp))) return float(WIN);
+    return float(search(board->getMask(me), board->getMask(opp), -WIN - 1, WIN + 1));
+}
 
-            for (int d = 0; d < 8; d++) {
-                int nx = x + dx[d];
-                int ny = y + dy[d];
+float Anti_AI::minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth)
+{
+    auto* board = dynamic_cast<Anti_XO_Board*>(player ? player->get_board_ptr() : nullptr);
+    if (!board) throw invalid_argument("Invalid board or player in minimax()");
 
-                if (!bounded(nx, ny)) continue;
+    const char me = player->get_symbol(), opp = (me == 'X') ? 'O' : 'X';
+    const uint16_t own = board->getMask(me), theirs = board->getMask(opp);
+    if (Anti_XO_Board::hasLine(own)) return float(-WIN);
+    if (Anti_XO_Board::hasLine(theirs)) return float(WIN);
 
-                if (board->get_cell(nx, ny) == s)
-                    danger++;
-            }
+    if (aiTurn) return float(search(own, theirs, -WIN - 1, WIN + 1));
+    return float(-search(theirs, own, -WIN - 1, WIN + 1));
+}
 
-            scores.push_back({ danger, {x, y} });
-        }
+Move<char> *Anti_AI::bestMove(Player<char> *player, char blankCell, int depth)
+{
+    auto* board = dynamic_cast<Anti_XO_Board*>(player ? player->get_board_ptr() : nullptr);
+    if (!board) throw invalid_argument("Invalid board or player in bestMove()");
+
+    const char s = player->get_symbol(), opp = (s == 'X') ? 'O' : 'X';
+    const uint16_t own = board->getMask(s), theirs = board->getMask(opp);
+
+    static const int8_t ORDER[9] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };
+    int best = -WIN - 2, bestCell = -1;
+    for (int cell : ORDER) {
+        if ((own | theirs) >> cell & 1) continue;
+        int value = playValue(own, theirs, cell);
+        if (value > best) { best = value; bestCell = cell; }
     }
 
-    if (scores.empty())
+    if (bestCell < 0)
         throw std::runtime_error("Empty Move");
 
-    sort(scores.begin(), scores.end(),
-         [](auto &a, auto &b){ return a.first < b.first; });
-
-    const int K = 2;  
-    int maxChoices = min(K, (int)scores.size());
-    int idx = rand() % maxChoices;
-
-    auto &choice = scores[idx];
-    return new Move(choice.second.first, choice.second.second, s);
-}
\ No newline at end of file
+    return new Move<char>(bestCell / 3, bestCell % 3, s);
+}
@@ -16,6 +16,8 @@
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
 #include "../../header/Custom_UI.h"
+#include <cstdint>
+#include <vector>
 
 /**
  * @class Anti_XO_Board
@@ -27,10 +29,18 @@
  *  - Manage board state
  *  - Apply player moves
  *  - Detect losing and draw conditions
+ *
+ * Alongside the matrix, each player's marks are kept as a 9-bit mask
+ * (cell r * 3 + c) so lines are tested with eight mask comparisons.
  */
 class Anti_XO_Board : public Board<char>
 {
+    uint16_t maskX = 0; ///< Cells held by X
+    uint16_t maskO = 0; ///< Cells held by O
+
 public:
+    static const uint16_t LINES[8]; ///< Rows, columns and diagonals as cell masks
+
     /**
      * @brief Constructs a 3×3 Anti-XO board initialized with empty cells ('.').
      */
@@ -38,11 +48,17 @@ public:
 
     /**
      * @brief Places a symbol on the board if the position is valid and empty.
-     * @param move Pointer to the move containing row, column, and symbol
+     * @param move Pointer to the move containing row, column, and symbol (0 undoes)
      * @return True if the move was applied, false otherwise
      */
     bool update_board(Move<char>* move) override;
 
+    /** @brief Cells held by the symbol as a 9-bit mask. */
+    uint16_t getMask(char symbol) const { return symbol == 'X' ? maskX : maskO; }
+
+    /** @brief True if the mask contains one of the lines. */
+    static bool hasLine(uint16_t mask);
+
     /**
      * @brief Checks if the player loses by forming a 3-in-a-row line.
      * @param player Pointer to the player to evaluate
@@ -70,58 +86,87 @@ public:
      * @return True if game finished
      */
     bool game_is_over(Player<char>* player) override;
+
+    /** @brief Clear the board for a new game. */
+    void reset() override {
+        maskX = maskO = 0;
+        n_moves = 0;
+        for (auto& row : board) std::fill(row.begin(), row.end(), '.');
+    }
 };
 
 /**
  * @class Anti_AI
- * @brief Simple AI for Anti-XO that avoids dangerous positions.
+ * @brief Perfect-play solver for Anti-XO.
  *
  * @ingroup AI
  *
- * Responsibilities:
- *  - Select safe moves
- *  - Avoid forming 3-in-a-row
+ * Misère negamax with alpha-beta on the two 9-bit masks, searched to the
+ * end of the game. A player with only line-completing cells left loses on
+ * the spot. Positions are memoized in a table indexed directly by
+ * (mover, opponent) masks and kept for the lifetime of the AI. Later
+ * losses score higher than earlier ones.
  */
 class Anti_AI : public AI {
 public:
-    Anti_AI() = default;
+    Anti_AI();
 
     /**
-     * @brief Evaluation function (not used for Anti-XO).
+     * @brief Solved value of the position for the player to move.
      * @param board Pointer to board
      * @param player Pointer to AI player
-     * @return Always returns 0
+     * @return Positive if the player wins, negative if it loses, 0 for a draw
      */
-    float evaluate(Board<char>* board, Player<char>* player) override { return 0.0f; }
+    float evaluate(Board<char>* board, Player<char>* player) override;
 
     /**
-     * @brief Minimax placeholder (not used for Anti-XO).
+     * @brief Solved value from the AI's point of view.
      * @param aiTurn True if AI turn
      * @param player Pointer to AI player
      * @param alpha Alpha value
      * @param beta Beta value
      * @param blankCell Symbol for empty cells
-     * @param depth Search depth
-     * @return Always returns 0
-     */
-    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override { return 0.0f; }
-
-    /**
-     * @brief Checks that coordinates are within board bounds.
-     * @param x Row index
-     * @param y Column index
-     * @return True if (x,y) is valid
+     * @param depth Ignored (the game is always solved)
+     * @return Game value
      */
-    bool bounded(int x, int y);
+    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override;
 
     /**
-     * @brief Computes the best move by selecting the least dangerous adjacent cell.
+     * @brief Computes the move with the best solved value.
      * @param player Pointer to AI player
      * @param blankCell Symbol representing empty cells
-     * @param depth Unused
+     * @param depth Ignored (the game is always solved)
      * @return Pointer to the selected Move<char>
+     * @throws std::runtime_error if the board is full
      */
     Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+
+    /** @brief Nodes searched since construction. */
+    uint64_t nodes() const { return nodeCount; }
+
+private:
+    static constexpr int WIN = 20; ///< Score when the opponent completes a line
+
+    enum Bound : uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        int8_t value = 0;     ///< Score for the side to move
+        uint8_t bound = NONE; ///< Bound type of value
+    };
+
+    /**
+     * @brief Misère negamax alpha-beta to the end of the game.
+     * @param own Cells of the side to move
+     * @param opp Cells of the other side
+     * @return Score for the side to move
+     */
+    int search(uint16_t own, uint16_t opp, int alpha, int beta);
+
+    /** @brief Score of the side to move after it plays cell (see search()). */
+    int playValue(uint16_t own, uint16_t opp, int cell);
+
+    std::vector<Entry> table; ///< Memo indexed by own | opp << 9
+    uint64_t nodeCount = 0;   ///< Node counter
 };
 
 /**
@@ -158,4 +203,7 @@ public:
      * @return Pointer to Move<char>
      */
     Move<char>* get_move(Player<char>* player) override;
+
+private:
+    Anti_AI ai; ///< Solver kept across moves
 };
\ No newline at end of file
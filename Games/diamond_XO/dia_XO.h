@@ -17,6 +17,7 @@
 
 #include "../../header/BoardGame_Classes.h"
 #include "../../header/AI.h"
+#include "../../header/KInARowBoard.h"
 #include <unordered_set>
 #include <vector>
 #include <utility>
@@ -27,115 +28,57 @@
  */
 typedef std::unordered_set<std::vector<std::pair<int,int>>> zengy;
 
+/**
+ * @brief Playable cells of the diamond (bit r * 7 + c), |r - 3| + |c - 3| <= 3.
+ */
+constexpr unsigned long long diamondShape() {
+    unsigned long long mask = 0;
+    for (int r = 0; r < 7; r++)
+        for (int c = 0; c < 7; c++)
+            if ((r > 3 ? r - 3 : 3 - r) + (c > 3 ? c - 3 : 3 - c) <= 3)
+                mask |= 1ull << (r * 7 + c);
+    return mask;
+}
+
 /**
  * @class dia_XO_Board
  * @brief Represents the 7x7 diamond-shaped Tic-Tac-Toe board.
  *
  * @ingroup DiamondXO
  *
- * Responsibilities:
- *  - Manage board state
- *  - Apply player moves
- *  - Detect win/draw/game-over conditions
+ * A diamond-shaped KInARowBoard with the two-line rule: wins() looks for a
+ * run of four in one direction and a run of three in another.
  */
-class dia_XO_Board: public Board<char>
+class dia_XO_Board: public KInARowBoard<7, 7, 4, false, diamondShape()>
 {
-private:
-    int dx[8] = { -1, -1,  0, 1, 1,  1,  0, -1 }; ///< X-direction offsets for line scanning
-    int dy[8] = {  0,  1,  1, 1, 0, -1, -1, -1 }; ///< Y-direction offsets for line scanning
-
-    char invalid = 'z';   ///< Invalid cell symbol
-    char free    = '.';   ///< Empty playable cell
-
-    /**
-     * @brief Checks whether a coordinate is inside the board and free.
-     * @param x Row index
-     * @param y Column index
-     * @return True if (x,y) is on board and free
-     */
-    bool bounded(int x,int y);
-
 public:
     /** @brief Constructs the 7x7 diamond-shaped board. */
-    dia_XO_Board();
-
-    /**
-     * @brief Attempts to place a symbol on the board.
-     * @param move Pointer to Move object with row, column, and symbol
-     * @return True if the move was applied successfully
-     */
-    bool update_board(Move<char>* move) override;
+    dia_XO_Board() : KInARowBoard<7, 7, 4, false, diamondShape()>('.', 'z') {}
 
     /**
-     * @brief Losing condition not used for this variant.
-     * @param player Pointer to player
-     * @return Always false
+     * @brief Two-line rule on one side's bitboard.
+     * @param b Marks of one side
+     * @return True if b has a run of 4 and, in a different direction, a run of 3
      */
-    bool is_lose(Player<char>* player) override;
+    static bool wins(Word b);
 
-    /**
-     * @brief Checks whether a player has won based on diamond rules.
-     * @param player Pointer to player
-     * @return True if the player satisfies win conditions
-     */
-    bool is_win(Player<char>* player) override;
-
-    /**
-     * @brief Checks if the board is full and no more moves are possible.
-     * @param player Pointer to player (not used)
-     * @return True if draw
-     */
-    bool is_draw(Player<char>* player) override;
-
-    /**
-     * @brief Checks if the game is over (win or draw).
-     * @param player Pointer to player
-     * @return True if the game ended
-     */
-    bool game_is_over(Player<char>* player) override;
+    /** @brief Two-line rule for a side (see wins()). */
+    bool has_won(int side) const override { return wins(side_mask(side)); }
 };
 
 /**
  * @class dia_XO_AI
- * @brief Very simple AI for diamond Tic-Tac-Toe.
+ * @brief Alpha-beta AI for diamond Tic-Tac-Toe.
  *
  * @ingroup AI
  *
- * Responsibilities:
- *  - Picks a random empty cell
+ * The shared k-in-a-row search using dia_XO_Board::wins() for the
+ * two-line rule; leaves are scored on the open 4-cell windows.
  */
-class dia_XO_AI : public AI {
+class dia_XO_AI : public KInARowAI<dia_XO_Board> {
 public:
-    dia_XO_AI() = default;
-
-    /**
-     * @brief Evaluates board state (dummy, always 0).
-     * @param board Pointer to board
-     * @param player Pointer to AI player
-     * @return 0.0
-     */
-    float evaluate(Board<char>* board, Player<char>* player) override { return 0.0f; }
-
-    /**
-     * @brief Minimax (dummy, always 0).
-     * @param aiTurn True if AI's turn
-     * @param player Pointer to AI player
-     * @param alpha Alpha value
-     * @param beta Beta value
-     * @param blankCell Empty cell symbol
-     * @param depth Search depth
-     * @return 0.0
-     */
-    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override { return 0.0f; }
-
-    /**
-     * @brief Picks a random free cell for AI.
-     * @param player Pointer to AI player
-     * @param blankCell Symbol for empty cell
-     * @param depth Max search depth (unused)
-     * @return Pointer to chosen Move<char>
-     */
-    Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override;
+    /** @brief Construct with 2^tableBits table entries (1 MB by default). */
+    explicit dia_XO_AI(int tableBits = 16) : KInARowAI<dia_XO_Board>(tableBits) {}
 };
 
 /**
@@ -170,4 +113,7 @@ public:
      * @return Pointer to Move<char>
      */
     Move<char>* get_move(Player<char>* player) override;
+
+private:
+    dia_XO_AI ai; ///< Search kept across moves
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @file Accumulator.h
+ * @brief Incrementally updated first layer for board-encoded networks.
+ *
+ * @ingroup AI
+ *
+ * Board encodings change in one or two inputs per move, so the first
+ * layer's weighted sum W·x can be kept up to date by adding or subtracting
+ * one weight column per changed input instead of recomputing W·x. Only the
+ * activation of the first layer and the remaining layers are evaluated per
+ * query.
+ *
+ * The accumulator holds W·x without the bias; evaluate() takes a scale so a
+ * single sum serves both sides of a ±1 encoding (W·(-x) = -(W·x)).
+ */
+
+#ifndef ACCUMULATOR_H
+#define ACCUMULATOR_H
+
+#include "NeuralNetwork.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @class Accumulator
+ * @brief First-layer weighted sum of a network, updated per input change.
+ *
+ * @ingroup AI
+ *
+ * Copies share the (transposed) first-layer weights and carry their own
+ * sum, so one accumulator can be copied per tracked position. The weights
+ * are captured at construction; rebuild the accumulator after training.
+ */
+class Accumulator {
+public:
+    /**
+     * @brief Bind to a network.
+     * @param net Network whose first layer is accumulated
+     * @throws std::runtime_error if the network is empty or its first layer
+     *         uses a custom activation
+     */
+    explicit Accumulator(std::shared_ptr<NeuralNetwork> net);
+
+    /** @brief Reset to the all-zero input. */
+    void clear();
+
+    /**
+     * @brief Recompute the sum for a full input vector.
+     * @param input inputs() values
+     */
+    void refresh(const double* input);
+
+    /**
+     * @brief Apply a change of one input: sum += delta · W[:, input].
+     * @param input Input index
+     * @param delta New value minus old value
+     */
+    void add(int input, double delta);
+
+    /**
+     * @brief Network output for the accumulated input times @p scale.
+     * @param scale Input scale (typically +1 or -1)
+     * @return Output activations (outputSize × 1)
+     */
+    Matrix<double> evaluate(double scale = 1.0);
+
+    /** @brief Number of network inputs */
+    int inputs() const { return inputs_; }
+
+    /** @brief Accumulated W·x (first-layer neurons) */
+    const std::vector<double>& values() const { return sum_; }
+
+private:
+    std::shared_ptr<NeuralNetwork> net_;
+    std::shared_ptr<const std::vector<double>> columns_; ///< W transposed (inputs × neurons)
+    int inputs_ = 0;
+    int neurons_ = 0;
+    std::vector<double> sum_;  ///< W·x
+    Matrix<double> hidden_;    ///< Scratch first-layer activations
+};
+
+#endif // ACCUMULATOR_H
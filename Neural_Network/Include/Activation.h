@@ -0,0 +1,121 @@
+/**
+ * @file Activation.h
+ * @brief Compile-time activation policies for neural network layers.
+ *
+ * @ingroup AI
+ *
+ * Each policy exposes two static inline functions:
+ *  - f(x)  : the activation itself
+ *  - df(x) : its derivative, evaluated on the pre-activation value Z
+ *
+ * Layers select a policy through the Activation enum and dispatch once per
+ * forward/backward call, so the per-neuron loop is a plain inlined kernel
+ * instead of a std::function call.
+ */
+
+#ifndef ACTIVATION_H
+#define ACTIVATION_H
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+/**
+ * @enum Activation
+ * @brief Built-in activation types.
+ *
+ * The numeric values are stable and are written to model files,
+ * never reorder them.
+ */
+enum class Activation : std::uint8_t {
+    Linear    = 0, ///< f(x) = x
+    ReLU      = 1, ///< f(x) = max(0, x)
+    LeakyReLU = 2, ///< f(x) = x > 0 ? x : 0.01x
+    Tanh      = 3, ///< f(x) = tanh(x)
+    Sigmoid   = 4, ///< f(x) = 1 / (1 + e^-x)
+    Custom    = 255 ///< User supplied std::function (slow path)
+};
+
+namespace act {
+
+/** @brief Identity activation policy. */
+struct Linear {
+    static inline double f(double x)  { return x; }
+    static inline double df(double)   { return 1.0; }
+};
+
+/** @brief Rectified linear unit policy. */
+struct ReLU {
+    static inline double f(double x)  { return x > 0.0 ? x : 0.0; }
+    static inline double df(double x) { return x > 0.0 ? 1.0 : 0.0; }
+};
+
+/** @brief Leaky ReLU policy with a fixed 0.01 negative slope. */
+struct LeakyReLU {
+    static constexpr double slope = 0.01;
+    static inline double f(double x)  { return x > 0.0 ? x : slope * x; }
+    static inline double df(double x) { return x > 0.0 ? 1.0 : slope; }
+};
+
+/** @brief Hyperbolic tangent policy. */
+struct Tanh {
+    static inline double f(double x)  { return std::tanh(x); }
+    static inline double df(double x) { double t = std::tanh(x); return 1.0 - t * t; }
+};
+
+/** @brief Logistic sigmoid policy. */
+struct Sigmoid {
+    static inline double f(double x)  { return 1.0 / (1.0 + std::exp(-x)); }
+    static inline double df(double x) { double s = f(x); return s * (1.0 - s); }
+};
+
+/**
+ * @brief Invoke a generic functor with the policy type matching @p a.
+ *
+ * Usage: act::dispatch(a, [&](auto policy) { using P = decltype(policy); ... });
+ *
+ * @throws std::runtime_error for Activation::Custom (no compile-time policy)
+ */
+template <class Fn>
+inline void dispatch(Activation a, Fn&& fn) {
+    switch (a) {
+        case Activation::Linear:    fn(Linear{});    return;
+        case Activation::ReLU:      fn(ReLU{});      return;
+        case Activation::LeakyReLU: fn(LeakyReLU{}); return;
+        case Activation::Tanh:      fn(Tanh{});      return;
+        case Activation::Sigmoid:   fn(Sigmoid{});   return;
+        default: break;
+    }
+    throw std::runtime_error("act::dispatch - no policy for custom activation");
+}
+
+/** @brief Human readable name, used in error messages and tools. */
+inline std::string name(Activation a) {
+    switch (a) {
+        case Activation::Linear:    return "linear";
+        case Activation::ReLU:      return "relu";
+        case Activation::LeakyReLU: return "leaky_relu";
+        case Activation::Tanh:      return "tanh";
+        case Activation::Sigmoid:   return "sigmoid";
+        case Activation::Custom:    return "custom";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Parse a name produced by act::name().
+ * @throws std::runtime_error on unknown names
+ */
+inline Activation fromName(const std::string& s) {
+    if (s == "linear")     return Activation::Linear;
+    if (s == "relu")       return Activation::ReLU;
+    if (s == "leaky_relu") return Activation::LeakyReLU;
+    if (s == "tanh")       return Activation::Tanh;
+    if (s == "sigmoid")    return Activation::Sigmoid;
+    throw std::runtime_error("act::fromName - unknown activation '" + s + "'");
+}
+
+} // namespace act
+
+#endif // ACTIVATION_H
@@ -8,6 +8,7 @@
  * Responsibilities:
  *  - Own weights, biases, and activations
  *  - Perform forward and backward propagation
+ *  - Accumulate weight/bias gradients over mini-batches
  *
  * Not responsible for:
  *  - Training loops
@@ -21,7 +22,10 @@
 
 #include <functional>
 #include <fstream>
+#include <random>
 #include "Matrix.h"
+#include "Activation.h"
+#include "Optimizer.h"
 
 /**
  * @class Layer
@@ -34,8 +38,9 @@
  *  - Backward propagation
  *  - Weight & bias storage
  *
- * Activation functions and their derivatives are injected via std::function
- * to follow Dependency Inversion Principle (DIP) and maintain encapsulation.
+ * Activations are selected either through the Activation enum (fast path,
+ * kernels are specialized at compile time per policy) or injected via
+ * std::function (slow path, kept for custom activations).
  */
 class Layer {
 private:
@@ -47,11 +52,45 @@ private:
     Matrix<double> Z_;     ///< Weighted sums (W·X + B)
     Matrix<double> A_;     ///< Activations
     Matrix<double> lastInput_; ///< Cached input for backprop
+    Matrix<double> dZ_;    ///< Scratch: gradient w.r.t. Z for the last batch
+    Matrix<double> dW_;    ///< Accumulated weight gradient (neurons × inputs)
+    Matrix<double> dB_;    ///< Accumulated bias gradient (neurons × 1)
 
-    std::function<double(double)> activationFunc_;   ///< Activation function f(x)
-    std::function<double(double)> activationDeriv_;  ///< Derivative f'(x)
+    Activation activation_ = Activation::Custom;     ///< Built-in activation, or Custom
+    std::function<double(double)> activationFunc_;   ///< Activation function f(x) (Custom only)
+    std::function<double(double)> activationDeriv_;  ///< Derivative f'(x) (Custom only)
+
+    const double* viewW_ = nullptr; ///< External weights (e.g. mapped model), null if owned
+    const double* viewB_ = nullptr; ///< External biases, null if owned
+
+    /** @brief Copy external weights into owned storage (copy-on-write). */
+    void detach();
 
 public:
+    /**
+     * @brief Construct a fully-connected layer with a built-in activation.
+     * @param inputSize Number of input features
+     * @param neurons Number of neurons in this layer
+     * @param act Activation type (must not be Activation::Custom)
+     * @throws std::runtime_error if act is Activation::Custom
+     */
+    Layer(int inputSize, int neurons, Activation act);
+
+    /**
+     * @brief Construct a read-only view layer over external weight storage.
+     *
+     * No weight memory is allocated; W and B must outlive the layer (the
+     * owning NeuralNetwork keeps the mapping alive). Calling backward()
+     * first copies the weights into owned storage.
+     *
+     * @param inputSize Number of input features
+     * @param neurons Number of neurons in this layer
+     * @param act Activation type (must not be Activation::Custom)
+     * @param W Weights (neurons × inputs, row-major)
+     * @param B Biases (neurons)
+     */
+    Layer(int inputSize, int neurons, Activation act, const double* W, const double* B);
+
     /**
      * @brief Construct a fully-connected layer.
      * @param inputSize Number of input features
@@ -79,6 +118,36 @@ public:
      */
     Matrix<double> backward(const Matrix<double>& dC_dA, double lr);
 
+    /**
+     * @brief Backpropagate a batch and add its gradients to dW/dB.
+     *
+     * Weights are only read, so this also works on view layers; call
+     * applyGradients() once per step. Must follow a forward() on the same batch.
+     *
+     * @param dC_dA Gradient of cost w.r.t layer output (neurons × batchSize)
+     * @param dC_dX Receives the gradient w.r.t input (inputs × batchSize);
+     *              pass nullptr for the first layer to skip it
+     */
+    void backwardAccumulate(const Matrix<double>& dC_dA, Matrix<double>* dC_dX);
+
+    /** @brief Reset accumulated gradients to zero. */
+    void zeroGrad();
+
+    /**
+     * @brief Apply accumulated gradients with an optimizer.
+     * @param opt Optimizer
+     * @param slot Base slot id; weights use slot, biases slot + 1
+     */
+    void applyGradients(Optimizer& opt, std::size_t slot);
+
+    /** @brief Accumulated weight gradient (neurons × inputs) */
+    Matrix<double>& gradW() { return dW_; }
+    const Matrix<double>& gradW() const { return dW_; }
+
+    /** @brief Accumulated bias gradient (neurons × 1) */
+    Matrix<double>& gradB() { return dB_; }
+    const Matrix<double>& gradB() const { return dB_; }
+
     /**
      * @brief Get the output activations of the layer.
      * @return Constant reference to the activation matrix
@@ -102,6 +171,31 @@ public:
 
     /** @brief Number of neurons in this layer */
     int neurons() const { return neuronCount_; }
+
+    /** @brief Weights (neurons × inputs, row-major), owned or viewed */
+    const double* weights() const { return viewW_ ? viewW_ : W_.dataPtr(); }
+
+    /** @brief Biases (neurons), owned or viewed */
+    const double* biases() const { return viewB_ ? viewB_ : B_.dataPtr(); }
+
+    /**
+     * @brief Read weights from external storage, releasing owned weights.
+     * @param W Weights (neurons × inputs, row-major), must outlive the view
+     * @param B Biases (neurons)
+     */
+    void setView(const double* W, const double* B);
+
+    /**
+     * @brief Re-initialize weights (Glorot-uniform) and zero the biases.
+     * @param rng Random engine, for reproducible initialization
+     */
+    void randomize(std::mt19937& rng);
+
+    /** @brief Copy weights and biases from raw arrays into owned storage. */
+    void assign(const double* W, const double* B);
+
+    /** @brief Activation type, Activation::Custom for std::function layers */
+    Activation activation() const { return activation_; }
 };
 
 #endif // LAYER_H
\ No newline at end of file
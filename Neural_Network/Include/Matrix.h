@@ -149,7 +149,7 @@ public:
      * @param val Scalar value
      * @return Scaled matrix
      */
-    Matrix operator*(int val) const;
+    Matrix operator*(T val) const;
 
     // ---------------------------------------------------------------------
     // Structural operations
@@ -176,6 +176,20 @@ public:
      */
     static void multiply(const Matrix& a, const Matrix& b, Matrix& result);
 
+    /**
+     * @brief Raw row-major multiply: out = a * b
+     *
+     * Used by layers whose weights live outside a Matrix (mapped models).
+     *
+     * @param a Left operand (aRows × aCols)
+     * @param aRows Rows of a
+     * @param aCols Columns of a (= rows of b)
+     * @param b Right operand (aCols × bCols)
+     * @param bCols Columns of b
+     * @param out Output (aRows × bCols), must not alias a or b
+     */
+    static void multiply(const T* a, int aRows, int aCols, const T* b, int bCols, T* out);
+
     // ---------------------------------------------------------------------
     // I/O helpers
     // ---------------------------------------------------------------------
@@ -0,0 +1,160 @@
+/**
+ * @file ModelFile.h
+ * @brief Versioned, self-describing binary model format with mmap loading.
+ *
+ * @ingroup AI
+ *
+ * File layout (native byte order of the writing machine, recorded by
+ * ModelHeader::endian; every block aligned to MODEL_ALIGNMENT):
+ *  - ModelHeader         (64 bytes)  magic, version, dtype, shapes
+ *  - LayerRecord[n]      (32 bytes each) shape, activation, data offsets
+ *  - padding
+ *  - per layer: weights (neurons × inputs, row-major), padding,
+ *               biases (neurons), padding
+ *  - uint32 CRC-32 of every preceding byte
+ *
+ * Because weight blocks are aligned and stored in the exact in-memory layout
+ * used by Layer, a mapped file can be used for inference without copying,
+ * and many processes mapping the same file share the same physical pages.
+ *
+ * Files from a machine with the other byte order are rejected, as are
+ * version 1 files (no byte-order mark) on big-endian machines.
+ *
+ * Legacy files (raw doubles, no header) are still readable through
+ * NeuralNetwork::load(); see convert_model.cpp for a one-shot converter.
+ */
+
+#ifndef MODELFILE_H
+#define MODELFILE_H
+
+#include "Activation.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Layer;
+
+namespace model {
+
+constexpr char          MAGIC[4]        = { 'B', 'B', 'N', 'N' };
+constexpr std::uint32_t VERSION         = 2;
+constexpr std::uint32_t ENDIAN_MARK     = 0x01020304u;
+constexpr std::size_t   MODEL_ALIGNMENT = 64;
+
+/** @brief Element type of the stored weights. */
+enum class DType : std::uint32_t {
+    Float64 = 1 ///< IEEE-754 double
+};
+
+/**
+ * @struct ModelHeader
+ * @brief Fixed-size file header.
+ */
+struct ModelHeader {
+    char          magic[4];     ///< "BBNN"
+    std::uint32_t version;      ///< Format version (VERSION)
+    std::uint32_t dtype;        ///< DType of weight data
+    std::uint32_t layerCount;   ///< Number of LayerRecord entries
+    std::uint32_t inputSize;    ///< Inputs of the first layer
+    std::uint32_t headerSize;   ///< sizeof(ModelHeader), for forward compatibility
+    std::uint64_t fileSize;     ///< Total file size including the CRC footer
+    std::uint64_t dataOffset;   ///< Offset of the first weight block
+    std::uint32_t endian;       ///< ENDIAN_MARK in the writer's byte order (0 in version 1)
+    std::uint8_t  reserved[20]; ///< Zero
+};
+
+/**
+ * @struct LayerRecord
+ * @brief Per-layer shape and data location.
+ */
+struct LayerRecord {
+    std::uint32_t inputs;       ///< Input features
+    std::uint32_t neurons;      ///< Output neurons
+    std::uint8_t  activation;   ///< Activation enum value
+    std::uint8_t  pad[7];       ///< Zero
+    std::uint64_t weightOffset; ///< Byte offset of weights (neurons × inputs)
+    std::uint64_t biasOffset;   ///< Byte offset of biases (neurons)
+};
+
+static_assert(sizeof(ModelHeader) == 64, "ModelHeader must be 64 bytes");
+static_assert(sizeof(LayerRecord) == 32, "LayerRecord must be 32 bytes");
+
+/**
+ * @brief Standard CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320).
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ * @param crc Running value from a previous call (0 to start)
+ */
+std::uint32_t crc32(const void* data, std::size_t len, std::uint32_t crc = 0);
+
+/**
+ * @brief Check whether a file starts with the model magic.
+ * @param filename File path
+ * @return false for missing files and legacy raw-double files
+ */
+bool isModelFile(const std::string& filename);
+
+/**
+ * @brief Write layers to a model file.
+ * @param filename File path
+ * @param layers Layers in forward order
+ * @throws std::runtime_error on I/O failure
+ */
+void write(const std::string& filename, const std::vector<Layer>& layers);
+
+/**
+ * @class MappedModel
+ * @brief Read-only memory mapping of a model file.
+ *
+ * Validates the header, the layer table and (optionally) the CRC on open,
+ * then exposes zero-copy pointers into the mapping. Non-copyable; share it
+ * through std::shared_ptr.
+ */
+class MappedModel {
+public:
+    /**
+     * @brief Map and validate a model file.
+     * @param filename File path
+     * @param verifyChecksum Verify the trailing CRC (reads every page once)
+     * @throws std::runtime_error if the file is missing, truncated or corrupt
+     */
+    explicit MappedModel(const std::string& filename, bool verifyChecksum = true);
+    ~MappedModel();
+
+    MappedModel(const MappedModel&) = delete;
+    MappedModel& operator=(const MappedModel&) = delete;
+
+    /** @brief Parsed header */
+    const ModelHeader& header() const { return *header_; }
+
+    /** @brief Number of layers */
+    std::size_t layerCount() const { return header_->layerCount; }
+
+    /** @brief Layer record i */
+    const LayerRecord& layer(std::size_t i) const { return records_[i]; }
+
+    /** @brief Weights of layer i (neurons × inputs, row-major) */
+    const double* weights(std::size_t i) const;
+
+    /** @brief Biases of layer i (neurons) */
+    const double* biases(std::size_t i) const;
+
+private:
+    const std::uint8_t* base_ = nullptr;   ///< Start of the mapping
+    std::size_t size_ = 0;                 ///< Mapping size in bytes
+    const ModelHeader* header_ = nullptr;  ///< Header view
+    const LayerRecord* records_ = nullptr; ///< Layer table view
+
+#ifdef _WIN32
+    void* file_ = nullptr;                 ///< HANDLE of the file
+    void* mapping_ = nullptr;              ///< HANDLE of the mapping
+#endif
+
+    void validate(bool verifyChecksum);
+    void unmap();
+};
+
+} // namespace model
+
+#endif // MODELFILE_H
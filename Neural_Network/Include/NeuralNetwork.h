@@ -8,7 +8,8 @@
  * Responsibilities:
  *  - Maintain an ordered list of Layers
  *  - Perform forward and backward propagation
- *  - Update weights using gradient descent
+ *  - Update weights using gradient descent or a pluggable Optimizer
+ *  - Mini-batch training with gradient accumulation
  *  - Save/load network parameters
  */
 
@@ -17,6 +18,9 @@
 
 #include "Matrix.h"
 #include "Layer.h"
+#include "ModelFile.h"
+#include "Optimizer.h"
+#include <memory>
 #include <vector>
 #include <functional>
 #include <fstream>
@@ -45,6 +49,18 @@ public:
                   const std::vector<std::function<double(double)>>& activations,
                   const std::vector<std::function<double(double)>>& activationDerivatives);
 
+    /**
+     * @brief Construct a feedforward neural network with built-in activations.
+     *
+     * Preferred over the std::function overload: the per-neuron kernels are
+     * specialized at compile time and the activation types can be persisted.
+     *
+     * @param layerSizes Number of neurons in each layer (including input and output)
+     * @param activations Activation type for each layer (excluding input layer)
+     */
+    NeuralNetwork(const std::vector<int>& layerSizes,
+                  const std::vector<Activation>& activations);
+
     /**
      * @brief Perform a forward pass through all layers.
      * @param input Input vector (Matrix<double>, inputSize × 1)
@@ -67,6 +83,48 @@ public:
      */
     void train(const Matrix<double>& input, const Matrix<double>& expected, double learningRate);
 
+    /**
+     * @brief Forward and backward a mini-batch, adding gradients to every layer.
+     *
+     * Loss is 0.5·||A - Y||² per sample. Gradients are multiplied by
+     * @p scale, so callers splitting one logical batch across several calls
+     * pass 1 / totalBatchSize to every call.
+     *
+     * @param inputs Batch inputs (inputSize × N, one sample per column)
+     * @param targets Batch targets (outputSize × N)
+     * @param scale Gradient/loss scale (typically 1 / N)
+     * @return Scaled loss summed over the batch
+     */
+    double accumulateGradients(const Matrix<double>& inputs,
+                               const Matrix<double>& targets,
+                               double scale);
+
+    /**
+     * @brief Apply accumulated gradients with @p opt and reset them.
+     * @param opt Optimizer (keeps per-layer state across calls)
+     */
+    void applyGradients(Optimizer& opt);
+
+    /**
+     * @brief Re-initialize all layers deterministically.
+     * @param seed Seed for the weight initializer
+     */
+    void randomize(std::uint32_t seed);
+
+    /** @brief Reset accumulated gradients of every layer. */
+    void zeroGrad();
+
+    /**
+     * @brief One optimizer step on a mini-batch (mean gradient).
+     * @param inputs Batch inputs (inputSize × N)
+     * @param targets Batch targets (outputSize × N)
+     * @param opt Optimizer
+     * @return Mean loss over the batch
+     */
+    double trainBatch(const Matrix<double>& inputs,
+                      const Matrix<double>& targets,
+                      Optimizer& opt);
+
     /**
      * @brief Predict output from a given input without weight updates.
      * @param input Input vector
@@ -75,19 +133,67 @@ public:
     Matrix<double> predict(const Matrix<double>& input);
 
     /**
-     * @brief Save all layer parameters (weights and biases) to a binary file.
+     * @brief Forward pass starting at a given layer.
+     *
+     * Used when the earlier layers are computed elsewhere, e.g. by an
+     * incrementally updated first layer (see Accumulator.h).
+     *
+     * @param first Index of the first layer to run
+     * @param activations Output of layer first - 1 (or the input if first is 0)
+     * @return Output activations from the final layer
+     */
+    Matrix<double> forwardFrom(std::size_t first, const Matrix<double>& activations);
+
+    /**
+     * @brief Save the network (shapes, activations, weights) in the model format.
      * @param filename File path
+     * @see ModelFile.h
      */
     void save(const std::string& filename) const;
 
     /**
-     * @brief Load all layer parameters from a binary file.
+     * @brief Save only raw weights and biases (legacy headerless format).
+     * @param filename File path
+     */
+    void saveLegacy(const std::string& filename) const;
+
+    /**
+     * @brief Load all layer parameters from a binary file into this network.
+     *
+     * Accepts both the model format (shapes and activations are checked
+     * against this network) and the legacy raw-double format (the file
+     * size must match this network exactly). Weights are copied into
+     * owned storage.
+     *
      * @param filename File path
+     * @throws std::runtime_error on I/O error or architecture mismatch
      */
     void load(const std::string& filename);
 
+    /**
+     * @brief Open a model file and build the network it describes.
+     *
+     * The file is memory-mapped and layers read weights directly from the
+     * mapping (zero-copy), so processes opening the same file share its
+     * pages. Training the returned network copies weights on first update.
+     *
+     * @param filename File in the model format
+     * @param verifyChecksum Verify the trailing CRC
+     * @return Network that keeps the mapping alive
+     * @throws std::runtime_error if the file is not a valid model file
+     */
+    static std::shared_ptr<NeuralNetwork> open(const std::string& filename,
+                                               bool verifyChecksum = true);
+
+    /** @brief Read-only access to the layers */
+    const std::vector<Layer>& layers() const { return layers_; }
+    std::vector<Layer>& layers() { return layers_; }
+
 private:
+    NeuralNetwork() = default;
+
     std::vector<Layer> layers_; ///< Container for layers (encapsulation)
+    std::shared_ptr<const model::MappedModel> mapping_; ///< Backing storage of view layers, if any
 };
 
 #endif // NEURALNETWORK_H
\ No newline at end of file
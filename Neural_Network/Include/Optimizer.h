@@ -0,0 +1,103 @@
+/**
+ * @file Optimizer.h
+ * @brief Parameter update rules for neural network training.
+ *
+ * @ingroup AI
+ *
+ * Responsibilities:
+ *  - Turn accumulated gradients into in-place parameter updates
+ *  - Own per-parameter optimizer state (velocity, moments)
+ *  - Apply weight decay
+ *
+ * Each parameter block (a layer's weights or biases) is identified by a
+ * slot index; state for a slot is allocated lazily on its first update.
+ */
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class Optimizer
+ * @brief Abstract optimizer interface.
+ *
+ * @ingroup AI
+ */
+class Optimizer {
+public:
+    /**
+     * @param learningRate Step size
+     * @param weightDecay Decay coefficient applied to weight blocks only
+     */
+    explicit Optimizer(double learningRate, double weightDecay = 0.0)
+        : learningRate(learningRate), weightDecay(weightDecay) {}
+
+    virtual ~Optimizer() = default;
+
+    /** @brief Called once before the updates of a training step. */
+    virtual void beginStep() {}
+
+    /**
+     * @brief Update one parameter block in place.
+     * @param slot Stable id of the block (2 per layer: weights, biases)
+     * @param param Parameters to update
+     * @param grad Gradient of the loss w.r.t. param
+     * @param n Number of elements
+     * @param decay Apply weight decay to this block
+     */
+    virtual void update(std::size_t slot, double* param, const double* grad,
+                        std::size_t n, bool decay) = 0;
+
+    double learningRate; ///< Step size
+    double weightDecay;  ///< Weight decay coefficient (0 disables)
+};
+
+/**
+ * @class SGD
+ * @brief Stochastic gradient descent with optional (heavy-ball) momentum.
+ *
+ * v = momentum·v + g + wd·p,  p -= lr·v
+ */
+class SGD : public Optimizer {
+public:
+    explicit SGD(double learningRate, double momentum = 0.0, double weightDecay = 0.0)
+        : Optimizer(learningRate, weightDecay), momentum(momentum) {}
+
+    void update(std::size_t slot, double* param, const double* grad,
+                std::size_t n, bool decay) override;
+
+    double momentum; ///< Momentum coefficient (0 = plain SGD)
+
+private:
+    std::vector<std::vector<double>> velocity_; ///< Per-slot velocity
+};
+
+/**
+ * @class Adam
+ * @brief Adam with bias correction and decoupled weight decay (AdamW).
+ */
+class Adam : public Optimizer {
+public:
+    explicit Adam(double learningRate = 1e-3, double beta1 = 0.9, double beta2 = 0.999,
+                  double epsilon = 1e-8, double weightDecay = 0.0)
+        : Optimizer(learningRate, weightDecay), beta1(beta1), beta2(beta2), epsilon(epsilon) {}
+
+    void beginStep() override;
+
+    void update(std::size_t slot, double* param, const double* grad,
+                std::size_t n, bool decay) override;
+
+    double beta1;   ///< First moment decay
+    double beta2;   ///< Second moment decay
+    double epsilon; ///< Numerical stabilizer
+
+private:
+    long long t_ = 0;                    ///< Step counter for bias correction
+    double corr1_ = 1.0, corr2_ = 1.0;   ///< 1 - beta^t for the current step
+    std::vector<std::vector<double>> m_; ///< Per-slot first moment
+    std::vector<std::vector<double>> v_; ///< Per-slot second moment
+};
+
+#endif // OPTIMIZER_H
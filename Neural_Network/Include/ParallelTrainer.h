@@ -0,0 +1,111 @@
+/**
+ * @file ParallelTrainer.h
+ * @brief Data-parallel mini-batch training across worker threads.
+ *
+ * @ingroup AI
+ *
+ * Responsibilities:
+ *  - Shard each mini-batch across worker threads
+ *  - Keep one gradient buffer set per worker (replica layers)
+ *  - Reduce worker gradients with a fixed-shape tree reduction
+ *  - Apply a single optimizer step on the master network
+ *
+ * Replicas read weights directly from the master network (view layers), so
+ * no weights are copied between steps. Shard boundaries and the reduction
+ * order depend only on the batch size and the thread count, so results are
+ * bit-for-bit reproducible for a fixed seed and thread count.
+ */
+
+#ifndef PARALLELTRAINER_H
+#define PARALLELTRAINER_H
+
+#include "NeuralNetwork.h"
+#include "Optimizer.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ParallelTrainer
+ * @brief Trains a NeuralNetwork on mini-batches using all cores.
+ *
+ * @ingroup AI
+ */
+class ParallelTrainer {
+public:
+    /**
+     * @brief Create a trainer bound to a network.
+     * @param net Network to train (must outlive the trainer)
+     * @param threads Worker count, 0 = hardware concurrency
+     */
+    explicit ParallelTrainer(NeuralNetwork& net, int threads = 0);
+    ~ParallelTrainer();
+
+    ParallelTrainer(const ParallelTrainer&) = delete;
+    ParallelTrainer& operator=(const ParallelTrainer&) = delete;
+
+    /**
+     * @brief One optimizer step on a mini-batch (mean gradient).
+     * @param inputs Batch inputs (inputSize × N)
+     * @param targets Batch targets (outputSize × N)
+     * @param opt Optimizer
+     * @return Mean loss over the batch
+     */
+    double step(const Matrix<double>& inputs, const Matrix<double>& targets, Optimizer& opt);
+
+    /**
+     * @brief One pass over a dataset in shuffled mini-batches.
+     * @param inputs All inputs (inputSize × samples)
+     * @param targets All targets (outputSize × samples)
+     * @param batchSize Samples per optimizer step
+     * @param opt Optimizer
+     * @param rng Shuffle engine (seed it for reproducible runs)
+     * @return Mean loss over the epoch
+     */
+    double epoch(const Matrix<double>& inputs, const Matrix<double>& targets,
+                 int batchSize, Optimizer& opt, std::mt19937& rng);
+
+    /** @brief Number of worker threads (including the calling thread). */
+    int threads() const { return int(replicas_.size()); }
+
+    /**
+     * @brief Copy selected columns of a matrix.
+     * @param src Source matrix
+     * @param cols Column indices
+     * @param begin First index in cols
+     * @param end One past the last index in cols
+     * @param dst Receives src.rows × (end - begin)
+     */
+    static void gatherColumns(const Matrix<double>& src, const std::vector<int>& cols,
+                              size_t begin, size_t end, Matrix<double>& dst);
+
+private:
+    NeuralNetwork& net_;                  ///< Master network (owns weights)
+    std::vector<NeuralNetwork> replicas_; ///< Per-worker views + gradient buffers
+    std::vector<Matrix<double>> shardX_;  ///< Per-worker input shard
+    std::vector<Matrix<double>> shardY_;  ///< Per-worker target shard
+    std::vector<double> shardLoss_;       ///< Per-worker loss
+    std::vector<int> order_;              ///< Scratch column order
+
+    // Persistent worker pool: workers 1..n-1 run on threads, 0 on the caller
+    std::vector<std::thread> pool_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::function<void(int)> task_;
+    unsigned long long generation_ = 0;
+    int pending_ = 0;
+    bool stop_ = false;
+
+    double train(const Matrix<double>& inputs, const Matrix<double>& targets,
+                 int batchSize, Optimizer& opt);
+    void bindReplicas();
+    void reduce();
+    void runParallel(const std::function<void(int)>& task);
+    void workerLoop(int id);
+};
+
+#endif // PARALLELTRAINER_H
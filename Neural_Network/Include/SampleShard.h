@@ -0,0 +1,142 @@
+/**
+ * @file SampleShard.h
+ * @brief Compact streaming binary format for training samples.
+ *
+ * @ingroup AI
+ *
+ * A shard holds fixed-size records of (encoded position, target vector):
+ *  - ShardHeader (32 bytes): magic "BBSD", version, input/output sizes,
+ *    record count
+ *  - records: int8 inputs[inputSize] followed by float targets[outputSize]
+ *  - uint32 CRC-32 of all records
+ *
+ * Inputs are small integers (board encodings use -1/0/1), so one byte per
+ * input keeps a 5x5 sample at 125 bytes. Writers append records as they are
+ * produced and patch the count on close; readers stream records in batches
+ * without loading the whole file.
+ */
+
+#ifndef SAMPLESHARD_H
+#define SAMPLESHARD_H
+
+#include "Matrix.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace shard {
+
+constexpr char          MAGIC[4] = { 'B', 'B', 'S', 'D' };
+constexpr std::uint32_t VERSION  = 1;
+
+/**
+ * @struct ShardHeader
+ * @brief Fixed-size shard header.
+ */
+struct ShardHeader {
+    char          magic[4];    ///< "BBSD"
+    std::uint32_t version;     ///< Format version (VERSION)
+    std::uint32_t inputSize;   ///< int8 inputs per record
+    std::uint32_t outputSize;  ///< float targets per record
+    std::uint64_t count;       ///< Number of records
+    std::uint8_t  reserved[8]; ///< Zero
+};
+
+static_assert(sizeof(ShardHeader) == 32, "ShardHeader must be 32 bytes");
+
+/**
+ * @brief Check whether a file starts with the shard magic.
+ * @param filename File path
+ */
+bool isShardFile(const std::string& filename);
+
+/**
+ * @class ShardWriter
+ * @brief Appends samples to a shard file.
+ */
+class ShardWriter {
+public:
+    /**
+     * @brief Create (truncate) a shard file.
+     * @throws std::runtime_error if the file cannot be created
+     */
+    ShardWriter(const std::string& filename, int inputSize, int outputSize);
+
+    /** @brief Finalizes the file if close() was not called. */
+    ~ShardWriter();
+
+    ShardWriter(const ShardWriter&) = delete;
+    ShardWriter& operator=(const ShardWriter&) = delete;
+
+    /**
+     * @brief Append one record.
+     * @param inputs inputSize encoded values
+     * @param targets outputSize target values
+     */
+    void append(const std::int8_t* inputs, const float* targets);
+
+    /** @brief Write the CRC footer and patch the record count. */
+    void close();
+
+    /** @brief Records written so far */
+    std::uint64_t count() const { return count_; }
+
+private:
+    std::ofstream out_;
+    std::string filename_;
+    int inputSize_, outputSize_;
+    std::uint64_t count_ = 0;
+    std::uint32_t crc_ = 0;
+    std::vector<char> record_; ///< Scratch record buffer
+};
+
+/**
+ * @class ShardReader
+ * @brief Streams records from a shard file in batches.
+ */
+class ShardReader {
+public:
+    /**
+     * @brief Open a shard and validate its header.
+     * @throws std::runtime_error on missing or malformed files
+     */
+    explicit ShardReader(const std::string& filename);
+
+    /** @brief int8 inputs per record */
+    int inputSize() const { return int(header_.inputSize); }
+
+    /** @brief float targets per record */
+    int outputSize() const { return int(header_.outputSize); }
+
+    /** @brief Total records in the shard */
+    std::uint64_t count() const { return header_.count; }
+
+    /** @brief Records not yet read */
+    std::uint64_t remaining() const { return header_.count - read_; }
+
+    /**
+     * @brief Read up to maxRecords samples as columns.
+     *
+     * The CRC is verified once the last record has been read.
+     *
+     * @param maxRecords Upper bound on samples read
+     * @param inputs Receives inputSize × n
+     * @param targets Receives outputSize × n
+     * @return n, 0 at end of shard
+     * @throws std::runtime_error on truncation or checksum mismatch
+     */
+    int read(int maxRecords, Matrix<double>& inputs, Matrix<double>& targets);
+
+private:
+    std::ifstream in_;
+    std::string filename_;
+    ShardHeader header_{};
+    std::uint64_t read_ = 0;
+    std::uint32_t crc_ = 0;
+    std::vector<char> buffer_; ///< Scratch batch buffer
+};
+
+} // namespace shard
+
+#endif // SAMPLESHARD_H
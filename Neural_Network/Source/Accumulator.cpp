@@ -0,0 +1,59 @@
+#include "../Include/Accumulator.h"
+#include <algorithm>
+#include <stdexcept>
+
+Accumulator::Accumulator(std::shared_ptr<NeuralNetwork> net)
+    : net_(std::move(net))
+{
+    if (!net_ || net_->layers().empty())
+        throw std::runtime_error("Accumulator: network has no layers");
+
+    const Layer& first = net_->layers().front();
+    if (first.activation() == Activation::Custom)
+        throw std::runtime_error("Accumulator: first layer needs a built-in activation");
+
+    inputs_  = first.inputs();
+    neurons_ = first.neurons();
+
+    // Transpose so each input's weights are contiguous
+    auto columns = std::make_shared<std::vector<double>>(size_t(inputs_) * neurons_);
+    const double* w = first.weights();
+    for (int r = 0; r < neurons_; r++)
+        for (int k = 0; k < inputs_; k++)
+            (*columns)[size_t(k) * neurons_ + r] = w[size_t(r) * inputs_ + k];
+    columns_ = std::move(columns);
+
+    sum_.assign(neurons_, 0.0);
+    hidden_.resize(neurons_, 1);
+}
+
+void Accumulator::clear() {
+    std::fill(sum_.begin(), sum_.end(), 0.0);
+}
+
+void Accumulator::refresh(const double* input) {
+    clear();
+    for (int k = 0; k < inputs_; k++)
+        if (input[k] != 0.0) add(k, input[k]);
+}
+
+void Accumulator::add(int input, double delta) {
+    const double* col = columns_->data() + size_t(input) * neurons_;
+    double* s = sum_.data();
+    for (int r = 0; r < neurons_; r++)
+        s[r] += delta * col[r];
+}
+
+Matrix<double> Accumulator::evaluate(double scale) {
+    const Layer& first = net_->layers().front();
+    const double* b = first.biases();
+    double* h = hidden_.dataPtr();
+
+    act::dispatch(first.activation(), [&](auto policy) {
+        using P = decltype(policy);
+        for (int r = 0; r < neurons_; r++)
+            h[r] = P::f(scale * sum_[r] + b[r]);
+    });
+
+    return net_->forwardFrom(1, hidden_);
+}
@@ -1,6 +1,8 @@
 #include "../Include/Layer.h"
 #include <stdexcept>
 #include <fstream>
+#include <algorithm>
+#include <cmath>
 
 Layer::Layer(int inputSize,
              int neuronCount,
@@ -17,55 +19,218 @@ Layer::Layer(int inputSize,
       activationDeriv_(actDeriv)
 {}
 
+Layer::Layer(int inputSize, int neuronCount, Activation act)
+    : inputSize_(inputSize),
+      neuronCount_(neuronCount),
+      W_(Matrix<double>::random(neuronCount_, inputSize_, -1.0, 1.0)),
+      B_(Matrix<double>::random(neuronCount_, 1, -1.0, 1.0)),
+      Z_(neuronCount_, 1),
+      A_(neuronCount_, 1),
+      lastInput_(inputSize_, 1),
+      activation_(act)
+{
+    if (act == Activation::Custom)
+        throw std::runtime_error("Layer: custom activation requires std::function overload");
+}
+
+Layer::Layer(int inputSize, int neuronCount, Activation act, const double* W, const double* B)
+    : inputSize_(inputSize),
+      neuronCount_(neuronCount),
+      Z_(neuronCount_, 1),
+      A_(neuronCount_, 1),
+      lastInput_(inputSize_, 1),
+      activation_(act),
+      viewW_(W),
+      viewB_(B)
+{
+    if (act == Activation::Custom)
+        throw std::runtime_error("Layer: custom activation requires std::function overload");
+}
+
+void Layer::assign(const double* W, const double* B) {
+    W_.resize(neuronCount_, inputSize_);
+    B_.resize(neuronCount_, 1);
+    std::copy(W, W + W_.data.size(), W_.data.begin());
+    std::copy(B, B + B_.data.size(), B_.data.begin());
+    viewW_ = viewB_ = nullptr;
+}
+
+void Layer::setView(const double* W, const double* B) {
+    W_ = Matrix<double>();
+    B_ = Matrix<double>();
+    viewW_ = W;
+    viewB_ = B;
+}
+
+void Layer::randomize(std::mt19937& rng) {
+    detach();
+    const double limit = std::sqrt(6.0 / (inputSize_ + neuronCount_));
+    std::uniform_real_distribution<double> dist(-limit, limit);
+    for (auto& v : W_.data) v = dist(rng);
+    for (auto& v : B_.data) v = 0.0;
+}
+
+void Layer::detach() {
+    if (viewW_) assign(viewW_, viewB_);
+}
+
+/*--------------------------------------------------------------
+ | Activation kernels (specialized per policy at compile time)
+ *-------------------------------------------------------------*/
+
+namespace {
+
+template <class P>
+void activateKernel(const double* z, double* a, int n) {
+    for (int i = 0; i < n; i++)
+        a[i] = P::f(z[i]);
+}
+
+template <class P>
+void derivKernel(const double* z, double* dz, int n) {
+    for (int i = 0; i < n; i++)
+        dz[i] *= P::df(z[i]);
+}
+
+} // namespace
+
 const Matrix<double>& Layer::forward(const Matrix<double>& input) {
     lastInput_ = input;
 
-    Matrix<double>::multiply(W_, input, Z_);
+    if (input.rows != inputSize_)
+        throw std::runtime_error("Layer::forward - input size mismatch");
+
+    Z_.resize(neuronCount_, input.cols);
+    Matrix<double>::multiply(weights(), neuronCount_, inputSize_,
+                             input.dataPtr(), input.cols, Z_.dataPtr());
 
-    Z_ = Z_ + B_;
+    // Z += B, broadcast over batch columns
+    const double* b = biases();
+    for (int r = 0; r < Z_.rows; r++)
+        for (int c = 0; c < Z_.cols; c++)
+            Z_(r, c) += b[r];
 
-    A_ = Z_;
-    A_.apply(activationFunc_);
+    A_.resize(Z_.rows, Z_.cols);
+    const int n = Z_.rows * Z_.cols;
+
+    if (activation_ == Activation::Custom) {
+        for (int i = 0; i < n; i++)
+            A_.data[i] = activationFunc_(Z_.data[i]);
+    }
+    else {
+        act::dispatch(activation_, [&](auto policy) {
+            activateKernel<decltype(policy)>(Z_.dataPtr(), A_.dataPtr(), n);
+        });
+    }
 
     return A_;
 }
 
 Matrix<double> Layer::backward(const Matrix<double>& dC_dA, double lr) {
-    Matrix<double> dZ = dC_dA;
-    for (int i = 0; i < neuronCount_; i++)
-        dZ(i, 0) *= activationDeriv_(Z_(i, 0));
-
-    Matrix<double> X_T = lastInput_.transpose();
-    Matrix<double> deltaW(neuronCount_, inputSize_);
-    Matrix<double>::multiply(dZ, X_T, deltaW);
+    Matrix<double> dC_dX;
 
-    W_ = W_ - deltaW * lr;
+    detach();
+    zeroGrad();
+    backwardAccumulate(dC_dA, &dC_dX);
 
-    B_ = B_ - dZ * lr;
-
-    Matrix<double> W_T = W_.transpose();
-    Matrix<double> dC_dX(inputSize_, 1);
-    Matrix<double>::multiply(W_T, dZ, dC_dX);
+    // Plain SGD step, in place
+    for (size_t i = 0; i < W_.data.size(); i++)
+        W_.data[i] -= lr * dW_.data[i];
+    for (size_t i = 0; i < B_.data.size(); i++)
+        B_.data[i] -= lr * dB_.data[i];
 
     return dC_dX;
 }
 
-void Layer::save(std::ofstream& out) const {
-    for (int i = 0; i < W_.rows; i++)
-        for (int j = 0; j < W_.cols; j++) {
-            double v = W_(i, j);
-            out.write((char*)&v, sizeof(double));
+void Layer::backwardAccumulate(const Matrix<double>& dC_dA, Matrix<double>* dC_dX) {
+    if (dC_dA.rows != neuronCount_ || dC_dA.cols != Z_.cols)
+        throw std::runtime_error("Layer::backwardAccumulate - gradient shape mismatch");
+
+    if (dW_.rows != neuronCount_ || dW_.cols != inputSize_) zeroGrad();
+
+    const int batch = Z_.cols;
+    const int n = neuronCount_ * batch;
+
+    // dZ = dC/dA ⊙ f'(Z)
+    dZ_ = dC_dA;
+    if (activation_ == Activation::Custom) {
+        for (int i = 0; i < n; i++)
+            dZ_.data[i] *= activationDeriv_(Z_.data[i]);
+    }
+    else {
+        act::dispatch(activation_, [&](auto policy) {
+            derivKernel<decltype(policy)>(Z_.dataPtr(), dZ_.dataPtr(), n);
+        });
+    }
+
+    const double* dz = dZ_.dataPtr();
+    const double* x  = lastInput_.dataPtr();
+    const double* w  = weights();
+    double* dw = dW_.dataPtr();
+    double* db = dB_.dataPtr();
+
+    // dW += dZ · Xᵀ, dB += Σ_batch dZ (no explicit transposes)
+    for (int r = 0; r < neuronCount_; r++) {
+        const double* dzRow = dz + r * batch;
+        double* dwRow = dw + r * inputSize_;
+        double bSum = 0.0;
+
+        for (int c = 0; c < batch; c++) bSum += dzRow[c];
+        db[r] += bSum;
+
+        for (int k = 0; k < inputSize_; k++) {
+            const double* xRow = x + k * batch;
+            double sum = 0.0;
+            for (int c = 0; c < batch; c++) sum += dzRow[c] * xRow[c];
+            dwRow[k] += sum;
         }
+    }
 
-    for (int i = 0; i < B_.rows; i++) {
-        double v = B_(i, 0);
-        out.write((char*)&v, sizeof(double));
+    if (!dC_dX) return;
+
+    // dC/dX = Wᵀ · dZ, using the weights before this step's update
+    dC_dX->resize(inputSize_, batch);
+    std::fill(dC_dX->data.begin(), dC_dX->data.end(), 0.0);
+    double* dx = dC_dX->dataPtr();
+
+    for (int r = 0; r < neuronCount_; r++) {
+        const double* dzRow = dz + r * batch;
+        const double* wRow  = w + r * inputSize_;
+        for (int k = 0; k < inputSize_; k++) {
+            const double wk = wRow[k];
+            double* dxRow = dx + k * batch;
+            for (int c = 0; c < batch; c++) dxRow[c] += wk * dzRow[c];
+        }
     }
 }
 
+void Layer::zeroGrad() {
+    dW_.resize(neuronCount_, inputSize_);
+    dB_.resize(neuronCount_, 1);
+    std::fill(dW_.data.begin(), dW_.data.end(), 0.0);
+    std::fill(dB_.data.begin(), dB_.data.end(), 0.0);
+}
+
+void Layer::applyGradients(Optimizer& opt, std::size_t slot) {
+    detach();
+    if (dW_.rows != neuronCount_ || dW_.cols != inputSize_) zeroGrad();
+
+    opt.update(slot,     W_.dataPtr(), dW_.dataPtr(), W_.data.size(), true);
+    opt.update(slot + 1, B_.dataPtr(), dB_.dataPtr(), B_.data.size(), false);
+}
+
+void Layer::save(std::ofstream& out) const {
+    out.write((const char*)weights(), sizeof(double) * neuronCount_ * inputSize_);
+    out.write((const char*)biases(), sizeof(double) * neuronCount_);
+}
+
 void Layer::load(std::ifstream& in) {
     if (!in) throw std::runtime_error("Layer::load - bad input stream");
 
+    W_.resize(neuronCount_, inputSize_);
+    B_.resize(neuronCount_, 1);
+    viewW_ = viewB_ = nullptr;
+
     for (int i = 0; i < W_.rows; i++) {
         for (int j = 0; j < W_.cols; j++) {
             double v;
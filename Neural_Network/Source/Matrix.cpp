@@ -118,15 +118,20 @@ void Matrix<T>::multiply(const Matrix<T>& a, const Matrix<T>& b, Matrix<T>& resu
 
     result.resize(a.rows, b.cols);
 
-    for (int r = 0; r < a.rows; r++) {
-        for (int c = 0; c < b.cols; c++) {
+    multiply(a.dataPtr(), a.rows, a.cols, b.dataPtr(), b.cols, result.dataPtr());
+}
+
+template <class T>
+void Matrix<T>::multiply(const T* a, int aRows, int aCols, const T* b, int bCols, T* out) {
+    for (int r = 0; r < aRows; r++) {
+        for (int c = 0; c < bCols; c++) {
 
             T sum = T(0);
 
-            for (int k = 0; k < a.cols; k++)
-                sum += a.data[r * a.cols + k] * b.data[k * b.cols + c];
+            for (int k = 0; k < aCols; k++)
+                sum += a[r * aCols + k] * b[k * bCols + c];
 
-            result.data[r * result.cols + c] = sum;
+            out[r * bCols + c] = sum;
         }
     }
 }
@@ -143,7 +148,7 @@ Matrix<T> Matrix<T>::operator*(const Matrix<T>& other) const {
  *-------------------------------------------------------------*/
 
 template <class T>
-Matrix<T> Matrix<T>::operator*(const int val) const {
+Matrix<T> Matrix<T>::operator*(const T val) const {
     Matrix<T> res(rows, cols);
     for (int i = 0; i < rows * cols; i++)
         res.data[i] = data[i] * val;
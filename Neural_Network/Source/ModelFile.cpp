@@ -0,0 +1,263 @@
+#include "../Include/ModelFile.h"
+#include "../Include/Layer.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace model {
+
+/*--------------------------------------------------------------
+ | CRC-32
+ *-------------------------------------------------------------*/
+
+namespace {
+
+struct CrcTable {
+    std::uint32_t t[256];
+    CrcTable() {
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            t[i] = c;
+        }
+    }
+};
+
+std::uint64_t alignUp(std::uint64_t v) {
+    return (v + MODEL_ALIGNMENT - 1) & ~std::uint64_t(MODEL_ALIGNMENT - 1);
+}
+
+bool littleEndian() {
+    const std::uint32_t one = 1;
+    std::uint8_t first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+} // namespace
+
+std::uint32_t crc32(const void* data, std::size_t len, std::uint32_t crc) {
+    static const CrcTable table;
+    const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < len; i++)
+        crc = table.t[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/*--------------------------------------------------------------
+ | Detection
+ *-------------------------------------------------------------*/
+
+bool isModelFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4] = {};
+    if (!in.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+/*--------------------------------------------------------------
+ | Writer
+ *-------------------------------------------------------------*/
+
+void write(const std::string& filename, const std::vector<Layer>& layers) {
+    if (layers.empty())
+        throw std::runtime_error("model::write - network has no layers");
+
+    ModelHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version    = VERSION;
+    header.endian     = ENDIAN_MARK;
+    header.dtype      = static_cast<std::uint32_t>(DType::Float64);
+    header.layerCount = static_cast<std::uint32_t>(layers.size());
+    header.inputSize  = static_cast<std::uint32_t>(layers.front().inputs());
+    header.headerSize = sizeof(ModelHeader);
+
+    // Lay out the data blocks
+    std::vector<LayerRecord> records(layers.size());
+    std::uint64_t offset = alignUp(sizeof(ModelHeader) + records.size() * sizeof(LayerRecord));
+    header.dataOffset = offset;
+
+    for (size_t i = 0; i < layers.size(); i++) {
+        LayerRecord& rec = records[i];
+        rec = LayerRecord{};
+        rec.inputs       = static_cast<std::uint32_t>(layers[i].inputs());
+        rec.neurons      = static_cast<std::uint32_t>(layers[i].neurons());
+        rec.activation   = static_cast<std::uint8_t>(layers[i].activation());
+        rec.weightOffset = offset;
+        offset = alignUp(offset + std::uint64_t(rec.inputs) * rec.neurons * sizeof(double));
+        rec.biasOffset   = offset;
+        offset = alignUp(offset + std::uint64_t(rec.neurons) * sizeof(double));
+    }
+    header.fileSize = offset + sizeof(std::uint32_t);
+
+    // Serialize into one buffer so the CRC covers exactly what is written
+    std::vector<std::uint8_t> buf(static_cast<size_t>(offset), 0);
+    std::memcpy(buf.data(), &header, sizeof(header));
+    std::memcpy(buf.data() + sizeof(header), records.data(), records.size() * sizeof(LayerRecord));
+
+    for (size_t i = 0; i < layers.size(); i++) {
+        const LayerRecord& rec = records[i];
+        std::memcpy(buf.data() + rec.weightOffset, layers[i].weights(),
+                    size_t(rec.inputs) * rec.neurons * sizeof(double));
+        std::memcpy(buf.data() + rec.biasOffset, layers[i].biases(),
+                    size_t(rec.neurons) * sizeof(double));
+    }
+
+    std::uint32_t crc = crc32(buf.data(), buf.size());
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("model::write - failed to open " + filename);
+    out.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+    out.write(reinterpret_cast<const char*>(&crc), sizeof(crc));
+    if (!out) throw std::runtime_error("model::write - failed writing " + filename);
+}
+
+/*--------------------------------------------------------------
+ | MappedModel
+ *-------------------------------------------------------------*/
+
+MappedModel::MappedModel(const std::string& filename, bool verifyChecksum) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MappedModel: cannot open " + filename);
+    file_ = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        unmap();
+        throw std::runtime_error("MappedModel: cannot stat " + filename);
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+
+    if (size_ >= sizeof(ModelHeader)) {
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_)
+            base_ = static_cast<const std::uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MappedModel: cannot open " + filename);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedModel: cannot stat " + filename);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    if (size_ >= sizeof(ModelHeader)) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED) base_ = static_cast<const std::uint8_t*>(p);
+    }
+    ::close(fd);
+#endif
+
+    if (!base_) {
+        unmap();
+        throw std::runtime_error("MappedModel: cannot map " + filename);
+    }
+
+    try {
+        validate(verifyChecksum);
+    }
+    catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+MappedModel::~MappedModel() {
+    unmap();
+}
+
+void MappedModel::unmap() {
+#ifdef _WIN32
+    if (base_)    UnmapViewOfFile(base_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_)    CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+#endif
+    base_ = nullptr;
+    size_ = 0;
+}
+
+void MappedModel::validate(bool verifyChecksum) {
+    header_ = reinterpret_cast<const ModelHeader*>(base_);
+
+    if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("MappedModel: bad magic");
+    if (header_->endian == 0x04030201u)
+        throw std::runtime_error("MappedModel: written on a machine with the other byte order");
+
+    // Version 1 had no mark and was documented as little-endian
+    const bool v1 = header_->version == 1 && header_->endian == 0 && littleEndian();
+    if (!v1 && header_->version != VERSION)
+        throw std::runtime_error("MappedModel: unsupported version " + std::to_string(header_->version));
+    if (!v1 && header_->endian != ENDIAN_MARK)
+        throw std::runtime_error("MappedModel: bad byte-order mark");
+    if (header_->dtype != static_cast<std::uint32_t>(DType::Float64))
+        throw std::runtime_error("MappedModel: unsupported dtype");
+    if (header_->headerSize != sizeof(ModelHeader) || header_->fileSize != size_)
+        throw std::runtime_error("MappedModel: truncated or resized file");
+    if (header_->layerCount == 0 ||
+        sizeof(ModelHeader) + std::uint64_t(header_->layerCount) * sizeof(LayerRecord) > size_)
+        throw std::runtime_error("MappedModel: bad layer table");
+
+    records_ = reinterpret_cast<const LayerRecord*>(base_ + sizeof(ModelHeader));
+
+    std::uint64_t prevNeurons = header_->inputSize;
+    const std::uint64_t dataEnd = size_ - sizeof(std::uint32_t);
+
+    for (std::size_t i = 0; i < layerCount(); i++) {
+        const LayerRecord& rec = records_[i];
+        std::uint64_t wBytes = std::uint64_t(rec.inputs) * rec.neurons * sizeof(double);
+        std::uint64_t bBytes = std::uint64_t(rec.neurons) * sizeof(double);
+
+        if (rec.inputs != prevNeurons || rec.neurons == 0)
+            throw std::runtime_error("MappedModel: layer " + std::to_string(i) + " shape mismatch");
+        if (rec.activation > static_cast<std::uint8_t>(Activation::Sigmoid) &&
+            rec.activation != static_cast<std::uint8_t>(Activation::Custom))
+            throw std::runtime_error("MappedModel: layer " + std::to_string(i) + " has unknown activation");
+        if (rec.weightOffset % MODEL_ALIGNMENT || rec.biasOffset % MODEL_ALIGNMENT)
+            throw std::runtime_error("MappedModel: misaligned data block");
+        if (rec.weightOffset + wBytes > dataEnd || rec.biasOffset + bBytes > dataEnd)
+            throw std::runtime_error("MappedModel: data block out of range");
+
+        prevNeurons = rec.neurons;
+    }
+
+    if (verifyChecksum) {
+        std::uint32_t stored;
+        std::memcpy(&stored, base_ + dataEnd, sizeof(stored));
+        if (crc32(base_, static_cast<std::size_t>(dataEnd)) != stored)
+            throw std::runtime_error("MappedModel: checksum mismatch");
+    }
+}
+
+const double* MappedModel::weights(std::size_t i) const {
+    return reinterpret_cast<const double*>(base_ + records_[i].weightOffset);
+}
+
+const double* MappedModel::biases(std::size_t i) const {
+    return reinterpret_cast<const double*>(base_ + records_[i].biasOffset);
+}
+
+} // namespace model
@@ -1,6 +1,8 @@
 #include "../Include/NeuralNetwork.h"
+#include <cstdint>
 #include <stdexcept>
 #include <fstream>
+#include <utility>
 
 // Constructor: initialize network layers with provided sizes and activations
 NeuralNetwork::NeuralNetwork(
@@ -17,6 +19,19 @@ NeuralNetwork::NeuralNetwork(
     }
 }
 
+// Constructor: initialize network layers with built-in activation policies
+NeuralNetwork::NeuralNetwork(const std::vector<int>& layerSizes,
+                             const std::vector<Activation>& activations)
+{
+    if (layerSizes.size() < 2 || activations.size() != layerSizes.size() - 1)
+        throw std::runtime_error("NeuralNetwork constructor: size mismatch");
+
+    layers_.clear();
+    for (size_t i = 1; i < layerSizes.size(); ++i) {
+        layers_.emplace_back(layerSizes[i-1], layerSizes[i], activations[i-1]);
+    }
+}
+
 // Forward pass: propagate input through all layers
 Matrix<double> NeuralNetwork::forward(const Matrix<double>& input) {
     Matrix<double> output = input;
@@ -45,13 +60,94 @@ void NeuralNetwork::train(const Matrix<double>& input, const Matrix<double>& exp
     backward(expected, learningRate);
 }
 
+// Accumulate scaled mini-batch gradients into every layer
+double NeuralNetwork::accumulateGradients(const Matrix<double>& inputs,
+                                          const Matrix<double>& targets,
+                                          double scale) {
+    if (layers_.empty()) return 0.0;
+
+    const Matrix<double>* out = &inputs;
+    for (auto& layer : layers_)
+        out = &layer.forward(*out);
+
+    if (out->rows != targets.rows || out->cols != targets.cols)
+        throw std::runtime_error("NeuralNetwork::accumulateGradients - target shape mismatch");
+
+    // dC/dA = scale · (A - Y), loss = scale · 0.5 · Σ (A - Y)²
+    Matrix<double> grad(out->rows, out->cols);
+    double loss = 0.0;
+    for (size_t i = 0; i < grad.data.size(); ++i) {
+        const double d = out->data[i] - targets.data[i];
+        loss += 0.5 * d * d;
+        grad.data[i] = scale * d;
+    }
+
+    Matrix<double> next;
+    for (size_t i = layers_.size(); i-- > 0; ) {
+        layers_[i].backwardAccumulate(grad, i > 0 ? &next : nullptr);
+        if (i > 0) std::swap(grad, next);
+    }
+
+    return loss * scale;
+}
+
+// Apply accumulated gradients and clear them
+void NeuralNetwork::applyGradients(Optimizer& opt) {
+    opt.beginStep();
+    for (size_t i = 0; i < layers_.size(); ++i)
+        layers_[i].applyGradients(opt, 2 * i);
+    zeroGrad();
+}
+
+// Deterministic re-initialization of every layer
+void NeuralNetwork::randomize(std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    for (auto& layer : layers_)
+        layer.randomize(rng);
+    mapping_.reset();
+}
+
+// Reset accumulated gradients
+void NeuralNetwork::zeroGrad() {
+    for (auto& layer : layers_)
+        layer.zeroGrad();
+}
+
+// One optimizer step on a mini-batch
+double NeuralNetwork::trainBatch(const Matrix<double>& inputs,
+                                 const Matrix<double>& targets,
+                                 Optimizer& opt) {
+    if (inputs.cols == 0) return 0.0;
+
+    zeroGrad();
+    double loss = accumulateGradients(inputs, targets, 1.0 / inputs.cols);
+    applyGradients(opt);
+    return loss;
+}
+
 // Predict output without modifying weights
 Matrix<double> NeuralNetwork::predict(const Matrix<double>& input) {
     return forward(input);
 }
 
-// Save network layers to a binary file
+// Forward pass over layers [first, end)
+Matrix<double> NeuralNetwork::forwardFrom(std::size_t first, const Matrix<double>& activations) {
+    if (first > layers_.size())
+        throw std::runtime_error("NeuralNetwork::forwardFrom - layer index out of range");
+
+    Matrix<double> output = activations;
+    for (std::size_t i = first; i < layers_.size(); i++)
+        output = layers_[i].forward(output);
+    return output;
+}
+
+// Save network in the self-describing model format
 void NeuralNetwork::save(const std::string& filename) const {
+    model::write(filename, layers_);
+}
+
+// Save network layers as raw doubles (legacy format)
+void NeuralNetwork::saveLegacy(const std::string& filename) const {
     std::ofstream out(filename, std::ios::binary);
     if (!out) throw std::runtime_error("Failed to open file for saving NeuralNetwork");
 
@@ -60,12 +156,69 @@ void NeuralNetwork::save(const std::string& filename) const {
     }
 }
 
-// Load network layers from a binary file
+// Load network layers from a model file or a legacy binary file
 void NeuralNetwork::load(const std::string& filename) {
-    std::ifstream in(filename, std::ios::binary);
+    if (model::isModelFile(filename)) {
+        model::MappedModel file(filename);
+
+        if (file.layerCount() != layers_.size())
+            throw std::runtime_error("NeuralNetwork::load - layer count mismatch in " + filename);
+
+        for (size_t i = 0; i < layers_.size(); ++i) {
+            const model::LayerRecord& rec = file.layer(i);
+            Activation act = static_cast<Activation>(rec.activation);
+
+            if (int(rec.inputs) != layers_[i].inputs() || int(rec.neurons) != layers_[i].neurons())
+                throw std::runtime_error("NeuralNetwork::load - layer " + std::to_string(i) + " shape mismatch");
+            if (act != layers_[i].activation())
+                throw std::runtime_error("NeuralNetwork::load - layer " + std::to_string(i) +
+                                         " activation is " + act::name(act) + ", expected " +
+                                         act::name(layers_[i].activation()));
+
+            layers_[i].assign(file.weights(i), file.biases(i));
+        }
+        mapping_.reset();
+        return;
+    }
+
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
     if (!in) throw std::runtime_error("Failed to open file for loading NeuralNetwork");
 
+    // Legacy files carry no shapes, so their size is the only check that
+    // they were written for this architecture
+    std::uint64_t expected = 0;
+    for (const auto& layer : layers_)
+        expected += (std::uint64_t(layer.neurons()) * layer.inputs() + layer.neurons()) * sizeof(double);
+    const std::uint64_t actual = std::uint64_t(in.tellg());
+    if (actual != expected)
+        throw std::runtime_error("NeuralNetwork::load - " + filename + " has " + std::to_string(actual) +
+                                 " bytes, a legacy file for this network has " + std::to_string(expected));
+    in.seekg(0);
+
     for (auto& layer : layers_) {
         layer.load(in);
     }
-}
\ No newline at end of file
+    mapping_.reset();
+}
+
+// Map a model file and build view layers over it
+std::shared_ptr<NeuralNetwork> NeuralNetwork::open(const std::string& filename, bool verifyChecksum) {
+    auto file = std::make_shared<const model::MappedModel>(filename, verifyChecksum);
+
+    std::shared_ptr<NeuralNetwork> net(new NeuralNetwork());
+    net->layers_.reserve(file->layerCount());
+
+    for (size_t i = 0; i < file->layerCount(); ++i) {
+        const model::LayerRecord& rec = file->layer(i);
+        Activation act = static_cast<Activation>(rec.activation);
+        if (act == Activation::Custom)
+            throw std::runtime_error("NeuralNetwork::open - layer " + std::to_string(i) +
+                                     " uses a custom activation, construct the network and call load()");
+
+        net->layers_.emplace_back(int(rec.inputs), int(rec.neurons), act,
+                                  file->weights(i), file->biases(i));
+    }
+
+    net->mapping_ = std::move(file);
+    return net;
+}
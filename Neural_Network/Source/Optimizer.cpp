@@ -0,0 +1,66 @@
+#include "../Include/Optimizer.h"
+#include <cmath>
+
+namespace {
+
+// Lazily size per-slot state to n zeros
+std::vector<double>& slotState(std::vector<std::vector<double>>& state, std::size_t slot, std::size_t n) {
+    if (state.size() <= slot) state.resize(slot + 1);
+    if (state[slot].size() != n) state[slot].assign(n, 0.0);
+    return state[slot];
+}
+
+} // namespace
+
+/*--------------------------------------------------------------
+ | SGD (+ momentum)
+ *-------------------------------------------------------------*/
+
+void SGD::update(std::size_t slot, double* param, const double* grad,
+                 std::size_t n, bool decay) {
+    const double lr = learningRate;
+    const double wd = decay ? weightDecay : 0.0;
+
+    if (momentum == 0.0) {
+        for (std::size_t i = 0; i < n; i++)
+            param[i] -= lr * (grad[i] + wd * param[i]);
+        return;
+    }
+
+    std::vector<double>& v = slotState(velocity_, slot, n);
+    for (std::size_t i = 0; i < n; i++) {
+        v[i] = momentum * v[i] + grad[i] + wd * param[i];
+        param[i] -= lr * v[i];
+    }
+}
+
+/*--------------------------------------------------------------
+ | Adam (decoupled weight decay)
+ *-------------------------------------------------------------*/
+
+void Adam::beginStep() {
+    ++t_;
+    corr1_ = 1.0 - std::pow(beta1, double(t_));
+    corr2_ = 1.0 - std::pow(beta2, double(t_));
+}
+
+void Adam::update(std::size_t slot, double* param, const double* grad,
+                  std::size_t n, bool decay) {
+    if (t_ == 0) beginStep();
+
+    std::vector<double>& m = slotState(m_, slot, n);
+    std::vector<double>& v = slotState(v_, slot, n);
+
+    const double lr = learningRate;
+    const double wd = decay ? weightDecay : 0.0;
+
+    for (std::size_t i = 0; i < n; i++) {
+        const double g = grad[i];
+        m[i] = beta1 * m[i] + (1.0 - beta1) * g;
+        v[i] = beta2 * v[i] + (1.0 - beta2) * g * g;
+
+        const double mHat = m[i] / corr1_;
+        const double vHat = v[i] / corr2_;
+        param[i] -= lr * (mHat / (std::sqrt(vHat) + epsilon) + wd * param[i]);
+    }
+}
@@ -0,0 +1,188 @@
+#include "../Include/ParallelTrainer.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+/*--------------------------------------------------------------
+ | Construction / worker pool
+ *-------------------------------------------------------------*/
+
+ParallelTrainer::ParallelTrainer(NeuralNetwork& net, int threads)
+    : net_(net)
+{
+    if (threads <= 0) threads = int(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+
+    replicas_.assign(threads, net_);
+    shardX_.resize(threads);
+    shardY_.resize(threads);
+    shardLoss_.assign(threads, 0.0);
+    bindReplicas();
+
+    for (int id = 1; id < threads; id++)
+        pool_.emplace_back(&ParallelTrainer::workerLoop, this, id);
+}
+
+ParallelTrainer::~ParallelTrainer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : pool_) t.join();
+}
+
+void ParallelTrainer::workerLoop(int id) {
+    unsigned long long seen = 0;
+    while (true) {
+        std::function<void(int)> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            task = task_;
+        }
+
+        task(id);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+}
+
+void ParallelTrainer::runParallel(const std::function<void(int)>& task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = task;
+        pending_ = int(pool_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    task(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+}
+
+// Point every replica layer at the master's current weights
+void ParallelTrainer::bindReplicas() {
+    auto& master = net_.layers();
+    for (auto& replica : replicas_)
+        for (size_t l = 0; l < master.size(); l++)
+            replica.layers()[l].setView(master[l].weights(), master[l].biases());
+}
+
+/*--------------------------------------------------------------
+ | Helpers
+ *-------------------------------------------------------------*/
+
+void ParallelTrainer::gatherColumns(const Matrix<double>& src, const std::vector<int>& cols,
+                                    size_t begin, size_t end, Matrix<double>& dst) {
+    const int n = int(end - begin);
+    dst.resize(src.rows, n);
+
+    for (int r = 0; r < src.rows; r++) {
+        const double* in = src.dataPtr() + size_t(r) * src.cols;
+        double* out = dst.dataPtr() + size_t(r) * n;
+        for (int c = 0; c < n; c++)
+            out[c] = in[cols[begin + c]];
+    }
+}
+
+// Pairwise tree reduction of replica gradients into replica 0
+void ParallelTrainer::reduce() {
+    const int n = threads();
+
+    for (int stride = 1; stride < n; stride *= 2) {
+        runParallel([&](int w) {
+            if (w % (2 * stride) != 0 || w + stride >= n) return;
+
+            auto& dst = replicas_[w].layers();
+            auto& src = replicas_[w + stride].layers();
+            for (size_t l = 0; l < dst.size(); l++) {
+                auto& dW = dst[l].gradW().data;
+                auto& dB = dst[l].gradB().data;
+                const auto& sW = src[l].gradW().data;
+                const auto& sB = src[l].gradB().data;
+                for (size_t i = 0; i < dW.size(); i++) dW[i] += sW[i];
+                for (size_t i = 0; i < dB.size(); i++) dB[i] += sB[i];
+            }
+        });
+    }
+}
+
+/*--------------------------------------------------------------
+ | Training
+ *-------------------------------------------------------------*/
+
+double ParallelTrainer::step(const Matrix<double>& inputs, const Matrix<double>& targets, Optimizer& opt) {
+    if (inputs.cols != targets.cols)
+        throw std::runtime_error("ParallelTrainer::step - input/target batch mismatch");
+
+    order_.resize(inputs.cols);
+    std::iota(order_.begin(), order_.end(), 0);
+    return train(inputs, targets, inputs.cols, opt);
+}
+
+double ParallelTrainer::epoch(const Matrix<double>& inputs, const Matrix<double>& targets,
+                              int batchSize, Optimizer& opt, std::mt19937& rng) {
+    if (inputs.cols != targets.cols)
+        throw std::runtime_error("ParallelTrainer::epoch - input/target sample mismatch");
+
+    order_.resize(inputs.cols);
+    std::iota(order_.begin(), order_.end(), 0);
+    std::shuffle(order_.begin(), order_.end(), rng);
+    return train(inputs, targets, batchSize, opt);
+}
+
+// Mini-batches over order_, one optimizer step each
+double ParallelTrainer::train(const Matrix<double>& inputs, const Matrix<double>& targets,
+                              int batchSize, Optimizer& opt) {
+    const int samples = inputs.cols;
+    if (samples == 0 || batchSize <= 0) return 0.0;
+
+    const int n = threads();
+    double totalLoss = 0.0;
+
+    for (int begin = 0; begin < samples; begin += batchSize) {
+        const int end = std::min(samples, begin + batchSize);
+        const int batch = end - begin;
+
+        bindReplicas();
+
+        runParallel([&](int w) {
+            const size_t lo = begin + size_t(batch) * w / n;
+            const size_t hi = begin + size_t(batch) * (w + 1) / n;
+
+            NeuralNetwork& replica = replicas_[w];
+            replica.zeroGrad();
+            shardLoss_[w] = 0.0;
+            if (lo == hi) return;
+
+            gatherColumns(inputs, order_, lo, hi, shardX_[w]);
+            gatherColumns(targets, order_, lo, hi, shardY_[w]);
+            shardLoss_[w] = replica.accumulateGradients(shardX_[w], shardY_[w], 1.0 / batch);
+        });
+
+        reduce();
+
+        // Hand the reduced gradients to the master and take one step
+        auto& master = net_.layers();
+        auto& first  = replicas_[0].layers();
+        for (size_t l = 0; l < master.size(); l++) {
+            std::swap(master[l].gradW(), first[l].gradW());
+            std::swap(master[l].gradB(), first[l].gradB());
+        }
+        net_.applyGradients(opt);
+
+        for (int w = 0; w < n; w++)
+            totalLoss += shardLoss_[w] * batch;
+    }
+
+    return totalLoss / samples;
+}
@@ -0,0 +1,114 @@
+#include "../Include/SampleShard.h"
+#include "../Include/ModelFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace shard {
+
+bool isShardFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4] = {};
+    if (!in.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+/*--------------------------------------------------------------
+ | Writer
+ *-------------------------------------------------------------*/
+
+ShardWriter::ShardWriter(const std::string& filename, int inputSize, int outputSize)
+    : out_(filename, std::ios::binary | std::ios::trunc),
+      filename_(filename),
+      inputSize_(inputSize),
+      outputSize_(outputSize),
+      record_(size_t(inputSize) + size_t(outputSize) * sizeof(float))
+{
+    if (!out_) throw std::runtime_error("ShardWriter: cannot create " + filename);
+    if (inputSize <= 0 || outputSize <= 0)
+        throw std::runtime_error("ShardWriter: sizes must be positive");
+
+    ShardHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version    = VERSION;
+    header.inputSize  = std::uint32_t(inputSize);
+    header.outputSize = std::uint32_t(outputSize);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+ShardWriter::~ShardWriter() {
+    try { close(); } catch (...) {}
+}
+
+void ShardWriter::append(const std::int8_t* inputs, const float* targets) {
+    std::memcpy(record_.data(), inputs, size_t(inputSize_));
+    std::memcpy(record_.data() + inputSize_, targets, size_t(outputSize_) * sizeof(float));
+
+    out_.write(record_.data(), std::streamsize(record_.size()));
+    crc_ = model::crc32(record_.data(), record_.size(), crc_);
+    ++count_;
+}
+
+void ShardWriter::close() {
+    if (!out_.is_open()) return;
+
+    out_.write(reinterpret_cast<const char*>(&crc_), sizeof(crc_));
+    out_.seekp(offsetof(ShardHeader, count));
+    out_.write(reinterpret_cast<const char*>(&count_), sizeof(count_));
+    out_.close();
+    if (out_.fail()) throw std::runtime_error("ShardWriter: failed writing " + filename_);
+}
+
+/*--------------------------------------------------------------
+ | Reader
+ *-------------------------------------------------------------*/
+
+ShardReader::ShardReader(const std::string& filename)
+    : in_(filename, std::ios::binary), filename_(filename)
+{
+    if (!in_) throw std::runtime_error("ShardReader: cannot open " + filename);
+
+    if (!in_.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+        std::memcmp(header_.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("ShardReader: " + filename + " is not a shard file");
+    if (header_.version != VERSION)
+        throw std::runtime_error("ShardReader: unsupported version in " + filename);
+    if (header_.inputSize == 0 || header_.outputSize == 0)
+        throw std::runtime_error("ShardReader: bad record shape in " + filename);
+}
+
+int ShardReader::read(int maxRecords, Matrix<double>& inputs, Matrix<double>& targets) {
+    const int n = int(std::min<std::uint64_t>(std::uint64_t(std::max(maxRecords, 0)), remaining()));
+    const size_t recSize = header_.inputSize + size_t(header_.outputSize) * sizeof(float);
+
+    inputs.resize(inputSize(), n);
+    targets.resize(outputSize(), n);
+    if (n == 0) return 0;
+
+    buffer_.resize(recSize * n);
+    if (!in_.read(buffer_.data(), std::streamsize(buffer_.size())))
+        throw std::runtime_error("ShardReader: unexpected EOF in " + filename_);
+    crc_ = model::crc32(buffer_.data(), buffer_.size(), crc_);
+
+    for (int c = 0; c < n; c++) {
+        const char* rec = buffer_.data() + recSize * c;
+        for (int r = 0; r < inputSize(); r++)
+            inputs(r, c) = double(static_cast<std::int8_t>(rec[r]));
+        for (int r = 0; r < outputSize(); r++) {
+            float v;
+            std::memcpy(&v, rec + inputSize() + r * sizeof(float), sizeof(v));
+            targets(r, c) = double(v);
+        }
+    }
+
+    read_ += std::uint64_t(n);
+    if (remaining() == 0) {
+        std::uint32_t stored = 0;
+        if (!in_.read(reinterpret_cast<char*>(&stored), sizeof(stored)) || stored != crc_)
+            throw std::runtime_error("ShardReader: checksum mismatch in " + filename_);
+    }
+    return n;
+}
+
+} // namespace shard
@@ -0,0 +1,92 @@
+/**
+ * @file convert_model.cpp
+ * @brief Convert legacy raw-double network files to the model format.
+ *
+ * Legacy files carry no shape information, so the architecture must be
+ * given on the command line:
+ *
+ *   convert_model <legacy.bin> <out.bin> <sizes> <activations>
+ *   convert_model netX.bin netX.model.bin 25,512,512,512,25 relu,relu,relu,linear
+ *
+ * The legacy file must be exactly the size the given architecture needs.
+ * The output must be a different file, so the source survives a wrong
+ * architecture; the game loads netX.bin and netO.bin in either format, so
+ * rename the output over the source once it is checked. The converted file
+ * is re-opened and checked against the source network before the tool
+ * reports success.
+ */
+
+#include "Include/NeuralNetwork.h"
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, sep))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <legacy.bin> <out.bin> <sizes> <activations>\n"
+                  << "  e.g. " << argv[0] << " netX.bin netX.model.bin 25,512,512,512,25 relu,relu,relu,linear\n";
+        return 1;
+    }
+
+    try {
+        std::vector<int> sizes;
+        for (const auto& s : split(argv[3], ','))
+            sizes.push_back(std::stoi(s));
+
+        std::vector<Activation> acts;
+        for (const auto& s : split(argv[4], ','))
+            acts.push_back(act::fromName(s));
+
+        std::error_code ec;
+        if (std::string(argv[1]) == argv[2] || std::filesystem::equivalent(argv[1], argv[2], ec)) {
+            std::cerr << "Output must be a different file than " << argv[1] << "\n";
+            return 1;
+        }
+
+        if (model::isModelFile(argv[1])) {
+            std::cerr << argv[1] << " is already in the model format\n";
+            return 1;
+        }
+
+        NeuralNetwork net(sizes, acts);
+        net.load(argv[1]);
+        net.save(argv[2]);
+
+        // Round-trip check
+        auto mapped = NeuralNetwork::open(argv[2]);
+        for (size_t i = 0; i < net.layers().size(); ++i) {
+            const Layer& a = net.layers()[i];
+            const Layer& b = mapped->layers()[i];
+            size_t nW = size_t(a.neurons()) * a.inputs();
+            for (size_t k = 0; k < nW; ++k)
+                if (a.weights()[k] != b.weights()[k])
+                    throw std::runtime_error("round-trip mismatch in layer " + std::to_string(i));
+            for (int k = 0; k < a.neurons(); ++k)
+                if (a.biases()[k] != b.biases()[k])
+                    throw std::runtime_error("round-trip mismatch in layer " + std::to_string(i));
+        }
+
+        std::cout << "Converted " << argv[1] << " -> " << argv[2]
+                  << " (" << net.layers().size() << " layers)\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
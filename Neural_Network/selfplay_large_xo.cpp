@@ -0,0 +1,186 @@
+/**
+ * @file selfplay_large_xo.cpp
+ * @brief Headless self-play generator for the 5x5 XO Q-networks.
+ *
+ * Plays Large_XO_Board games AI-vs-AI on worker threads using the existing
+ * Large_XO_AI minimax with netX.bin / netO.bin. A missing file is replaced
+ * by an untrained network drawn from --seed, which bootstraps the first
+ * round. For every position it records the side-to-move encoding and a
+ * 25-wide target Q-vector (the searched value of each cell). Output is one
+ * sample shard per worker, ready for `train --data`:
+ *
+ *   selfplay_large_xo --games 10000 --out data/large [--threads 0]
+ *         [--seed 1] [--depth 2] [--epsilon 0.1] [--temperature 0.5]
+ *         [--random-plies 2]
+ *
+ * writes data/large_0.shard, data/large_1.shard, ...
+ *
+ * Exploration: the first --random-plies plies and an --epsilon fraction of
+ * later moves are uniformly random; other moves are sampled from a softmax
+ * over the searched values (--temperature 0 plays greedily). Each game is
+ * seeded from (seed, game index), so the generated positions do not depend
+ * on the thread count.
+ */
+
+#include "Include/SampleShard.h"
+#include "../Games/Large_Tic_Tac_Toe/Large_Tic_Tac_Toe.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int games = 1000;
+    int threads = 0;
+    std::uint32_t seed = 1;
+    int depth = 2;
+    double epsilon = 0.1;
+    double temperature = 0.5;
+    int randomPlies = 2;
+    std::string out;
+};
+
+/**
+ * @brief Map a search score to a training target.
+ *
+ * Terminal scores (±10000 + pattern difference, see Large_XO_AI::evaluate)
+ * are squashed to ±(1 + diff / 48); interior scores are network outputs and
+ * are clamped to [-1, 1], so nets trained on these targets (and bootstrapped
+ * from them in later rounds) stay on one scale.
+ */
+float toTarget(float score) {
+    if (score >= 9000.0f)  return 1.0f + (score - 10000.0f) / 48.0f;
+    if (score <= -9000.0f) return -1.0f + (score + 10000.0f) / 48.0f;
+    return std::max(-1.0f, std::min(1.0f, score));
+}
+
+int pickMove(const float* targets, const std::vector<int>& legal, bool explore,
+             double temperature, std::mt19937& rng) {
+    if (explore)
+        return legal[std::uniform_int_distribution<size_t>(0, legal.size() - 1)(rng)];
+
+    int best = legal.front();
+    for (int idx : legal)
+        if (targets[idx] > targets[best]) best = idx;
+    if (temperature <= 0.0) return best;
+
+    std::vector<double> weights;
+    for (int idx : legal)
+        weights.push_back(std::exp((targets[idx] - targets[best]) / temperature));
+    return legal[std::discrete_distribution<size_t>(weights.begin(), weights.end())(rng)];
+}
+
+void worker(int id, const Options& opt, const std::shared_ptr<Large_XO_EvalCache>& cache,
+            std::atomic<int>& finished) {
+    shard::ShardWriter writer(opt.out + "_" + std::to_string(id) + ".shard", 25, 25);
+    Large_XO_AI ai(opt.seed);
+    ai.setEvalCache(cache);
+
+    Matrix<double> encoded;
+    std::int8_t inputs[25];
+    float scores[25], targets[25];
+
+    for (int game = id; game < opt.games; game += opt.threads) {
+        std::mt19937 rng(opt.seed * 1000003u + std::uint32_t(game));
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+        Large_XO_Board board;
+        Player<char> px("X", 'X', PlayerType::AI), po("O", 'O', PlayerType::AI);
+        px.set_board_ptr(&board);
+        po.set_board_ptr(&board);
+
+        for (int ply = 0; !board.game_is_over(nullptr); ++ply) {
+            Player<char>& side = (ply % 2 == 0) ? px : po;
+
+            ai.scoreMoves(&side, board.getEmptyCell(), opt.depth, scores);
+
+            std::vector<int> legal;
+            board.encode(side.get_symbol(), encoded);
+            for (int idx = 0; idx < 25; ++idx) {
+                inputs[idx] = std::int8_t(encoded(idx, 0));
+                bool empty = board.getCell(idx / 5, idx % 5) == board.getEmptyCell();
+                targets[idx] = empty ? toTarget(scores[idx]) : -1.0f;
+                if (empty) legal.push_back(idx);
+            }
+            writer.append(inputs, targets);
+
+            bool explore = ply < opt.randomPlies || coin(rng) < opt.epsilon;
+            int idx = pickMove(targets, legal, explore, opt.temperature, rng);
+            board.updateCell(idx / 5, idx % 5, side.get_symbol());
+        }
+
+        int done = ++finished;
+        if (done % 100 == 0)
+            std::cout << "  " << done << "/" << opt.games << " games\n";
+    }
+
+    writer.close();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::map<std::string, std::string> args;
+    for (int i = 1; i + 1 < argc; i += 2)
+        args[argv[i]] = argv[i + 1];
+
+    try {
+        if (args.count("--games"))        opt.games = std::stoi(args["--games"]);
+        if (args.count("--threads"))      opt.threads = std::stoi(args["--threads"]);
+        if (args.count("--seed"))         opt.seed = std::uint32_t(std::stoul(args["--seed"]));
+        if (args.count("--depth"))        opt.depth = std::stoi(args["--depth"]);
+        if (args.count("--epsilon"))      opt.epsilon = std::stod(args["--epsilon"]);
+        if (args.count("--temperature"))  opt.temperature = std::stod(args["--temperature"]);
+        if (args.count("--random-plies")) opt.randomPlies = std::stoi(args["--random-plies"]);
+        if (args.count("--out"))          opt.out = args["--out"];
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Bad argument: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (opt.out.empty() || opt.depth < 1) {
+        std::cerr << "Usage: " << argv[0] << " --games <n> --out <prefix> [options]\n"
+                  << "  see the header of selfplay_large_xo.cpp for the option list\n";
+        return 1;
+    }
+
+    if (opt.threads <= 0) opt.threads = int(std::thread::hardware_concurrency());
+    if (opt.threads <= 0) opt.threads = 1;
+
+    for (const char* file : { "netX.bin", "netO.bin" })
+        if (!std::ifstream(file))
+            std::cout << file << " not found: using an untrained network drawn from --seed\n";
+
+    // Every worker has the same nets (the files, or the same seeded ones),
+    // so network evaluations are shared
+    auto cache = std::make_shared<Large_XO_EvalCache>(20);
+
+    std::atomic<int> finished{0};
+    std::vector<std::thread> pool;
+    for (int id = 0; id < opt.threads; ++id)
+        pool.emplace_back([&, id] {
+            try {
+                worker(id, opt, cache, finished);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Worker " << id << " failed: " << e.what() << "\n";
+            }
+        });
+    for (auto& t : pool) t.join();
+
+    std::cout << "Generated " << finished << " games into " << opt.threads
+              << " shards (" << opt.out << "_*.shard)\n"
+              << "Eval cache: " << cache->hits() << " hits, " << cache->misses() << " misses\n";
+    return 0;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file train.cpp
+ * @brief Command-line data-parallel trainer for NeuralNetwork models.
+ *
+ * Trains a network on sample files using every core and writes the result
+ * in the model format (see ModelFile.h):
+ *
+ *   train --data samples.txt --out netX.bin
+ *   train --data data/large_0.shard,data/large_1.shard --out netX.bin
+ *         [--arch 25,512,512,512,25] [--act relu,relu,relu,linear]
+ *         [--init netX.bin] [--epochs 10] [--batch 256] [--threads 0]
+ *         [--seed 1] [--optimizer adam|sgd] [--lr 0.001] [--momentum 0.9]
+ *         [--decay 0] [--chunk 65536] [--augment none|dihedral]
+ *
+ * Text sample file: one sample per line, input values followed by target
+ * values, whitespace separated; loaded into memory. Sample shards (see
+ * SampleShard.h, e.g. from selfplay_large_xo) are streamed: each epoch
+ * visits the shards in shuffled order and trains on shuffled chunks of
+ * --chunk samples, so datasets larger than memory are fine. Runs are
+ * reproducible for a given seed and thread count.
+ *
+ * --augment dihedral treats inputs and targets as row-major n×n boards
+ * (e.g. 5x5 XO) and adds the 7 rotated/mirrored copies of every sample.
+ */
+
+#include "Include/NeuralNetwork.h"
+#include "Include/ParallelTrainer.h"
+#include "Include/SampleShard.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, sep))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+/**
+ * @brief Load a text sample file into column-major sample matrices.
+ * @throws std::runtime_error on malformed lines
+ */
+void loadSamples(const std::string& filename, int inSize, int outSize,
+                 Matrix<double>& inputs, Matrix<double>& targets) {
+    std::ifstream in(filename);
+    if (!in) throw std::runtime_error("cannot open " + filename);
+
+    std::vector<std::vector<double>> rows;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::stringstream ss(line);
+        std::vector<double> values;
+        double v;
+        while (ss >> v) values.push_back(v);
+        if (values.empty()) continue;
+        if (int(values.size()) != inSize + outSize)
+            throw std::runtime_error(filename + ":" + std::to_string(lineNo) + ": expected " +
+                                     std::to_string(inSize + outSize) + " values");
+        rows.push_back(std::move(values));
+    }
+
+    const int n = int(rows.size());
+    inputs.resize(inSize, n);
+    targets.resize(outSize, n);
+    for (int c = 0; c < n; c++) {
+        for (int r = 0; r < inSize; r++)  inputs(r, c)  = rows[c][r];
+        for (int r = 0; r < outSize; r++) targets(r, c) = rows[c][inSize + r];
+    }
+}
+
+/**
+ * @brief Image of cell (r, c) of an n×n board under dihedral symmetry s.
+ */
+int dihedralCell(int s, int n, int r, int c) {
+    const int m = n - 1;
+    switch (s) {
+        case 1: return c * n + (m - r);
+        case 2: return (m - r) * n + (m - c);
+        case 3: return (m - c) * n + r;
+        case 4: return r * n + (m - c);
+        case 5: return (m - r) * n + c;
+        case 6: return c * n + r;
+        case 7: return (m - c) * n + (m - r);
+        default: return r * n + c;
+    }
+}
+
+int boardSide(int size) {
+    int n = 1;
+    while (n * n < size) ++n;
+    if (n * n != size)
+        throw std::runtime_error("--augment dihedral needs square input/output sizes");
+    return n;
+}
+
+/**
+ * @brief Replace a sample set by its 8 dihedral images (8x samples).
+ */
+void augmentDihedral(Matrix<double>& inputs, Matrix<double>& targets) {
+    const int nIn = boardSide(inputs.rows), nOut = boardSide(targets.rows);
+    const int samples = inputs.cols;
+
+    Matrix<double> augIn(inputs.rows, samples * 8), augOut(targets.rows, samples * 8);
+    for (int s = 0; s < 8; s++)
+        for (int c = 0; c < samples; c++) {
+            const int col = s * samples + c;
+            for (int r = 0; r < inputs.rows; r++)
+                augIn(dihedralCell(s, nIn, r / nIn, r % nIn), col) = inputs(r, c);
+            for (int r = 0; r < targets.rows; r++)
+                augOut(dihedralCell(s, nOut, r / nOut, r % nOut), col) = targets(r, c);
+        }
+
+    inputs = std::move(augIn);
+    targets = std::move(augOut);
+}
+
+/**
+ * @brief One epoch over sample shards, streamed in chunks.
+ * @return Mean loss over all samples
+ */
+double shardEpoch(std::vector<std::string> files, int inSize, int outSize, int chunk, bool augment,
+                  ParallelTrainer& trainer, int batch, Optimizer& opt, std::mt19937& rng) {
+    std::shuffle(files.begin(), files.end(), rng);
+
+    Matrix<double> inputs, targets;
+    double lossSum = 0.0;
+    long long samples = 0;
+
+    for (const auto& file : files) {
+        shard::ShardReader reader(file);
+        if (reader.inputSize() != inSize || reader.outputSize() != outSize)
+            throw std::runtime_error(file + ": record shape does not match --arch");
+
+        while (reader.read(chunk, inputs, targets)) {
+            if (augment) augmentDihedral(inputs, targets);
+            lossSum += trainer.epoch(inputs, targets, batch, opt, rng) * inputs.cols;
+            samples += inputs.cols;
+        }
+    }
+    return samples ? lossSum / samples : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> opt = {
+        { "arch", "25,512,512,512,25" }, { "act", "relu,relu,relu,linear" },
+        { "epochs", "10" }, { "batch", "256" }, { "threads", "0" }, { "seed", "1" },
+        { "optimizer", "adam" }, { "lr", "0.001" }, { "momentum", "0.9" }, { "decay", "0" },
+        { "chunk", "65536" }, { "augment", "none" }
+    };
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key.rfind("--", 0) != 0) {
+            std::cerr << "Unexpected argument: " << key << "\n";
+            return 1;
+        }
+        opt[key.substr(2)] = argv[i + 1];
+    }
+
+    if (!opt.count("data") || !opt.count("out")) {
+        std::cerr << "Usage: " << argv[0] << " --data <samples.txt> --out <net.bin> [options]\n"
+                  << "  see the header of train.cpp for the option list\n";
+        return 1;
+    }
+
+    try {
+        std::vector<int> sizes;
+        for (const auto& s : split(opt["arch"], ','))
+            sizes.push_back(std::stoi(s));
+
+        std::vector<Activation> acts;
+        for (const auto& s : split(opt["act"], ','))
+            acts.push_back(act::fromName(s));
+
+        const std::uint32_t seed = std::uint32_t(std::stoul(opt["seed"]));
+
+        NeuralNetwork net(sizes, acts);
+        if (opt.count("init")) net.load(opt["init"]);
+        else                   net.randomize(seed);
+
+        if (opt["augment"] != "none" && opt["augment"] != "dihedral")
+            throw std::runtime_error("unknown augmentation '" + opt["augment"] + "'");
+        const bool augment = opt["augment"] == "dihedral";
+
+        std::vector<std::string> files = split(opt["data"], ',');
+        const bool streaming = !files.empty() && shard::isShardFile(files.front());
+
+        Matrix<double> inputs, targets;
+        if (streaming) {
+            std::uint64_t total = 0;
+            for (const auto& f : files) total += shard::ShardReader(f).count();
+            std::cout << "Streaming " << total << " samples from " << files.size() << " shards\n";
+        }
+        else {
+            loadSamples(opt["data"], sizes.front(), sizes.back(), inputs, targets);
+            std::cout << "Loaded " << inputs.cols << " samples from " << opt["data"] << "\n";
+            if (augment) augmentDihedral(inputs, targets);
+        }
+
+        std::unique_ptr<Optimizer> optimizer;
+        const double lr = std::stod(opt["lr"]);
+        const double decay = std::stod(opt["decay"]);
+        if (opt["optimizer"] == "sgd")
+            optimizer.reset(new SGD(lr, std::stod(opt["momentum"]), decay));
+        else if (opt["optimizer"] == "adam")
+            optimizer.reset(new Adam(lr, 0.9, 0.999, 1e-8, decay));
+        else
+            throw std::runtime_error("unknown optimizer '" + opt["optimizer"] + "'");
+
+        ParallelTrainer trainer(net, std::stoi(opt["threads"]));
+        std::mt19937 rng(seed);
+
+        const int epochs = std::stoi(opt["epochs"]);
+        const int batch = std::stoi(opt["batch"]);
+        std::cout << "Training on " << trainer.threads() << " threads\n";
+
+        for (int e = 1; e <= epochs; e++) {
+            auto t0 = std::chrono::steady_clock::now();
+            double loss = streaming
+                ? shardEpoch(files, sizes.front(), sizes.back(), std::stoi(opt["chunk"]), augment,
+                             trainer, batch, *optimizer, rng)
+                : trainer.epoch(inputs, targets, batch, *optimizer, rng);
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            std::cout << "epoch " << e << "/" << epochs << "  loss " << loss
+                      << "  (" << secs << " s)\n";
+        }
+
+        net.save(opt["out"]);
+        std::cout << "Saved " << opt["out"] << "\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
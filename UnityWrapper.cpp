@@ -16,7 +16,6 @@
 
 #include <vector>
 #include <iostream>
-#include <fstream>
 
 // Global instances
 static Board<char> *board = nullptr;
@@ -132,18 +131,9 @@ extern "C"
                 ai = new Ultimate_AI();
                 break;
             case 12:
-            {
-                std::ifstream f("dic.txt");
-                if (!f.good())
-                {
-                    std::cerr << "dic.txt file not found" << std::endl;
-                    return -2;
-                }
-                f.close();
                 board = new Word_XO_Board();
                 ai = new Word_AI();
                 break;
-            }
             case 13:
                 board = new XO_inf_Board();
                 ai = new XO_inf_AI();
@@ -349,10 +339,14 @@ extern "C"
 
             int depth = 9;
             
-            if (currentGameId == 5)
+            if (currentGameId == 4)
             {
                 depth = 6;
             }
+            else if (currentGameId == 5)
+            {
+                depth = 10;
+            }
             else if (currentGameId == 6)
             {
                 int movesMade = 0;
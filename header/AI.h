@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BoardGame_Classes.h"
+#include <climits>
 
 #define INF INT_MAX
 
@@ -7,10 +7,12 @@
 #ifndef _BOARDGAME_CLASSES_H
 #define _BOARDGAME_CLASSES_H
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 using namespace std;
 
 /////////////////////////////////////////////////////////////
@@ -81,6 +83,17 @@ public:
     /** @brief Check if the game is over. */
     virtual bool game_is_over(Player<T>*) = 0;
 
+    /**
+     * @brief Clear the board for a new game without reallocating it.
+     *
+     * Lets a runner play many games on one board instead of constructing a
+     * new one each time.
+     * @throws std::logic_error if the game does not support resetting.
+     */
+    virtual void reset() {
+        throw logic_error("reset() is not supported by this board");
+    }
+
     /**
      * @brief Return a copy of the current board as a 2D vector.
      */
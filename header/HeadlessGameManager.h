@@ -0,0 +1,220 @@
+#pragma once
+
+/**
+ * @file HeadlessGameManager.h
+ * @brief Plays batches of games between two move providers without a UI.
+ *
+ * A move provider is any callable with the contract of UI::get_move and
+ * AI::bestMove: given the player to move, return a new Move (the runner
+ * deletes it). The runner keeps one board and calls Board::reset() between
+ * games, so a batch allocates nothing per game besides the moves.
+ *
+ * @code
+ * X_O_Board board;
+ * X_O_AI ai;
+ * Player<char> x("A", 'X', PlayerType::COMPUTER), o("B", 'O', PlayerType::COMPUTER);
+ * Player<char>* seats[2] = { &x, &o };
+ * HeadlessGameManager<char> runner(&board, seats, ai_provider(&ai), ai_provider(&ai));
+ * HeadlessStats s = runner.run(100);
+ * @endcode
+ */
+
+#include "BoardGame_Classes.h"
+#include "AI.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/** @brief Returns the next move for a player; the caller owns the move. */
+template <typename T>
+using MoveProvider = std::function<Move<T>*(Player<T>*)>;
+
+/**
+ * @brief Move provider backed by an AI.
+ * @param ai AI to query (not owned; keeps its tables between games)
+ * @param blankCell Empty-cell symbol passed to bestMove
+ * @param depth Search depth passed to bestMove
+ */
+inline MoveProvider<char> ai_provider(AI* ai, char blankCell = '.', int depth = 6) {
+    return [ai, blankCell, depth](Player<char>* player) {
+        return ai->bestMove(player, blankCell, depth);
+    };
+}
+
+/**
+ * @brief Move provider backed by a UI's get_move (e.g. its random computer).
+ * @param ui UI to query (not owned)
+ */
+template <typename T>
+MoveProvider<T> ui_provider(UI<T>* ui) {
+    return [ui](Player<T>* player) { return ui->get_move(player); };
+}
+
+/**
+ * @struct HeadlessStats
+ * @brief Results and timings of a batch. Index 0 is provider A, 1 is provider B.
+ */
+struct HeadlessStats {
+    int games = 0;                        ///< Games played
+    int wins[2] = { 0, 0 };               ///< Wins per provider (forfeits included)
+    int draws = 0;                        ///< Draws (truncated games included)
+    int forfeits[2] = { 0, 0 };           ///< Games lost by a null or illegal move
+    int truncated = 0;                    ///< Games stopped at the ply limit
+    std::uint64_t plies = 0;              ///< Legal moves played
+    std::uint64_t moves[2] = { 0, 0 };    ///< Provider calls
+    double moveSeconds[2] = { 0, 0 };     ///< Time spent in each provider
+    double maxMoveSeconds[2] = { 0, 0 };  ///< Slowest single call
+    double seconds = 0;                   ///< Wall time of the batch
+
+    /** @brief Mean time per move of a provider, in milliseconds. */
+    double mean_move_ms(int p) const { return moves[p] ? 1000.0 * moveSeconds[p] / moves[p] : 0.0; }
+
+    /** @brief Points per game of a provider (win 1, draw 1/2). */
+    double score(int p) const { return games ? (wins[p] + 0.5 * draws) / games : 0.0; }
+
+    /** @brief Add the results and timings of another batch. */
+    HeadlessStats& merge(const HeadlessStats& other) {
+        games += other.games;
+        draws += other.draws;
+        truncated += other.truncated;
+        plies += other.plies;
+        seconds += other.seconds;
+        for (int p : { 0, 1 }) {
+            wins[p] += other.wins[p];
+            forfeits[p] += other.forfeits[p];
+            moves[p] += other.moves[p];
+            moveSeconds[p] += other.moveSeconds[p];
+            maxMoveSeconds[p] = std::max(maxMoveSeconds[p], other.maxMoveSeconds[p]);
+        }
+        return *this;
+    }
+};
+
+/**
+ * @class HeadlessGameManager
+ * @brief GameManager without a UI: plays many games and keeps statistics.
+ *
+ * Seat 0 moves first. With seat alternation provider A plays seat 0 in
+ * even games and seat 1 in odd games; the players (and their symbols) stay
+ * in their seats. Win, loss and draw are checked in the same order as
+ * GameManager::run. A provider returning null or an illegal move loses the
+ * game; exceptions from providers propagate.
+ *
+ * @tparam T Board cell type
+ */
+template <typename T>
+class HeadlessGameManager {
+public:
+    /** @brief Called after each game with its index and the winning provider (-1 = draw). */
+    using GameCallback = std::function<void(int game, int winner)>;
+
+    /** @brief Called after each legal move with the player who made it. */
+    using MoveHook = std::function<void(Player<T>*)>;
+
+    /**
+     * @brief Called after reset() with the seated players; may play an
+     *        opening on the board and returns the number of plies it played.
+     */
+    using StartHook = std::function<int(Board<T>*, Player<T>* seats[2])>;
+
+    /**
+     * @brief Construct a runner; the players' board pointers are set to b.
+     * @param b Board reused for every game (must support reset())
+     * @param p Players of seat 0 and seat 1
+     * @param providerA Provider A
+     * @param providerB Provider B
+     */
+    HeadlessGameManager(Board<T>* b, Player<T>* p[2], MoveProvider<T> providerA, MoveProvider<T> providerB)
+        : boardPtr(b) {
+        players[0] = p[0];
+        players[1] = p[1];
+        players[0]->set_board_ptr(b);
+        players[1]->set_board_ptr(b);
+        providers[0] = std::move(providerA);
+        providers[1] = std::move(providerB);
+    }
+
+    /** @brief Board-specific bookkeeping after a move (e.g. Word_XO_Board::setLastPlayer). */
+    void set_move_hook(MoveHook hook) { moveHook = std::move(hook); }
+
+    /** @brief Set up each game after reset(), e.g. with a randomized opening. */
+    void set_start_hook(StartHook hook) { startHook = std::move(hook); }
+
+    /**
+     * @brief Play one game from a reset board (and the start hook's opening).
+     * @param first Provider in seat 0 (0 = A, 1 = B)
+     * @param stats Statistics to update
+     * @param maxPlies Moves after which the game is scored as a draw
+     * @return Winning provider, or -1 for a draw
+     */
+    int play(int first, HeadlessStats& stats, int maxPlies = 1000) {
+        using clock = std::chrono::steady_clock;
+        boardPtr->reset();
+        const int opening = startHook ? startHook(boardPtr, players) : 0;
+
+        int winner = -1;
+        for (int ply = opening;; ++ply) {
+            if (ply >= maxPlies) {
+                ++stats.truncated;
+                break;
+            }
+            const int seat = ply % 2;
+            const int p = seat == 0 ? first : 1 - first;
+            Player<T>* current = players[seat];
+
+            const auto t0 = clock::now();
+            Move<T>* move = providers[p](current);
+            const double dt = std::chrono::duration<double>(clock::now() - t0).count();
+            ++stats.moves[p];
+            stats.moveSeconds[p] += dt;
+            stats.maxMoveSeconds[p] = std::max(stats.maxMoveSeconds[p], dt);
+
+            const bool legal = move && boardPtr->update_board(move);
+            delete move;
+            if (!legal) {
+                ++stats.forfeits[p];
+                winner = 1 - p;
+                break;
+            }
+            ++stats.plies;
+            if (moveHook) moveHook(current);
+
+            if (boardPtr->is_win(current)) { winner = p; break; }
+            if (boardPtr->is_lose(current)) { winner = 1 - p; break; }
+            if (boardPtr->is_draw(current)) break;
+        }
+
+        ++stats.games;
+        if (winner < 0) ++stats.draws;
+        else ++stats.wins[winner];
+        return winner;
+    }
+
+    /**
+     * @brief Play a batch of games.
+     * @param games Number of games
+     * @param alternate Swap seats every game (otherwise A always moves first)
+     * @param maxPlies Per-game move limit, see play()
+     * @param onGame Optional per-game callback
+     * @return Batch statistics
+     */
+    HeadlessStats run(int games, bool alternate = true, int maxPlies = 1000,
+                      const GameCallback& onGame = nullptr) {
+        HeadlessStats stats;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int g = 0; g < games; ++g) {
+            const int winner = play(alternate ? g % 2 : 0, stats, maxPlies);
+            if (onGame) onGame(g, winner);
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        return stats;
+    }
+
+private:
+    Board<T>* boardPtr;            ///< Board reused for every game
+    Player<T>* players[2];         ///< Players of seat 0 and seat 1
+    MoveProvider<T> providers[2];  ///< Providers A and B
+    MoveHook moveHook;             ///< Optional per-move bookkeeping
+    StartHook startHook;           ///< Optional per-game setup
+};
@@ -0,0 +1,576 @@
+/**
+ * @file KInARowBoard.h
+ * @brief Bitboard core and shared AI for the k-in-a-row games.
+ *
+ * @defgroup KInARow K-in-a-row engine
+ * @brief Compile-time sized boards and one alpha-beta AI for XO-style games.
+ *
+ * KInARowBoard<Rows, Cols, K, Gravity, ShapeMask> keeps each side as a
+ * bitboard in the smallest unsigned type that fits (uint32_t, uint64_t or
+ * unsigned __int128). Cells are stored row by row with one always-empty
+ * guard bit after each row, so a run in any of the four directions is found
+ * with K - 1 shifts and ANDs and never wraps around an edge:
+ *
+ *   horizontal 1, vertical Cols + 1, diagonal Cols + 2, anti-diagonal Cols
+ *
+ * The board also keeps the Board<char> matrix for the UIs and an
+ * incrementally updated Zobrist hash. KInARowAI<BoardT> searches any such
+ * board with negamax alpha-beta and a transposition table.
+ */
+
+#ifndef KINAROWBOARD_H
+#define KINAROWBOARD_H
+
+#include "BoardGame_Classes.h"
+#include "AI.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kinarow {
+
+/**
+ * @brief Smallest unsigned integer with at least Bits bits.
+ */
+template <int Bits>
+struct WordFor {
+#ifdef __SIZEOF_INT128__
+    static_assert(Bits <= 128, "Board does not fit a 128-bit bitboard");
+    using type = std::conditional_t<Bits <= 32, std::uint32_t,
+                 std::conditional_t<Bits <= 64, std::uint64_t, unsigned __int128>>;
+#else
+    static_assert(Bits <= 64, "Boards over 64 bits need a compiler with __int128");
+    using type = std::conditional_t<Bits <= 32, std::uint32_t, std::uint64_t>;
+#endif
+};
+
+/** @brief Number of set bits. */
+template <typename W>
+inline int popcount(W w) {
+    int n = 0;
+    for (; w; w &= w - 1) ++n;
+    return n;
+}
+
+/**
+ * @brief Playable cells of a board in guarded layout.
+ * @param shape Cell r * cols + c is playable if its bit is set; 0 means all
+ */
+template <typename W>
+constexpr W shapeBits(int rows, int cols, unsigned long long shape) {
+    W w = 0;
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+            if (shape == 0 || (shape >> (r * cols + c) & 1))
+                w |= W(1) << (r * (cols + 1) + c);
+    return w;
+}
+
+/** @brief SplitMix64 step (Zobrist keys). */
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace kinarow
+
+/**
+ * @class KInARowBoard
+ * @ingroup KInARow
+ * @brief N×M board won by K marks in a row, stored as two bitboards.
+ *
+ * @tparam Rows Board rows
+ * @tparam Cols Board columns
+ * @tparam K Run length that wins
+ * @tparam Gravity Marks drop to the lowest free row of a column (Move x is ignored)
+ * @tparam ShapeMask Playable cells (bit r * Cols + c), 0 for the full rectangle
+ *
+ * Side 0 plays 'X', side 1 everything else. Symbol 0 (or the blank symbol)
+ * in update_board() removes a mark, which on gravity boards must be the
+ * top of its column.
+ *
+ * A board with a different rule hides the static wins() (used by
+ * KInARowAI) and overrides has_won() (used by the Board<char> checks).
+ */
+template <int Rows, int Cols, int K, bool Gravity = false, unsigned long long ShapeMask = 0>
+class KInARowBoard : public Board<char> {
+public:
+    static constexpr int ROWS = Rows;          ///< Board rows
+    static constexpr int COLS = Cols;          ///< Board columns
+    static constexpr int LENGTH = K;           ///< Winning run length
+    static constexpr bool GRAVITY = Gravity;   ///< Marks drop down columns
+    static constexpr int STRIDE = Cols + 1;    ///< Bits per row, guard bit included
+    static constexpr int BITS = Rows * STRIDE; ///< Bits used by a bitboard
+    static constexpr int CELLS = Rows * Cols;  ///< Cells of the rectangle
+
+    using Word = typename kinarow::WordFor<BITS>::type;
+
+    static_assert(K >= 2 && K <= (Rows > Cols ? Rows : Cols), "Run length does not fit the board");
+    static_assert(ShapeMask == 0 || CELLS <= 64, "ShapeMask covers at most 64 cells");
+
+    /** @brief Shift per step: horizontal, vertical, diagonal, anti-diagonal. */
+    static constexpr int DIRECTIONS[4] = { 1, STRIDE, STRIDE + 1, STRIDE - 1 };
+
+    /** @brief Playable cells. */
+    static constexpr Word PLAYABLE = kinarow::shapeBits<Word>(Rows, Cols, ShapeMask);
+
+    /**
+     * @brief Empty board.
+     * @param blank Matrix symbol of an empty playable cell
+     * @param blocked Matrix symbol of a cell outside the shape
+     */
+    explicit KInARowBoard(char blank = '.', char blocked = ' ')
+        : Board<char>(Rows, Cols), blank(blank) {
+        for (int r = 0; r < Rows; ++r)
+            for (int c = 0; c < Cols; ++c)
+                board[r][c] = (PLAYABLE & bit(r, c)) ? blank : blocked;
+    }
+
+    /** @brief Bit index of cell (r, c). */
+    static constexpr int index(int r, int c) { return r * STRIDE + c; }
+
+    /** @brief Bitboard holding only cell (r, c). */
+    static constexpr Word bit(int r, int c) { return Word(1) << index(r, c); }
+
+    /** @brief Side index of a symbol (0 for 'X'). */
+    static int side_of(char symbol) { return std::toupper(static_cast<unsigned char>(symbol)) == 'X' ? 0 : 1; }
+
+    /** @brief True if b holds len consecutive cells along direction dir. */
+    static bool has_run(Word b, int len, int dir) {
+        Word m = b;
+        for (int i = 1; i < len && m; ++i) {
+            if (dir * i >= BITS) return false;
+            m &= b >> (dir * i);
+        }
+        return m != 0;
+    }
+
+    /** @brief True if b holds len consecutive cells in any direction. */
+    static bool has_run(Word b, int len) {
+        for (int dir : DIRECTIONS)
+            if (has_run(b, len, dir)) return true;
+        return false;
+    }
+
+    /** @brief Win rule on one side's bitboard. */
+    static bool wins(Word b) { return has_run(b, K); }
+
+    /**
+     * @brief Zobrist key of a side's mark on a bit index.
+     *
+     * Index BITS of side 0 is the side-to-move key used by the AI.
+     */
+    static std::uint64_t zobrist(int side, int idx) {
+        static const std::vector<std::uint64_t> keys = [] {
+            std::vector<std::uint64_t> k(2 * (BITS + 1));
+            std::uint64_t state = 0x6B1D5EEDull + std::uint64_t(Rows) * 131 + std::uint64_t(Cols);
+            for (auto& key : k) key = kinarow::splitmix64(state);
+            return k;
+        }();
+        return keys[side * (BITS + 1) + idx];
+    }
+
+    /**
+     * @brief Place a mark.
+     * @return False if the cell is outside the shape, taken, or (gravity)
+     *         not the lowest free cell of its column
+     */
+    bool place(int r, int c, char symbol) {
+        if (r < 0 || r >= Rows || c < 0 || c >= Cols) return false;
+        const Word b = bit(r, c);
+        if (!(PLAYABLE & b) || ((marks[0] | marks[1]) & b)) return false;
+        if (Gravity && r != Rows - 1 - height[c]) return false;
+
+        const int side = side_of(symbol);
+        marks[side] |= b;
+        key ^= zobrist(side, index(r, c));
+        board[r][c] = char(std::toupper(static_cast<unsigned char>(symbol)));
+        if (Gravity) ++height[c];
+        ++n_moves;
+        return true;
+    }
+
+    /**
+     * @brief Remove a mark.
+     * @return False if the cell is empty or (gravity) not the top of its column
+     */
+    bool remove(int r, int c) {
+        if (r < 0 || r >= Rows || c < 0 || c >= Cols) return false;
+        const Word b = bit(r, c);
+        const int side = (marks[0] & b) ? 0 : (marks[1] & b) ? 1 : -1;
+        if (side < 0) return false;
+        if (Gravity && r != Rows - height[c]) return false;
+
+        marks[side] &= ~b;
+        key ^= zobrist(side, index(r, c));
+        board[r][c] = blank;
+        if (Gravity) --height[c];
+        --n_moves;
+        return true;
+    }
+
+    /** @brief Row a mark dropped into column c lands on (-1 if full). */
+    int landing_row(int c) const { return Rows - 1 - height[c]; }
+
+    /** @brief Marks per column (gravity boards). */
+    const int* heights() const { return height; }
+
+    /** @brief Bitboard of a symbol's marks. */
+    Word mask(char symbol) const { return marks[side_of(symbol)]; }
+
+    /** @brief Bitboard of a side's marks. */
+    Word side_mask(int side) const { return marks[side]; }
+
+    /** @brief Empty playable cells. */
+    Word empty_cells() const { return PLAYABLE & ~(marks[0] | marks[1]); }
+
+    /** @brief Zobrist hash of the marks. */
+    std::uint64_t hash() const { return key; }
+
+    /** @brief True if the side's marks satisfy the win rule. */
+    virtual bool has_won(int side) const { return wins(marks[side]); }
+
+    /**
+     * @brief Place or remove a mark (symbol 0 or blank removes).
+     * @return True if the board changed
+     */
+    bool update_board(Move<char>* move) override {
+        if (!move) throw std::invalid_argument("Null move pointer");
+
+        int x = move->get_x();
+        const int y = move->get_y();
+        const char mark = move->get_symbol();
+        const bool undo = mark == 0 || mark == blank;
+
+        if (y < 0 || y >= Cols) return false;
+        if (Gravity) x = undo ? Rows - height[y] : Rows - 1 - height[y];
+
+        return undo ? remove(x, y) : place(x, y, mark);
+    }
+
+    /** @brief The player's marks satisfy the win rule. */
+    bool is_win(Player<char>* player) override { return has_won(side_of(player->get_symbol())); }
+
+    /** @brief The opponent's marks satisfy the win rule. */
+    bool is_lose(Player<char>* player) override { return has_won(side_of(player->get_symbol()) ^ 1); }
+
+    /** @brief No free cell and no winner. */
+    bool is_draw(Player<char>*) override { return !empty_cells() && !has_won(0) && !has_won(1); }
+
+    /** @brief Someone won or the board is full. */
+    bool game_is_over(Player<char>*) override { return has_won(0) || has_won(1) || !empty_cells(); }
+
+    /** @brief Empty every playable cell; cells outside the shape are kept. */
+    void reset() override {
+        for (int r = 0; r < Rows; ++r)
+            for (int c = 0; c < Cols; ++c)
+                if (PLAYABLE & bit(r, c)) board[r][c] = blank;
+        marks[0] = marks[1] = 0;
+        key = 0;
+        for (int& h : height) h = 0;
+        n_moves = 0;
+    }
+
+protected:
+    char blank;                  ///< Matrix symbol of an empty cell
+    Word marks[2] = { 0, 0 };    ///< Marks of X and of O
+    std::uint64_t key = 0;       ///< Zobrist hash of marks
+    int height[Cols] = {};       ///< Marks per column (gravity boards)
+};
+
+/**
+ * @class KInARowAI
+ * @ingroup AI
+ * @brief Alpha-beta AI for any KInARowBoard.
+ *
+ * @tparam BoardT A KInARowBoard instantiation (or a class derived from one)
+ *
+ * @details Negamax with a transposition table on the board's Zobrist hash,
+ * iterative deepening at the root and make/unmake on the two bitboards.
+ * Immediate wins end a node before move generation; two open threats lose;
+ * a single threat forces the block. Leaves are scored by the K-cell windows
+ * still open to one side (weights 8^(marks - 1)). Faster wins score higher.
+ */
+template <class BoardT>
+class KInARowAI : public AI {
+public:
+    using Word = typename BoardT::Word;
+
+    /**
+     * @brief Construct with 2^tableBits transposition table entries.
+     *
+     * Entries are 16 bytes; each game sizes the table for its search depth.
+     */
+    explicit KInARowAI(int tableBits)
+        : table(std::size_t(1) << tableBits), shift(64 - tableBits) {}
+
+    /**
+     * @brief Static score of the board for the player.
+     * @return WIN / -WIN once decided, otherwise the open-window score
+     */
+    float evaluate(Board<char>* b, Player<char>* player) override {
+        auto* board = dynamic_cast<BoardT*>(b);
+        if (!board || !player) throw std::invalid_argument("Invalid board or player in evaluate()");
+
+        const int me = BoardT::side_of(player->get_symbol());
+        if (board->has_won(me)) return float(WIN);
+        if (board->has_won(me ^ 1)) return float(-WIN);
+        return float(heuristic(board->side_mask(me), board->side_mask(me ^ 1)));
+    }
+
+    /**
+     * @brief Searched value from the AI's point of view.
+     * @param aiTurn True if the AI moves next
+     * @param player The AI player
+     * @param depth Plies to search
+     */
+    float minimax(bool aiTurn, Player<char>* player, float alpha, float beta, char blankCell, int depth) override {
+        auto* board = dynamic_cast<BoardT*>(player ? player->get_board_ptr() : nullptr);
+        if (!board) throw std::invalid_argument("Invalid board or player in minimax()");
+        if (board->game_is_over(player)) return evaluate(board, player);
+
+        const int me = BoardT::side_of(player->get_symbol());
+        load(*board, aiTurn ? me : me ^ 1);
+        const int lo = alpha < float(-WIN - 1) ? -WIN - 1 : int(alpha);
+        const int hi = beta > float(WIN + 1) ? WIN + 1 : int(beta);
+        if (aiTurn) return float(search(depth, lo, hi));
+        return float(-search(depth, -hi, -lo));
+    }
+
+    /**
+     * @brief Best move found by iterative deepening to depth plies.
+     * @throws std::runtime_error if the board has no free cell
+     */
+    Move<char>* bestMove(Player<char>* player, char blankCell, int depth = 6) override {
+        auto* board = dynamic_cast<BoardT*>(player ? player->get_board_ptr() : nullptr);
+        if (!board) throw std::invalid_argument("Invalid board or player in bestMove()");
+
+        load(*board, BoardT::side_of(player->get_symbol()));
+
+        int moves[BoardT::CELLS];
+        const int n = generate(moves);
+        if (n == 0) throw std::runtime_error("No valid moves left for AI");
+
+        int best = moves[0];
+        for (int i = 0; i < n; ++i)
+            if (BoardT::wins(marks[side] | Word(1) << moves[i])) return toMove(moves[i], player);
+
+        for (int d = 1; d <= (depth < 1 ? 1 : depth); ++d) {
+            // Previous iteration's choice first
+            for (int i = 0; i < n; ++i)
+                if (moves[i] == best) { std::swap(moves[i], moves[0]); break; }
+
+            int alpha = -WIN - 1, bestValue = -WIN - 2, bestCell = moves[0];
+            for (int i = 0; i < n; ++i) {
+                make(moves[i]);
+                int value = -search(d - 1, -WIN - 1, -alpha + 1);
+                unmake(moves[i]);
+                value -= (value > 0) - (value < 0);
+                if (value > bestValue) { bestValue = value; bestCell = moves[i]; }
+                if (bestValue > alpha) alpha = bestValue;
+            }
+            best = bestCell;
+            if (bestValue >= WIN - 64 || bestValue <= -WIN + 64) break; // decided
+        }
+        return toMove(best, player);
+    }
+
+    /** @brief Nodes searched since construction. */
+    std::uint64_t nodes() const { return nodeCount; }
+
+    /**
+     * @brief Open-window score of own against opp.
+     *
+     * Every K-cell window inside the shape that holds marks of only one
+     * side adds (or subtracts) 8^(marks - 1).
+     */
+    static int heuristic(Word own, Word opp) {
+        int score = 0;
+        for (Word w : windows()) {
+            const bool mine = (own & w) != 0, theirs = (opp & w) != 0;
+            if (mine == theirs) continue;
+            const int weight = 1 << (3 * (kinarow::popcount(Word((mine ? own : opp) & w)) - 1));
+            score += mine ? weight : -weight;
+        }
+        return score;
+    }
+
+protected:
+    static constexpr int WIN = 1 << 24; ///< Score of a win on the next placement
+
+    enum Bound : std::uint8_t { NONE, EXACT, LOWER, UPPER };
+
+    struct Entry {
+        std::uint64_t key = 0;     ///< Position hash (side to move included)
+        std::int32_t value = 0;    ///< Score for the side to move
+        std::int16_t move = -1;    ///< Best bit index found
+        std::int8_t depth = -1;    ///< Remaining depth searched
+        std::uint8_t bound = NONE; ///< Bound type of value
+    };
+
+    /** @brief K-cell windows inside the shape. */
+    static const std::vector<Word>& windows() {
+        static const std::vector<Word> list = [] {
+            std::vector<Word> w;
+            for (int dir : BoardT::DIRECTIONS)
+                for (int start = 0; start < BoardT::BITS; ++start) {
+                    Word window = 0;
+                    bool inside = true;
+                    for (int i = 0; i < BoardT::LENGTH && inside; ++i) {
+                        const int idx = start + dir * i;
+                        inside = idx < BoardT::BITS && (BoardT::PLAYABLE >> idx & 1);
+                        if (inside) window |= Word(1) << idx;
+                    }
+                    // Guard bits are never playable, so no window wraps a row
+                    if (inside) w.push_back(window);
+                }
+            return w;
+        }();
+        return list;
+    }
+
+    /** @brief Bit indices in search order: busiest cells (or centre columns) first. */
+    static const std::vector<int>& order() {
+        static const std::vector<int> cells = [] {
+            std::vector<std::pair<int, int>> keyed;
+            for (int r = 0; r < BoardT::ROWS; ++r)
+                for (int c = 0; c < BoardT::COLS; ++c) {
+                    const int idx = BoardT::index(r, c);
+                    if (!(BoardT::PLAYABLE >> idx & 1)) continue;
+                    int k = 0;
+                    if (BoardT::GRAVITY) k = -std::abs(2 * c - (BoardT::COLS - 1));
+                    else for (Word w : windows()) k += int(w >> idx & 1);
+                    keyed.push_back({ -k, idx });
+                }
+            std::stable_sort(keyed.begin(), keyed.end(),
+                             [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+            std::vector<int> out;
+            for (const auto& p : keyed) out.push_back(p.second);
+            return out;
+        }();
+        return cells;
+    }
+
+    /** @brief Copy the board into the search state. */
+    void load(const BoardT& board, int toMove) {
+        marks[0] = board.side_mask(0);
+        marks[1] = board.side_mask(1);
+        side = toMove;
+        key = board.hash() ^ (toMove ? BoardT::zobrist(0, BoardT::BITS) : 0);
+        for (int c = 0; c < BoardT::COLS; ++c) height[c] = board.heights()[c];
+    }
+
+    /** @brief Legal bit indices in search order; returns the count. */
+    int generate(int* moves) const {
+        const Word empty = BoardT::PLAYABLE & ~(marks[0] | marks[1]);
+        int n = 0;
+        if (BoardT::GRAVITY) {
+            for (int idx : order()) {
+                const int c = idx % BoardT::STRIDE, r = idx / BoardT::STRIDE;
+                if (r == BoardT::ROWS - 1 - height[c] && (empty >> idx & 1)) moves[n++] = idx;
+            }
+        } else {
+            for (int idx : order())
+                if (empty >> idx & 1) moves[n++] = idx;
+        }
+        return n;
+    }
+
+    void make(int idx) {
+        marks[side] |= Word(1) << idx;
+        key ^= BoardT::zobrist(side, idx) ^ BoardT::zobrist(0, BoardT::BITS);
+        if (BoardT::GRAVITY) ++height[idx % BoardT::STRIDE];
+        side ^= 1;
+    }
+
+    void unmake(int idx) {
+        side ^= 1;
+        marks[side] &= ~(Word(1) << idx);
+        key ^= BoardT::zobrist(side, idx) ^ BoardT::zobrist(0, BoardT::BITS);
+        if (BoardT::GRAVITY) --height[idx % BoardT::STRIDE];
+    }
+
+    Move<char>* toMove(int idx, Player<char>* player) const {
+        return new Move<char>(idx / BoardT::STRIDE, idx % BoardT::STRIDE, player->get_symbol());
+    }
+
+    /**
+     * @brief Negamax alpha-beta on the search state.
+     * @return Score for the side to move
+     */
+    int search(int depth, int alpha, int beta) {
+        ++nodeCount;
+
+        int moves[BoardT::CELLS];
+        int n = generate(moves);
+        if (n == 0) return 0;
+
+        const Word own = marks[side], opp = marks[side ^ 1];
+        int threats = 0, forced = -1;
+        for (int i = 0; i < n; ++i) {
+            const Word b = Word(1) << moves[i];
+            if (BoardT::wins(own | b)) return WIN;
+            if (BoardT::wins(opp | b)) { ++threats; forced = moves[i]; }
+        }
+        if (threats > 1) return -(WIN - 1);
+        if (depth <= 0) return heuristic(own, opp);
+
+        Entry& e = table[(key * 0x9E3779B97F4A7C15ull) >> shift];
+        int ttMove = -1;
+        if (e.key == key && e.bound != NONE) {
+            ttMove = e.move;
+            if (e.depth >= depth) {
+                if (e.bound == EXACT) return e.value;
+                if (e.bound == LOWER && e.value >= beta) return e.value;
+                if (e.bound == UPPER && e.value <= alpha) return e.value;
+            }
+        }
+
+        if (forced >= 0) {
+            moves[0] = forced;
+            n = 1;
+        } else if (ttMove >= 0) {
+            for (int i = 1; i < n; ++i)
+                if (moves[i] == ttMove) { std::swap(moves[i], moves[0]); break; }
+        }
+
+        const int alpha0 = alpha;
+        int best = -WIN - 1, bestCell = moves[0];
+        for (int i = 0; i < n; ++i) {
+            make(moves[i]);
+            int value = -search(depth - 1, -beta - 1, -alpha + 1);
+            unmake(moves[i]);
+            // A result one ply further away is worth one point less
+            value -= (value > 0) - (value < 0);
+
+            if (value > best) { best = value; bestCell = moves[i]; }
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) break;
+        }
+
+        e.key = key;
+        e.value = best;
+        e.move = std::int16_t(bestCell);
+        e.depth = std::int8_t(depth);
+        e.bound = best <= alpha0 ? UPPER : best >= beta ? LOWER : EXACT;
+        return best;
+    }
+
+    std::vector<Entry> table;     ///< Transposition table (replace always)
+    int shift;                    ///< 64 - log2(table size)
+    std::uint64_t nodeCount = 0;  ///< Node counter
+
+    Word marks[2] = { 0, 0 };     ///< Search state: marks of X and O
+    int side = 0;                 ///< Search state: side to move
+    std::uint64_t key = 0;        ///< Search state: hash, side to move included
+    int height[BoardT::COLS] = {};///< Search state: marks per column
+};
+
+#endif // KINAROWBOARD_H
@@ -0,0 +1,282 @@
+#pragma once
+
+/**
+ * @file GameRegistry.h
+ * @brief The 14 games behind one interface, for the command-line tools.
+ *
+ * Each GameSpec knows how to build a board and its AI, and lists candidate
+ * moves; legal_moves() keeps the ones the board accepts. The helpers below
+ * drive any game through Board's virtual interface only, so the tournament
+ * and the benchmark treat every game alike.
+ */
+
+#include "../header/AI.h"
+#include "../header/BoardGame_Classes.h"
+#include "../header/XO_Classes.h"
+#include "../Games/4x4_Tic_Tac_Toe/4by4_XO.h"
+#include "../Games/anti_XO/Anti_XO.h"
+#include "../Games/diamond_XO/dia_XO.h"
+#include "../Games/Four_in_a_row/four.h"
+#include "../Games/Large_Tic_Tac_Toe/Large_Tic_Tac_Toe.h"
+#include "../Games/Memory_Tic_Tac_Toe/Memory_Tic_Tac_Toe.h"
+#include "../Games/Obstacles_Tic_Tac_Toe/Obstacles_Tic_Tac_Toe.h"
+#include "../Games/PyramidXO/PyramidXO.h"
+#include "../Games/SUS/SUS.h"
+#include "../Games/Ultimate_Tic_Tac_Toe/Ultimate.h"
+#include "../Games/Word_Tic_Tac_Toe/Word_Tic_Tac_Toe.h"
+#include "../Games/XO_inf/XO_inf.h"
+#include "../Games/XO_num/xo_num.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Moves = std::vector<std::unique_ptr<Move<char>>>;
+
+constexpr int ONGOING = -2; ///< outcome(): nobody has won yet
+constexpr int DRAW = -1;    ///< outcome(): the game is drawn
+
+/**
+ * @brief What the tools need to know about a game.
+ */
+struct GameSpec {
+    std::string name;   ///< Command-line name
+    char symbols[2];    ///< Symbols of seat 0 (moves first) and seat 1
+    char blank;         ///< Empty-cell symbol passed to bestMove
+    int depth;          ///< Default minimax depth
+    bool exactEvaluate = false; ///< The AI's evaluate() is the solved game value
+    bool randomAI = false;      ///< The AI's bestMove() is a random legal move, not a search
+
+    std::function<std::unique_ptr<Board<char>>()> make;                        ///< New board
+    std::function<std::unique_ptr<Board<char>>(Board<char>*)> clone;           ///< Copy of a board
+    std::function<std::unique_ptr<AI>()> ai;                                   ///< New game AI
+    std::function<Moves(Board<char>*, Player<char>*)> candidates;              ///< Superset of the legal moves
+    std::function<void(Board<char>*, Player<char>*)> played = nullptr;         ///< Bookkeeping after a move
+    std::function<void(Board<char>*, std::uint64_t)> seed = nullptr;           ///< Seed the board's own randomness
+    std::function<void(AI*, std::uint64_t)> reseed = nullptr;                  ///< Seed the AI's own randomness for a new game
+    std::function<void()> requireAI = nullptr;                                 ///< Throws if the AI lacks files it needs to play
+};
+
+/** @brief Every empty cell, marked with the player's symbol. */
+inline Moves empty_cells(Board<char>* board, char symbol, char blank) {
+    Moves moves;
+    for (int r = 0; r < board->get_rows(); ++r)
+        for (int c = 0; c < board->get_columns(); ++c)
+            if (board->get_cell(r, c) == blank)
+                moves.push_back(std::make_unique<Move<char>>(r, c, symbol));
+    return moves;
+}
+
+/** @brief Game with one mark per move on any empty cell. */
+template <class BoardT, class AIT>
+GameSpec place_game(const char* name, char first, char second, char blank, int depth) {
+    GameSpec game;
+    game.name = name;
+    game.symbols[0] = first;
+    game.symbols[1] = second;
+    game.blank = blank;
+    game.depth = depth;
+    game.make = [] { return std::unique_ptr<Board<char>>(new BoardT()); };
+    game.clone = [](Board<char>* b) {
+        return std::unique_ptr<Board<char>>(new BoardT(static_cast<const BoardT&>(*b)));
+    };
+    game.ai = [] { return std::unique_ptr<AI>(new AIT()); };
+    game.candidates = [blank](Board<char>* b, Player<char>* p) { return empty_cells(b, p->get_symbol(), blank); };
+    return game;
+}
+
+/** @brief All games, in the order of the TheGame menu. */
+inline const std::vector<GameSpec>& all_games() {
+    static const std::vector<GameSpec> games = [] {
+        std::vector<GameSpec> g;
+        g.push_back(place_game<X_O_Board, X_O_AI>("xo", 'X', 'O', '.', 9));
+        g.push_back(place_game<XO_inf_Board, XO_inf_AI>("inf", 'X', 'O', '.', 13));
+
+        GameSpec four = place_game<FOUR_Board, Four_AI>("four", 'X', 'O', '.', 10);
+        four.candidates = [](Board<char>* b, Player<char>* p) {
+            Moves moves;
+            for (int c = 0; c < b->get_columns(); ++c)
+                if (b->get_cell(0, c) == '.') moves.push_back(std::make_unique<Move<char>>(0, c, p->get_symbol()));
+            return moves;
+        };
+        g.push_back(four);
+
+        GameSpec anti = place_game<Anti_XO_Board, Anti_AI>("anti", 'X', 'O', '.', 6);
+        anti.exactEvaluate = true;
+        g.push_back(anti);
+
+        GameSpec large = place_game<Large_XO_Board, Large_XO_AI>("large", 'X', 'O', '.', 3);
+        // Quietly uses fixed untrained networks if the files are missing
+        large.ai = [] { return std::unique_ptr<AI>(new Large_XO_AI(0u)); };
+        large.requireAI = [] {
+            for (const char* file : { "netX.bin", "netO.bin" }) {
+                try {
+                    Large_XO_AI::loadNetwork(file);
+                }
+                catch (const std::exception& e) {
+                    throw std::runtime_error(std::string("the 5x5 AI needs netX.bin and netO.bin in the working directory; ") +
+                                             file + ": " + e.what());
+                }
+            }
+        };
+        g.push_back(large);
+
+        GameSpec num = place_game<XO_NUM_Board, XO_NUM_AI>("num", '1', '2', '.', 6);
+        num.exactEvaluate = true;
+        num.candidates = [](Board<char>* b, Player<char>* p) {
+            Moves moves;
+            const std::string numbers = static_cast<XO_NUM_Board*>(b)->available_numbers();
+            for (auto& cell : empty_cells(b, p->get_symbol(), '.'))
+                for (char n : numbers)
+                    moves.push_back(std::make_unique<Move<char>>(cell->get_x(), cell->get_y(), n));
+            return moves;
+        };
+        g.push_back(num);
+
+        GameSpec ultimate = place_game<Ultimate_Board, Ultimate_AI>("ultimate", 'X', 'O', '.', 6);
+        ultimate.randomAI = true;
+        ultimate.ai = [] { return std::unique_ptr<AI>(new Ultimate_AI(0)); };
+        ultimate.reseed = [](AI* ai, std::uint64_t seed) { static_cast<Ultimate_AI*>(ai)->setSeed(seed); };
+        g.push_back(ultimate);
+
+        GameSpec pyramid = place_game<PyramidXO_Board, PyramidXO_AI>("pyramid", 'X', 'O', 0, 6);
+        pyramid.exactEvaluate = true;
+        g.push_back(pyramid);
+
+        GameSpec word = place_game<Word_XO_Board, Word_AI>("word", 'X', 'O', '.', 6);
+        word.candidates = [](Board<char>* b, Player<char>* p) {
+            Moves moves;
+            for (auto& cell : empty_cells(b, p->get_symbol(), '.'))
+                for (char letter = 'A'; letter <= 'Z'; ++letter)
+                    moves.push_back(std::make_unique<Move<char>>(cell->get_x(), cell->get_y(), letter));
+            return moves;
+        };
+        word.played = [](Board<char>* b, Player<char>* p) { static_cast<Word_XO_Board*>(b)->setLastPlayer(p); };
+        // A node budget instead of the UI's one second per move, so moves do
+        // not depend on machine load; the table is cleared for every game
+        word.ai = [] {
+            auto* ai = new Word_AI();
+            ai->setNodeBudget(2000000);
+            return std::unique_ptr<AI>(ai);
+        };
+        word.reseed = [](AI* ai, std::uint64_t) { static_cast<Word_AI*>(ai)->clearTable(); };
+        g.push_back(word);
+
+        GameSpec obstacles = place_game<Obstacles_Board, Obstacles_AI>("obstacles", 'X', 'O', '.', Obstacles_AI::MAX_DEPTH);
+        obstacles.seed = [](Board<char>* b, std::uint64_t seed) { static_cast<Obstacles_Board*>(b)->setTrapSeed(seed); };
+        obstacles.ai = [] { return std::unique_ptr<AI>(new Obstacles_AI(0)); };
+        obstacles.reseed = [](AI* ai, std::uint64_t seed) { static_cast<Obstacles_AI*>(ai)->setSeed(seed); };
+        g.push_back(obstacles);
+
+        GameSpec memory = place_game<Memory_Board, Memory_AI>("memory", 'X', 'O', '.', 9);
+        memory.ai = [] { return std::unique_ptr<AI>(new Memory_AI(0)); };
+        memory.reseed = [](AI* ai, std::uint64_t seed) {
+            auto* memoryAi = static_cast<Memory_AI*>(ai);
+            memoryAi->setSeed(seed);
+            memoryAi->resetMemory();
+        };
+        g.push_back(memory);
+
+        GameSpec slide = place_game<_4by4XO_Board, _4by4XO_AI>("4x4", 'X', 'O', 0, 6);
+        slide.exactEvaluate = true;
+        slide.candidates = [](Board<char>* b, Player<char>* p) {
+            static const int STEPS[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+            Moves moves;
+            for (int r = 0; r < 4; ++r)
+                for (int c = 0; c < 4; ++c) {
+                    if (b->get_cell(r, c) != p->get_symbol()) continue;
+                    for (const auto& step : STEPS) {
+                        const int tr = r + step[0], tc = c + step[1];
+                        if (tr >= 0 && tr < 4 && tc >= 0 && tc < 4 && b->get_cell(tr, tc) == 0)
+                            moves.push_back(std::make_unique<_4by4XO_Move>(r, c, tr, tc, p->get_symbol()));
+                    }
+                }
+            return moves;
+        };
+        g.push_back(slide);
+
+        GameSpec sus = place_game<SUS_Board, SUS_AI>("sus", 'S', 'U', '.', 9);
+        sus.exactEvaluate = true;
+        g.push_back(sus);
+        g.push_back(place_game<dia_XO_Board, dia_XO_AI>("diamond", 'X', 'O', '.', 6));
+        return g;
+    }();
+    return games;
+}
+
+/** @brief Seat of a player (0 moves first). */
+inline int seat_of(const GameSpec& game, Player<char>* player) {
+    return player->get_symbol() == game.symbols[0] ? 0 : 1;
+}
+
+/**
+ * @brief Result after the player in @p seat moved.
+ * @return Winning seat, DRAW, or ONGOING
+ */
+inline int outcome(Board<char>* board, Player<char>* seats[2], int seat) {
+    if (board->is_win(seats[seat])) return seat;
+    if (board->is_lose(seats[seat])) return 1 - seat;
+    if (board->is_draw(seats[seat])) return DRAW;
+    return ONGOING;
+}
+
+/** @brief Candidates that the board accepts (each one tried on a copy). */
+inline Moves legal_moves(const GameSpec& game, Board<char>* board, Player<char>* player) {
+    Moves legal;
+    for (auto& move : game.candidates(board, player))
+        if (game.clone(board)->update_board(move.get()))
+            legal.push_back(std::move(move));
+    return legal;
+}
+
+/** @brief Apply a move and the game's bookkeeping; false if it is illegal. */
+inline bool apply(const GameSpec& game, Board<char>* board, Player<char>* player, Move<char>* move) {
+    if (!board->update_board(move)) return false;
+    if (game.played) game.played(board, player);
+    return true;
+}
+
+/**
+ * @brief Play a random legal move in place.
+ *
+ * Candidates are tried in random order until the board accepts one; a
+ * rejected move leaves the board unchanged.
+ * @return false if no candidate is legal
+ */
+inline bool play_random(const GameSpec& game, Board<char>* board, Player<char>* player, std::mt19937_64& rng) {
+    Moves moves = game.candidates(board, player);
+    while (!moves.empty()) {
+        const size_t i = rng() % moves.size();
+        if (apply(game, board, player, moves[i].get())) return true;
+        moves[i] = std::move(moves.back());
+        moves.pop_back();
+    }
+    return false;
+}
+
+/**
+ * @brief Play a random opening on a reset board.
+ *
+ * Openings that end the game or run out of moves are redrawn; after a few
+ * failures the game starts from the empty board.
+ * @return Plies played
+ */
+inline int random_opening(const GameSpec& game, Board<char>* board, Player<char>* seats[2],
+                   int plies, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        if (attempt) board->reset();
+        if (game.seed) game.seed(board, seed + attempt);
+        int ply = 0;
+        while (ply < plies && play_random(game, board, seats[ply % 2], rng) &&
+               outcome(board, seats, ply % 2) == ONGOING)
+            ++ply;
+        if (ply == plies) return ply;
+    }
+    board->reset();
+    if (game.seed) game.seed(board, seed);
+    return 0;
+}
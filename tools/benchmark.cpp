@@ -0,0 +1,498 @@
+/**
+ * @file benchmark.cpp
+ * @brief Micro-benchmarks for the boards, the game AIs and the network kernels.
+ *
+ *   benchmark [--filter four] [--min-time 0.5] [--repetitions 3]
+ *         [--plies 4] [--depth N] [--seed 1]
+ *         [--json out.json] [--baseline old.json] [--threshold 10]
+ *
+ * Cases, for each of the 14 games (names as in tournament.cpp):
+ *  - <game>/update_undo      update_board then undo (a move with symbol 0);
+ *                            <game>/update_copy (copy, then update_board)
+ *                            for boards that cannot undo that move
+ *  - <game>/is_win           is_win for the player who moved last
+ *  - <game>/legal_moves      move generation (candidates tried on copies)
+ *  - <game>/evaluate         the game AI's evaluate() for the player to move
+ *  - <game>/bestMove/d<N>    a full search by a fresh AI at the UI's depth,
+ *                            or --depth; tables that the AIs share between
+ *                            instances (the solved XO tables) stay warm
+ * and for the network:
+ *  - matrix/multiply/<shape> Matrix::multiply with the weights of the 5x5
+ *                            XO networks (512x512 hidden, 512x25 input layer)
+ *                            against one position and a batch of 256
+ *  - nn/predict/<sizes>      NeuralNetwork::predict of the 5x5 XO network
+ *
+ * Every game case starts from the same position: --plies random legal moves
+ * from the empty board, drawn from --seed. --filter keeps the cases whose
+ * name contains any of the comma-separated substrings.
+ *
+ * Run it from the directory holding the Word XO dictionary, i.e. the file
+ * named by Word_XO_Board::defaultDictionary (dic.txt unless changed;
+ * load_dictionary accepts a word list or a compiled .wdic), and
+ * netX.bin / netO.bin for the 5x5 AI. Without them the 5x5 AI uses
+ * untrained networks drawn from a fixed seed: the timings stay repeatable,
+ * but its moves are close to random, so search trees may differ from a
+ * trained network's.
+ *
+ * Each case is called once to warm up, then grows its iteration count until
+ * one batch runs for --min-time seconds, then times --repetitions batches
+ * of that size and reports the median time per operation. Only the
+ * operation is timed: the fresh AI and board copy of a bestMove iteration
+ * are made outside the clock.
+ *
+ * --json writes the results in the layout of Google Benchmark's JSON
+ * reporter (one benchmark per line). --baseline reads such a file, prints
+ * the change of every case, and makes the exit status 2 if any case got
+ * slower by more than --threshold percent.
+ */
+
+#include "GameRegistry.h"
+#include "../Neural_Network/Include/NeuralNetwork.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Keeps benchmark results observable so the work is not optimized away. */
+volatile double sink = 0;
+
+void keep(double value) { sink = sink + value; }
+
+double seconds_since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+/**
+ * @brief One benchmark: runs the operation n times and returns the seconds
+ *        spent in the timed part.
+ */
+using Body = std::function<double(std::uint64_t n)>;
+
+struct Case {
+    std::string name;
+    Body body;
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0; ///< Per repetition
+    double ns = 0;                ///< Median time per operation
+    double minNs = 0, maxNs = 0;  ///< Fastest and slowest repetition
+};
+
+struct Options {
+    std::vector<std::string> filters;
+    double minTime = 0.5;
+    int repetitions = 3;
+    int plies = 4;
+    int depth = 0;
+    std::uint64_t seed = 1;
+    std::string json, baseline;
+    double threshold = 10;
+};
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, sep))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+bool selected(const Options& opt, const std::string& name) {
+    if (opt.filters.empty()) return true;
+    for (const auto& f : opt.filters)
+        if (name.find(f) != std::string::npos) return true;
+    return false;
+}
+
+// ---------------------------------------------------------------- game cases
+
+/** @brief Same cells, read through the Board interface. */
+bool same_cells(Board<char>* a, Board<char>* b) {
+    for (int r = 0; r < a->get_rows(); ++r)
+        for (int c = 0; c < a->get_columns(); ++c)
+            if (a->get_cell(r, c) != b->get_cell(r, c)) return false;
+    return true;
+}
+
+/**
+ * @brief A legal move that the board can take back twice in a row.
+ *
+ * Most boards undo a move given with symbol 0. Boards whose undo is
+ * partial (Ultimate keeps a won small board) or missing (4x4 slides) are
+ * caught by playing the round trip twice on a copy.
+ * @return The move, or null if no legal move round-trips
+ */
+std::unique_ptr<Move<char>> undoable_move(const GameSpec& game, Board<char>* board, Player<char>* player) {
+    for (auto& move : legal_moves(game, board, player)) {
+        Move<char> undo(move->get_x(), move->get_y(), 0);
+        auto copy = game.clone(board);
+        bool ok = true;
+        for (int round = 0; round < 2 && ok; ++round)
+            ok = copy->update_board(move.get()) && copy->update_board(&undo) && same_cells(copy.get(), board);
+        if (ok) return std::move(move);
+    }
+    return nullptr;
+}
+
+/** @brief The benchmark position of a game and its two players. */
+struct Position {
+    std::unique_ptr<Board<char>> board;
+    std::unique_ptr<Player<char>> players[2];
+    Player<char>* toMove = nullptr;
+    Player<char>* moved = nullptr; ///< Player who made the last move
+};
+
+std::shared_ptr<Position> make_position(const GameSpec& game, const Options& opt) {
+    auto pos = std::make_shared<Position>();
+    pos->board = game.make();
+    Player<char>* seats[2];
+    for (int s : { 0, 1 }) {
+        pos->players[s].reset(new Player<char>(s ? "seat 1" : "seat 0", game.symbols[s], PlayerType::AI));
+        pos->players[s]->set_board_ptr(pos->board.get());
+        seats[s] = pos->players[s].get();
+    }
+    const int ply = random_opening(game, pos->board.get(), seats, opt.plies, opt.seed);
+    pos->toMove = seats[ply % 2];
+    pos->moved = seats[(ply + 1) % 2];
+    return pos;
+}
+
+void add_game_cases(std::vector<Case>& cases, const GameSpec& game, const Options& opt) {
+    const std::string prefix = game.name + "/";
+    std::shared_ptr<Position> pos;
+    auto position = [&] {
+        if (!pos) pos = make_position(game, opt);
+        return pos;
+    };
+
+    if (selected(opt, prefix + "update_undo") || selected(opt, prefix + "update_copy")) {
+        auto p = position();
+        std::shared_ptr<Move<char>> move(undoable_move(game, p->board.get(), p->toMove).release());
+        if (move) {
+            cases.push_back({ prefix + "update_undo", [p, move](std::uint64_t n) {
+                Board<char>* board = p->board.get();
+                Move<char> undo(move->get_x(), move->get_y(), 0);
+                const auto t0 = Clock::now();
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    keep(board->update_board(move.get()));
+                    board->update_board(&undo);
+                }
+                return seconds_since(t0);
+            } });
+        }
+        else {
+            Moves legal = legal_moves(game, p->board.get(), p->toMove);
+            if (!legal.empty()) {
+                std::shared_ptr<Move<char>> first(legal[0].release());
+                const GameSpec* g = &game;
+                cases.push_back({ prefix + "update_copy", [p, first, g](std::uint64_t n) {
+                    const auto t0 = Clock::now();
+                    for (std::uint64_t i = 0; i < n; ++i)
+                        keep(g->clone(p->board.get())->update_board(first.get()));
+                    return seconds_since(t0);
+                } });
+            }
+        }
+    }
+
+    if (selected(opt, prefix + "is_win")) {
+        auto p = position();
+        cases.push_back({ prefix + "is_win", [p](std::uint64_t n) {
+            const auto t0 = Clock::now();
+            for (std::uint64_t i = 0; i < n; ++i)
+                keep(p->board->is_win(p->moved));
+            return seconds_since(t0);
+        } });
+    }
+
+    if (selected(opt, prefix + "legal_moves")) {
+        auto p = position();
+        const GameSpec* g = &game;
+        cases.push_back({ prefix + "legal_moves", [p, g](std::uint64_t n) {
+            const auto t0 = Clock::now();
+            for (std::uint64_t i = 0; i < n; ++i)
+                keep(double(legal_moves(*g, p->board.get(), p->toMove).size()));
+            return seconds_since(t0);
+        } });
+    }
+
+    if (selected(opt, prefix + "evaluate")) {
+        auto p = position();
+        std::shared_ptr<AI> ai = game.ai();
+        cases.push_back({ prefix + "evaluate", [p, ai](std::uint64_t n) {
+            const auto t0 = Clock::now();
+            for (std::uint64_t i = 0; i < n; ++i)
+                keep(ai->evaluate(p->board.get(), p->toMove));
+            return seconds_since(t0);
+        } });
+    }
+
+    const int depth = opt.depth ? opt.depth : game.depth;
+    const std::string search = prefix + "bestMove/d" + std::to_string(depth);
+    if (selected(opt, search)) {
+        auto p = position();
+        const GameSpec* g = &game;
+        cases.push_back({ search, [p, g, depth](std::uint64_t n) {
+            double timed = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                std::unique_ptr<AI> ai = g->ai();
+                auto board = g->clone(p->board.get());
+                p->toMove->set_board_ptr(board.get());
+                const auto t0 = Clock::now();
+                std::unique_ptr<Move<char>> move(ai->bestMove(p->toMove, g->blank, depth));
+                timed += seconds_since(t0);
+                p->toMove->set_board_ptr(p->board.get());
+                keep(move ? move->get_x() : -1);
+            }
+            return timed;
+        } });
+    }
+}
+
+// ---------------------------------------------------------------- network cases
+
+/** @brief Deterministic values in [-1, 1]. */
+Matrix<double> filled(int rows, int cols, std::uint64_t seed) {
+    Matrix<double> m(rows, cols);
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto& v : m.data) v = dist(rng);
+    return m;
+}
+
+void add_network_cases(std::vector<Case>& cases, const Options& opt) {
+    // Weight shapes of the 5x5 XO networks (25 -> 512 -> 512 -> 512 -> 25)
+    struct Shape { int rows, inner, cols; };
+    for (const Shape& s : { Shape{ 512, 512, 1 }, Shape{ 512, 512, 256 },
+                            Shape{ 512, 25, 1 }, Shape{ 512, 25, 256 } }) {
+        const std::string name = "matrix/multiply/" + std::to_string(s.rows) + "x" + std::to_string(s.inner) +
+                                 "*" + std::to_string(s.inner) + "x" + std::to_string(s.cols);
+        if (!selected(opt, name)) continue;
+        const std::uint64_t seed = opt.seed;
+        cases.push_back({ name, [s, seed](std::uint64_t n) {
+            const Matrix<double> a = filled(s.rows, s.inner, seed);
+            const Matrix<double> b = filled(s.inner, s.cols, seed + 1);
+            Matrix<double> out(s.rows, s.cols);
+            const auto t0 = Clock::now();
+            for (std::uint64_t i = 0; i < n; ++i) {
+                Matrix<double>::multiply(a, b, out);
+                keep(out.data[0]);
+            }
+            return seconds_since(t0);
+        } });
+    }
+
+    const std::string predict = "nn/predict/25-512-512-512-25";
+    if (selected(opt, predict)) {
+        auto net = std::make_shared<NeuralNetwork>(
+            std::vector<int>{ 25, 512, 512, 512, 25 },
+            std::vector<Activation>{ Activation::ReLU, Activation::ReLU, Activation::ReLU, Activation::Linear });
+        net->randomize(std::uint32_t(opt.seed));
+        const Matrix<double> input = filled(25, 1, opt.seed + 2);
+        cases.push_back({ predict, [net, input](std::uint64_t n) {
+            const auto t0 = Clock::now();
+            for (std::uint64_t i = 0; i < n; ++i)
+                keep(net->predict(input).data[0]);
+            return seconds_since(t0);
+        } });
+    }
+}
+
+// ---------------------------------------------------------------- runner
+
+Result measure(const Case& c, const Options& opt) {
+    c.body(1); // warm-up: lazily built tables, caches
+
+    // Calibrate: grow the batch until it takes minTime
+    std::uint64_t n = 1;
+    for (;;) {
+        const double t = c.body(n);
+        if (t >= opt.minTime || n >= (1ull << 40)) break;
+        const double grow = t > 0 ? 1.4 * opt.minTime / t : 100.0;
+        n = std::uint64_t(double(n) * std::min(std::max(grow, 2.0), 100.0));
+    }
+
+    std::vector<double> ns;
+    for (int r = 0; r < opt.repetitions; ++r)
+        ns.push_back(1e9 * c.body(n) / double(n));
+    std::sort(ns.begin(), ns.end());
+
+    Result result;
+    result.name = c.name;
+    result.iterations = n;
+    result.ns = ns[ns.size() / 2];
+    result.minNs = ns.front();
+    result.maxNs = ns.back();
+    return result;
+}
+
+std::string pretty_time(double ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(ns < 10 ? 2 : 1);
+    if (ns < 1e3) out << ns << " ns";
+    else if (ns < 1e6) out << ns / 1e3 << " us";
+    else if (ns < 1e9) out << ns / 1e6 << " ms";
+    else out << ns / 1e9 << " s";
+    return out.str();
+}
+
+std::string json_string(const std::string& s) {
+    std::string out = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out + "\"";
+}
+
+void write_json(const std::string& file, const Options& opt, const std::vector<Result>& results) {
+    std::ofstream out(file);
+    if (!out) throw std::runtime_error("cannot write " + file);
+
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"library_build_type\": \"" << build << "\",\n"
+        << "    \"min_time\": " << opt.minTime << ",\n"
+        << "    \"repetitions\": " << opt.repetitions << ",\n"
+        << "    \"plies\": " << opt.plies << ",\n"
+        << "    \"seed\": " << opt.seed << "\n"
+        << "  },\n  \"benchmarks\": [\n";
+    out << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": " << json_string(r.name) << ", \"run_type\": \"iteration\""
+            << ", \"iterations\": " << r.iterations << ", \"repetitions\": " << opt.repetitions
+            << ", \"real_time\": " << r.ns << ", \"min_time\": " << r.minNs << ", \"max_time\": " << r.maxNs
+            << ", \"time_unit\": \"ns\"}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @brief real_time of every benchmark in a file written by write_json.
+ *
+ * Reads one benchmark per line; other JSON layouts are not supported.
+ */
+std::map<std::string, double> read_baseline(const std::string& file) {
+    std::ifstream in(file);
+    if (!in) throw std::runtime_error("cannot open " + file);
+
+    std::map<std::string, double> times;
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t name = line.find("\"name\": \"");
+        const size_t time = line.find("\"real_time\": ");
+        if (name == std::string::npos || time == std::string::npos) continue;
+        const size_t begin = name + 9;
+        const size_t end = line.find('"', begin);
+        times[line.substr(begin, end - begin)] = std::stod(line.substr(time + 13));
+    }
+    return times;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::string> args;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        if (key.rfind("--", 0) != 0) {
+            std::cerr << "Unexpected argument: " << key << "\n";
+            return 1;
+        }
+        args[key.substr(2)] = argv[i + 1];
+    }
+    if (argc % 2 == 0) {
+        std::cerr << "Usage: " << argv[0] << " [--filter a,b] [--min-time s] [--json out.json]"
+                  << " [--baseline old.json] (see tools/benchmark.cpp)\n";
+        return 1;
+    }
+
+    try {
+        Options opt;
+        if (args.count("filter")) opt.filters = split(args["filter"], ',');
+        if (args.count("min-time")) opt.minTime = std::stod(args["min-time"]);
+        if (args.count("repetitions")) opt.repetitions = std::stoi(args["repetitions"]);
+        if (args.count("plies")) opt.plies = std::stoi(args["plies"]);
+        if (args.count("depth")) opt.depth = std::stoi(args["depth"]);
+        if (args.count("seed")) opt.seed = std::stoull(args["seed"]);
+        if (args.count("json")) opt.json = args["json"];
+        if (args.count("baseline")) opt.baseline = args["baseline"];
+        if (args.count("threshold")) opt.threshold = std::stod(args["threshold"]);
+        if (opt.minTime <= 0 || opt.repetitions < 1 || opt.plies < 0 || opt.depth < 0)
+            throw std::invalid_argument("--min-time, --repetitions, --plies and --depth must be positive");
+
+        std::map<std::string, double> baseline;
+        if (!opt.baseline.empty()) baseline = read_baseline(opt.baseline);
+
+        std::vector<Case> cases;
+        for (const GameSpec& game : all_games())
+            add_game_cases(cases, game, opt);
+        add_network_cases(cases, opt);
+        if (cases.empty())
+            throw std::invalid_argument("no benchmark matches --filter");
+
+        std::vector<Result> results;
+        int regressions = 0;
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "time/op"
+                  << std::setw(12) << "iterations" << std::setw(10) << "spread"
+                  << (baseline.empty() ? "" : "    change") << "\n";
+        for (const Case& c : cases) {
+            const Result r = measure(c, opt);
+            results.push_back(r);
+
+            std::cout << std::left << std::setw(40) << r.name << std::right << std::setw(14) << pretty_time(r.ns)
+                      << std::setw(12) << r.iterations << std::setw(9) << std::fixed << std::setprecision(1)
+                      << (r.ns > 0 ? 100.0 * (r.maxNs - r.minNs) / r.ns : 0.0) << "%";
+            auto old = baseline.find(r.name);
+            if (old != baseline.end() && old->second > 0) {
+                const double change = 100.0 * (r.ns / old->second - 1.0);
+                std::cout << std::setw(9) << std::showpos << change << "%" << std::noshowpos;
+                if (change > opt.threshold) {
+                    std::cout << "  REGRESSION";
+                    ++regressions;
+                }
+            }
+            std::cout << std::endl;
+        }
+
+        if (!opt.json.empty()) {
+            write_json(opt.json, opt, results);
+            std::cout << "Wrote " << results.size() << " results to " << opt.json << "\n";
+        }
+        if (regressions) {
+            std::cout << regressions << " case(s) slower than the baseline by more than "
+                      << opt.threshold << "%\n";
+            return 2;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,636 @@
+/**
+ * @file tournament.cpp
+ * @brief Engine-vs-engine matches for any of the 14 games.
+ *
+ *   tournament --game four --engines minimax:8,mcts:2000,random
+ *         [--format roundrobin|gauntlet] [--games 100] [--threads 0]
+ *         [--seed 1] [--random-plies 2] [--max-plies 400]
+ *         [--sprt 0,10] [--alpha 0.05] [--beta 0.05]
+ *
+ * --game takes one or more of xo, inf, four, anti, large, num, ultimate,
+ * pyramid, word, obstacles, memory, 4x4, sus, diamond (comma-separated, in
+ * the order of the TheGame menu) or "all".
+ *
+ * Engines:
+ *  - random       uniformly random legal move
+ *  - heuristic    one ply; moves scored by the game AI's evaluate(). That
+ *                 is a static line score for xo, four, obstacles and
+ *                 diamond (the network for large); for inf, word, memory
+ *                 and ultimate it only scores finished games (random play
+ *                 plus immediate wins); for anti, num, pyramid, 4x4 and
+ *                 sus it is the solved value, so the engine plays perfectly
+ *  - minimax[:N]  the game AI's bestMove at depth N (default: the UI's depth).
+ *                 The ultimate AI picks a random open cell, so there it is
+ *                 reported as "minimax (random)"
+ *  - mcts[:M]     UCT with M random playouts per move (default 1000)
+ *  - nn           5x5 XO only: the Q-networks without search or solver
+ *
+ * For large, every engine but random and mcts needs trained netX.bin and
+ * netO.bin in the working directory; the tournament checks them once and
+ * stops if either does not load.
+ *
+ * A round robin plays every pair of engines, a gauntlet the first engine
+ * against each of the others. The games of a pairing come in twos with the
+ * same opening (--random-plies random moves, Obstacles traps seeded alike)
+ * and the seats swapped. Games run on a thread pool; each worker keeps one
+ * board, reset between games, and its own instance of every engine. The
+ * engines' random choices, including the generators inside the Memory,
+ * Obstacles and Ultimate AIs, are reseeded from --seed before every game.
+ *
+ * Each pairing reports W/D/L from the first engine's side, the Elo
+ * difference with a 95% interval, the SPRT log-likelihood ratio for elo0
+ * against elo1 (trinomial GSPRT) and the mean time per move of both
+ * engines. With --sprt a pairing stops once the ratio leaves its bounds.
+ * Results do not depend on the thread count, except through engines that
+ * keep search tables between games. No engine stops on the clock: the
+ * Word XO AI, which does in the game, gets a node budget per move here and
+ * a cleared table per game.
+ */
+
+#include "../header/HeadlessGameManager.h"
+#include "GameRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @class Mcts
+ * @brief Plain UCT over any game, using random playouts.
+ */
+class Mcts {
+public:
+    Mcts(const GameSpec& game, int iterations, std::mt19937_64* rng)
+        : game(game), iterations(iterations), rng(rng) {}
+
+    /** @brief Most visited root move after the given number of playouts. */
+    Move<char>* operator()(Player<char>* player) {
+        Board<char>* root = player->get_board_ptr();
+        const int rootSeat = seat_of(game, player);
+
+        nodes.clear();
+        nodes.emplace_back();
+        nodes[0].seat = 1 - rootSeat;
+        nodes[0].untried = legal_moves(game, root, player);
+        nodes[0].generated = true;
+        if (nodes[0].untried.empty()) return nullptr;
+        if (nodes[0].untried.size() == 1) return nodes[0].untried[0].release();
+
+        Player<char> first("", game.symbols[0], PlayerType::AI), second("", game.symbols[1], PlayerType::AI);
+        Player<char>* seats[2] = { &first, &second };
+
+        for (int i = 0; i < iterations; ++i) {
+            auto board = game.clone(root);
+            first.set_board_ptr(board.get());
+            second.set_board_ptr(board.get());
+
+            // Selection
+            int node = 0;
+            while (nodes[node].result == ONGOING) {
+                const int toMove = 1 - nodes[node].seat;
+                if (!nodes[node].generated) {
+                    nodes[node].untried = legal_moves(game, board.get(), seats[toMove]);
+                    nodes[node].generated = true;
+                    if (nodes[node].untried.empty() && nodes[node].children.empty())
+                        nodes[node].result = DRAW;
+                }
+                if (!nodes[node].untried.empty() || nodes[node].result != ONGOING) break;
+                node = select(node);
+                apply(game, board.get(), seats[nodes[node].seat], nodes[node].move.get());
+            }
+
+            // Expansion
+            if (nodes[node].result == ONGOING) {
+                auto& untried = nodes[node].untried;
+                const size_t pick = (*rng)() % untried.size();
+                Node child;
+                child.move = std::move(untried[pick]);
+                untried[pick] = std::move(untried.back());
+                untried.pop_back();
+                child.parent = node;
+                child.seat = 1 - nodes[node].seat;
+                apply(game, board.get(), seats[child.seat], child.move.get());
+                child.result = outcome(board.get(), seats, child.seat);
+                nodes[node].children.push_back(int(nodes.size()));
+                nodes.push_back(std::move(child));
+                node = int(nodes.size()) - 1;
+            }
+
+            // Simulation
+            int result = nodes[node].result;
+            for (int ply = 0, toMove = 1 - nodes[node].seat; result == ONGOING; ++ply, toMove ^= 1) {
+                if (ply >= PLAYOUT_PLIES || !play_random(game, board.get(), seats[toMove], *rng)) {
+                    result = DRAW;
+                    break;
+                }
+                result = outcome(board.get(), seats, toMove);
+            }
+
+            // Backpropagation
+            for (int n = node; n >= 0; n = nodes[n].parent) {
+                ++nodes[n].visits;
+                nodes[n].points += result == DRAW ? 0.5 : (result == nodes[n].seat ? 1.0 : 0.0);
+            }
+        }
+
+        int best = -1;
+        for (int child : nodes[0].children)
+            if (best < 0 || nodes[child].visits > nodes[best].visits) best = child;
+        return best < 0 ? nodes[0].untried[0].release() : nodes[best].move.release();
+    }
+
+private:
+    static constexpr int PLAYOUT_PLIES = 200; ///< Playouts longer than this are draws
+    static constexpr double EXPLORATION = 1.4;
+
+    struct Node {
+        std::unique_ptr<Move<char>> move; ///< Move into this node
+        int parent = -1;
+        int seat = 0;                     ///< Seat that made the move
+        int result = ONGOING;             ///< Outcome after the move
+        bool generated = false;           ///< untried has been filled
+        Moves untried;                    ///< Legal moves without a child yet
+        std::vector<int> children;
+        double points = 0;                ///< Playout points for seat
+        int visits = 0;
+    };
+
+    /** @brief Child with the best UCB1 value. */
+    int select(int node) const {
+        const double logVisits = std::log(double(nodes[node].visits));
+        int best = -1;
+        double bestValue = -1;
+        for (int child : nodes[node].children) {
+            const Node& c = nodes[child];
+            const double value = c.points / c.visits + EXPLORATION * std::sqrt(logVisits / c.visits);
+            if (value > bestValue) { bestValue = value; best = child; }
+        }
+        return best;
+    }
+
+    const GameSpec& game;
+    int iterations;
+    std::mt19937_64* rng;
+    std::vector<Node> nodes;
+};
+
+/**
+ * @brief Best one-ply move: immediate wins first, then the move that
+ *        leaves the opponent the lowest evaluate() value. Ties are random.
+ */
+Move<char>* heuristic_move(const GameSpec& game, AI& ai, Player<char>* player, std::mt19937_64& rng) {
+    Board<char>* board = player->get_board_ptr();
+    const int seat = seat_of(game, player);
+    Moves legal = legal_moves(game, board, player);
+    if (legal.empty()) return nullptr;
+
+    Player<char> me("", game.symbols[seat], PlayerType::AI), opp("", game.symbols[1 - seat], PlayerType::AI);
+    Player<char>* seats[2];
+    seats[seat] = &me;
+    seats[1 - seat] = &opp;
+
+    std::vector<size_t> best;
+    double bestValue = -HUGE_VAL;
+    for (size_t i = 0; i < legal.size(); ++i) {
+        auto trial = game.clone(board);
+        me.set_board_ptr(trial.get());
+        opp.set_board_ptr(trial.get());
+        apply(game, trial.get(), &me, legal[i].get());
+
+        const int result = outcome(trial.get(), seats, seat);
+        const double value = result == seat     ? HUGE_VAL
+                           : result == 1 - seat ? -HUGE_VAL
+                           : result == DRAW     ? 0.0
+                           : -double(ai.evaluate(trial.get(), &opp));
+        if (value > bestValue) { bestValue = value; best.clear(); }
+        if (value == bestValue) best.push_back(i);
+    }
+    return legal[best[rng() % best.size()]].release();
+}
+
+/** @brief Parsed engine description, e.g. "minimax:6". */
+struct EngineSpec {
+    std::string label; ///< As given on the command line
+    std::string kind;  ///< random, heuristic, minimax, mcts or nn
+    int param = 0;     ///< Depth or playouts (0 = default)
+};
+
+/** @brief Name of an engine in the report, marking a game AI that does not search. */
+std::string engine_label(const GameSpec& game, const EngineSpec& spec) {
+    return game.randomAI && spec.kind == "minimax" ? spec.label + " (random)" : spec.label;
+}
+
+EngineSpec parse_engine(const std::string& text) {
+    EngineSpec spec;
+    spec.label = text;
+    const size_t colon = text.find(':');
+    spec.kind = text.substr(0, colon);
+    if (colon != std::string::npos) spec.param = std::stoi(text.substr(colon + 1));
+
+    if (spec.kind != "random" && spec.kind != "heuristic" && spec.kind != "minimax" &&
+        spec.kind != "mcts" && spec.kind != "nn")
+        throw std::invalid_argument("unknown engine " + text);
+    if (spec.param < 0 || (colon != std::string::npos && spec.param == 0))
+        throw std::invalid_argument("bad engine parameter in " + text);
+    return spec;
+}
+
+/** @brief An engine instance of one worker. */
+struct Engine {
+    MoveProvider<char> move;  ///< Move for the player to move
+    std::shared_ptr<AI> ai;   ///< Game AI behind the engine, if any
+};
+
+/**
+ * @brief Instantiate an engine for one worker.
+ * @param rng Generator the engine draws from (reseeded by the worker per game)
+ */
+Engine make_engine(const EngineSpec& spec, const GameSpec& game, std::mt19937_64* rng) {
+    if (spec.kind == "random")
+        return { [&game, rng](Player<char>* p) -> Move<char>* {
+            Moves legal = legal_moves(game, p->get_board_ptr(), p);
+            return legal.empty() ? nullptr : legal[(*rng)() % legal.size()].release();
+        }, nullptr };
+
+    if (spec.kind == "heuristic") {
+        std::shared_ptr<AI> ai = game.ai();
+        return { [&game, ai, rng](Player<char>* p) { return heuristic_move(game, *ai, p, *rng); }, ai };
+    }
+
+    if (spec.kind == "minimax") {
+        std::shared_ptr<AI> ai = game.ai();
+        const int depth = spec.param ? spec.param : game.depth;
+        return { [&game, ai, depth](Player<char>* p) { return ai->bestMove(p, game.blank, depth); }, ai };
+    }
+
+    if (spec.kind == "mcts") {
+        auto mcts = std::make_shared<Mcts>(game, spec.param ? spec.param : 1000, rng);
+        return { [mcts](Player<char>* p) { return (*mcts)(p); }, nullptr };
+    }
+
+    if (game.name != "large")
+        throw std::invalid_argument("engine nn is only available for large");
+    auto ai = std::make_shared<Large_XO_AI>();
+    ai->setEndgameEmpties(0);
+    return { [ai](Player<char>* p) { return ai->bestMove(p, '.', 1); }, ai };
+}
+
+// ---------------------------------------------------------------- statistics
+
+/** @brief Elo difference for an expected score. */
+double elo_of(double score) {
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+/** @brief Expected score for an Elo difference. */
+double score_of(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+/** @brief Mean and per-game variance of the score (win 1, draw 1/2). */
+void score_moments(int w, int d, int l, double& mean, double& variance) {
+    const double n = w + d + l;
+    mean = n ? (w + 0.5 * d) / n : 0.5;
+    variance = n ? (w * (1 - mean) * (1 - mean) + d * (0.5 - mean) * (0.5 - mean) + l * mean * mean) / n : 0.0;
+}
+
+/**
+ * @brief score_moments with half a win and half a loss added to the counts.
+ *
+ * A sweep (or a run of draws) has zero sample variance, which would give a
+ * zero-width interval and an LLR of 0 that never ends an SPRT. The prior
+ * keeps the variance positive and fades as games accumulate.
+ */
+void regularized_moments(int w, int d, int l, double& mean, double& variance) {
+    const double n = w + d + l + 1.0;
+    mean = (w + 0.5 + 0.5 * d) / n;
+    variance = ((w + 0.5) * (1 - mean) * (1 - mean) + d * (0.5 - mean) * (0.5 - mean) +
+                (l + 0.5) * mean * mean) / n;
+}
+
+/** @brief Half-width of the 95% Elo interval. */
+double elo_margin(int w, int d, int l) {
+    double mean, variance;
+    regularized_moments(w, d, l, mean, variance);
+    const double se = std::sqrt(variance / std::max(1, w + d + l));
+    return (elo_of(mean + 1.96 * se) - elo_of(mean - 1.96 * se)) / 2;
+}
+
+/** @brief Log-likelihood ratio of elo1 against elo0 (GSPRT approximation). */
+double sprt_llr(int w, int d, int l, double elo0, double elo1) {
+    double mean, variance;
+    regularized_moments(w, d, l, mean, variance);
+    const double s0 = score_of(elo0), s1 = score_of(elo1);
+    return (w + d + l) * (s1 - s0) * (2 * mean - s0 - s1) / (2 * variance);
+}
+
+// ---------------------------------------------------------------- tournament
+
+struct Options {
+    std::vector<std::string> games;
+    std::vector<EngineSpec> engines;
+    bool gauntlet = false;
+    int games_per_pair = 100;
+    int threads = 0;
+    std::uint64_t seed = 1;
+    int randomPlies = 2;
+    int maxPlies = 400;
+    bool sprt = false;
+    double elo0 = 0, elo1 = 10, alpha = 0.05, beta = 0.05;
+};
+
+struct Pairing {
+    int a, b;              ///< Engine indices (a is provider A)
+    HeadlessStats stats;   ///< From a's side
+    bool stopped = false;  ///< SPRT decided
+    std::string verdict;   ///< SPRT outcome
+};
+
+std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+    std::uint64_t state = a * 0x9E3779B97F4A7C15ull ^ b;
+    return kinarow::splitmix64(state);
+}
+
+/** @brief Run one worker until the job counter passes the last game. */
+void worker(const GameSpec& game, const Options& opt, std::vector<Pairing>& pairings,
+            std::atomic<size_t>& next, std::mutex& lock, std::atomic<int>& finished) {
+    const size_t total = pairings.size() * size_t(opt.games_per_pair);
+
+    auto board = game.make();
+    Player<char> first("seat 0", game.symbols[0], PlayerType::AI);
+    Player<char> second("seat 1", game.symbols[1], PlayerType::AI);
+    Player<char>* seats[2] = { &first, &second };
+
+    std::vector<std::mt19937_64> rngs(opt.engines.size());
+    std::vector<Engine> engines;
+    for (size_t e = 0; e < opt.engines.size(); ++e)
+        engines.push_back(make_engine(opt.engines[e], game, &rngs[e]));
+
+    const double llrLow = std::log(opt.beta / (1 - opt.alpha));
+    const double llrHigh = std::log((1 - opt.beta) / opt.alpha);
+
+    for (size_t job = next++; job < total; job = next++) {
+        Pairing& pairing = pairings[job % pairings.size()];
+        const int g = int(job / pairings.size());
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (pairing.stopped) continue;
+        }
+
+        const std::uint64_t pairSeed = mix(mix(opt.seed, job % pairings.size()), std::uint64_t(g / 2));
+        for (int side : { 0, 1 }) {
+            const int e = side ? pairing.b : pairing.a;
+            const std::uint64_t engineSeed = mix(pairSeed, 2 * std::uint64_t(g) + 1 + side);
+            rngs[e].seed(engineSeed);
+            if (game.reseed && engines[e].ai) game.reseed(engines[e].ai.get(), engineSeed);
+        }
+
+        HeadlessGameManager<char> runner(board.get(), seats, engines[pairing.a].move, engines[pairing.b].move);
+        if (game.played)
+            runner.set_move_hook([&](Player<char>* p) { game.played(board.get(), p); });
+        runner.set_start_hook([&](Board<char>* b, Player<char>* s[2]) {
+            return random_opening(game, b, s, opt.randomPlies, pairSeed);
+        });
+
+        HeadlessStats stats;
+        const auto t0 = std::chrono::steady_clock::now();
+        runner.play(g % 2, stats, opt.maxPlies);
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::lock_guard<std::mutex> guard(lock);
+        pairing.stats.merge(stats);
+        if (opt.sprt && !pairing.stopped) {
+            const HeadlessStats& s = pairing.stats;
+            const double llr = sprt_llr(s.wins[0], s.draws, s.wins[1], opt.elo0, opt.elo1);
+            if (llr >= llrHigh) { pairing.stopped = true; pairing.verdict = "H1 accepted"; }
+            if (llr <= llrLow)  { pairing.stopped = true; pairing.verdict = "H0 accepted"; }
+        }
+        const int done = ++finished;
+        if (done % 100 == 0)
+            std::cout << "  " << done << "/" << total << " games\n";
+    }
+}
+
+void report(const GameSpec& game, const Options& opt, const std::vector<Pairing>& pairings, double seconds) {
+    const double llrLow = std::log(opt.beta / (1 - opt.alpha));
+    const double llrHigh = std::log((1 - opt.beta) / opt.alpha);
+
+    std::cout << std::fixed;
+    for (const Pairing& p : pairings) {
+        const HeadlessStats& s = p.stats;
+        double mean, variance;
+        score_moments(s.wins[0], s.draws, s.wins[1], mean, variance);
+
+        std::cout << "  " << engine_label(game, opt.engines[p.a]) << " vs " << engine_label(game, opt.engines[p.b]) << ": "
+                  << "+" << s.wins[0] << " =" << s.draws << " -" << s.wins[1]
+                  << "  score " << std::setprecision(3) << mean
+                  << "  Elo " << std::showpos << std::setprecision(1) << elo_of(mean) << std::noshowpos
+                  << " +/- " << elo_margin(s.wins[0], s.draws, s.wins[1])
+                  << "  ms/move " << std::setprecision(3) << s.mean_move_ms(0) << " | " << s.mean_move_ms(1);
+        if (s.forfeits[0] || s.forfeits[1])
+            std::cout << "  forfeits " << s.forfeits[0] << " | " << s.forfeits[1];
+        if (s.truncated)
+            std::cout << "  truncated " << s.truncated;
+        std::cout << "\n";
+        if (opt.sprt)
+            std::cout << "    SPRT [" << opt.elo0 << ", " << opt.elo1 << "]: LLR " << std::setprecision(2)
+                      << sprt_llr(s.wins[0], s.draws, s.wins[1], opt.elo0, opt.elo1)
+                      << " (" << llrLow << ", " << llrHigh << ") "
+                      << (p.verdict.empty() ? "undecided" : p.verdict) << "\n";
+    }
+
+    // Standings against the field
+    struct Row { int games = 0; double points = 0, seconds = 0; std::uint64_t moves = 0; };
+    std::vector<Row> rows(opt.engines.size());
+    for (const Pairing& p : pairings) {
+        const HeadlessStats& s = p.stats;
+        const int side[2] = { p.a, p.b };
+        for (int i : { 0, 1 }) {
+            Row& r = rows[side[i]];
+            r.games += s.games;
+            r.points += s.wins[i] + 0.5 * s.draws;
+            r.seconds += s.moveSeconds[i];
+            r.moves += s.moves[i];
+        }
+    }
+
+    std::cout << "\n  " << std::left << std::setw(16) << "engine" << std::right << std::setw(7) << "games"
+              << std::setw(9) << "points" << std::setw(8) << "score" << std::setw(9) << "Elo"
+              << std::setw(11) << "ms/move" << "\n";
+    for (size_t e = 0; e < rows.size(); ++e) {
+        const Row& r = rows[e];
+        const double score = r.games ? r.points / r.games : 0.5;
+        std::cout << "  " << std::left << std::setw(16) << engine_label(game, opt.engines[e]) << std::right
+                  << std::setw(7) << r.games << std::setw(9) << std::setprecision(1) << r.points
+                  << std::setw(8) << std::setprecision(3) << score
+                  << std::setw(9) << std::setprecision(1) << elo_of(score)
+                  << std::setw(11) << std::setprecision(3) << (r.moves ? 1000.0 * r.seconds / r.moves : 0.0) << "\n";
+    }
+    std::cout << "  " << game.name << " done in " << std::setprecision(2) << seconds << " s\n\n";
+}
+
+void run_tournament(const GameSpec& game, const Options& opt) {
+    std::vector<Pairing> pairings;
+    for (int a = 0; a < int(opt.engines.size()); ++a)
+        for (int b = a + 1; b < int(opt.engines.size()); ++b)
+            if (!opt.gauntlet || a == 0) pairings.push_back({ a, b });
+
+    std::cout << "Game " << game.name << ": " << pairings.size() << " pairings x "
+              << opt.games_per_pair << " games on " << opt.threads << " threads\n";
+    if (game.exactEvaluate)
+        for (const EngineSpec& spec : opt.engines)
+            if (spec.kind == "heuristic") {
+                std::cout << "  note: evaluate() is the solved value for " << game.name
+                          << ", so heuristic plays perfectly\n";
+                break;
+            }
+    if (game.randomAI)
+        for (const EngineSpec& spec : opt.engines)
+            if (spec.kind == "minimax") {
+                std::cout << "  note: the " << game.name << " AI picks a random legal move, "
+                          << "so minimax does not search\n";
+                break;
+            }
+
+    // Builds the boards' and engines' shared tables (and loads dictionaries)
+    // before workers start; the AI is only built for engines that use it
+    game.make();
+    for (const EngineSpec& spec : opt.engines) {
+        std::mt19937_64 rng;
+        make_engine(spec, game, &rng);
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<int> finished{0};
+    std::mutex lock;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (int id = 0; id < opt.threads; ++id)
+        pool.emplace_back([&, id] {
+            try {
+                worker(game, opt, pairings, next, lock, finished);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Worker " << id << " failed: " << e.what() << "\n";
+                next = pairings.size() * size_t(opt.games_per_pair);
+            }
+        });
+    for (auto& t : pool) t.join();
+
+    report(game, opt, pairings, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+}
+
+std::vector<std::string> split(const std::string& s, char sep) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, sep))
+        if (!item.empty()) parts.push_back(item);
+    return parts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    std::map<std::string, std::string> args;
+    for (int i = 1; i + 1 < argc; i += 2)
+        args[argv[i]] = argv[i + 1];
+
+    try {
+        if (args.count("--game"))
+            opt.games = split(args["--game"], ',');
+        if (args.count("--engines"))
+            for (const auto& e : split(args["--engines"], ','))
+                opt.engines.push_back(parse_engine(e));
+        if (args.count("--format")) {
+            if (args["--format"] != "roundrobin" && args["--format"] != "gauntlet")
+                throw std::invalid_argument("format must be roundrobin or gauntlet");
+            opt.gauntlet = args["--format"] == "gauntlet";
+        }
+        if (args.count("--games"))        opt.games_per_pair = std::stoi(args["--games"]);
+        if (args.count("--threads"))      opt.threads = std::stoi(args["--threads"]);
+        if (args.count("--seed"))         opt.seed = std::stoull(args["--seed"]);
+        if (args.count("--random-plies")) opt.randomPlies = std::stoi(args["--random-plies"]);
+        if (args.count("--max-plies"))    opt.maxPlies = std::stoi(args["--max-plies"]);
+        if (args.count("--alpha"))        opt.alpha = std::stod(args["--alpha"]);
+        if (args.count("--beta"))         opt.beta = std::stod(args["--beta"]);
+        if (args.count("--sprt")) {
+            const auto bounds = split(args["--sprt"], ',');
+            if (bounds.size() != 2) throw std::invalid_argument("--sprt takes elo0,elo1");
+            opt.sprt = true;
+            opt.elo0 = std::stod(bounds[0]);
+            opt.elo1 = std::stod(bounds[1]);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Bad argument: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (opt.games.size() == 1 && opt.games[0] == "all") {
+        opt.games.clear();
+        for (const GameSpec& g : all_games()) opt.games.push_back(g.name);
+    }
+
+    std::vector<const GameSpec*> selected;
+    for (const auto& name : opt.games) {
+        auto it = std::find_if(all_games().begin(), all_games().end(),
+                               [&](const GameSpec& g) { return g.name == name; });
+        if (it == all_games().end()) {
+            std::cerr << "Unknown game: " << name << "\n";
+            return 1;
+        }
+        selected.push_back(&*it);
+    }
+
+    if (selected.empty() || opt.engines.size() < 2 || opt.games_per_pair < 1 ||
+        opt.alpha <= 0 || opt.alpha >= 1 || opt.beta <= 0 || opt.beta >= 1) {
+        std::cerr << "Usage: " << argv[0] << " --game <name>[,...]|all --engines <e1>,<e2>[,...] [options]\n"
+                  << "  see the header of tournament.cpp for the option list\n";
+        return 1;
+    }
+
+    // Engines other than random and mcts play through the game AI
+    for (const GameSpec* game : selected) {
+        if (!game->requireAI) continue;
+        for (const EngineSpec& spec : opt.engines) {
+            if (spec.kind == "random" || spec.kind == "mcts") continue;
+            try {
+                game->requireAI();
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Game " << game->name << ": " << e.what() << "\n";
+                return 1;
+            }
+            break;
+        }
+    }
+
+    opt.games_per_pair += opt.games_per_pair % 2; // both seats for every opening
+    if (opt.threads <= 0) opt.threads = int(std::thread::hardware_concurrency());
+    if (opt.threads <= 0) opt.threads = 1;
+
+    try {
+        for (const GameSpec* game : selected)
+            run_tournament(*game, opt);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}